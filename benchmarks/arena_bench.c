@@ -0,0 +1,50 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#include "benchmark.h"
+#include "../utils/arena.h"
+#include "../data_structures/stack/list_stack.h"
+#include "arena_bench.h"
+
+#define TEARDOWN_STACKS 8
+#define TEARDOWN_NODES 1000000
+
+/**
+ * Builds a batch of list stacks and times tearing them down.
+ * @param allocator A pointer to the allocator the stacks use, or NULL for the heap.
+ * @param region A pointer to the arena behind the allocator, or NULL for the heap.
+ */
+static void bench_teardown(const allocator *allocator, arena *region) {
+    list_stack *stacks[TEARDOWN_STACKS];
+    for (size_t i = 0; i < TEARDOWN_STACKS; i++) {
+        stacks[i] = list_stack_alloc_with(allocator);
+        for (int j = 0; j < TEARDOWN_NODES; j++) {
+            list_stack_push(stacks[i], j);
+        }
+    }
+
+    double start = bench_now();
+    if (region == NULL) {
+        for (size_t i = 0; i < TEARDOWN_STACKS; i++) {
+            list_stack_delete(&stacks[i]);
+        }
+    } else {
+        arena_reset(region);
+    }
+    double elapsed = bench_now() - start;
+
+    bench_report(region == NULL ? "list_stack teardown (heap delete)" : "list_stack teardown (arena reset)",
+                 TEARDOWN_STACKS * TEARDOWN_NODES, elapsed);
+}
+
+void run_arena_benchmarks() {
+    bench_suite("arena");
+    bench_teardown(NULL, NULL);
+
+    arena region;
+    arena_init(&region, 1 << 20);
+    bench_teardown(arena_allocator(&region), &region);
+    arena_release(&region);
+    printf("\n");
+}
@@ -0,0 +1,280 @@
+//
+// Created by Christopher Szatmary on 2018-12-31.
+//
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include "benchmark.h"
+
+bench_options bench_config = { 1, 5, 10000000, false, NULL, NULL };
+
+// The suite the next results belong to, and whether a JSON result was written yet
+static const char *current_suite = "";
+static bool json_started = false;
+
+// Opened by the first bench_run with perf set, -1 until then
+static perf_counters counters;
+static int counters_status = -1;
+
+/* Helpers */
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Parses a count given on the command line.
+ * @param text The argument.
+ * @param value Set to the count.
+ * @return false if the argument isn't a whole number.
+ */
+static bool parse_count(const char *text, size_t *value) {
+    char *end;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+
+    if (errno != 0 || end == text || *end != '\0') {
+        return false;
+    }
+
+    *value = (size_t)parsed;
+    return true;
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr, "usage: %s [--warmup N] [--trials N] [--max-size N] [--perf] [--csv FILE] [--json FILE]\n", program);
+}
+
+/**
+ * Writes the counts of a measurement per operation as CSV fields or JSON members,
+ * empty or null for the counters that aren't available.
+ * @param file The result file.
+ * @param json Whether to write JSON members instead of CSV fields.
+ * @param measured A pointer to the counters summed over the trials, or NULL if none were measured.
+ * @param ops The number of operations measured.
+ */
+static void write_counters(FILE *file, bool json, const perf_counters *measured, double ops) {
+    static const char *names[] = { "cycles_per_op", "ipc", "cache_misses_per_op", "branch_misses_per_op", "page_faults_per_op" };
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        bool available = measured != NULL && measured->fds[i] != -1;
+        double value = available ? (double)measured->values[i] / ops : 0;
+
+        if (i == PERF_INSTRUCTIONS) {
+            available = available && measured->fds[PERF_CYCLES] != -1 && measured->values[PERF_CYCLES] > 0;
+            value = available ? (double)measured->values[i] / measured->values[PERF_CYCLES] : 0;
+        }
+
+        if (json) {
+            fprintf(file, available ? ", \"%s\": %.4f" : ", \"%s\": null", names[i], value);
+        } else if (available) {
+            fprintf(file, ",%.4f", value);
+        } else {
+            fprintf(file, ",");
+        }
+    }
+}
+
+/* Options */
+
+/**
+ * Reads the benchmark settings from the command line and opens the result files.
+ * @param argc The number of arguments.
+ * @param argv The arguments, starting with the program name.
+ * @return An integer indicating the status.
+ */
+int bench_parse_args(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+
+        if (strcmp(option, "--perf") == 0) {
+            bench_config.perf = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return EINVAL;
+        }
+
+        const char *value = argv[++i];
+        bool valid = true;
+
+        if (strcmp(option, "--warmup") == 0) {
+            valid = parse_count(value, &bench_config.warmup);
+        } else if (strcmp(option, "--trials") == 0) {
+            valid = parse_count(value, &bench_config.trials) && bench_config.trials > 0;
+        } else if (strcmp(option, "--max-size") == 0) {
+            valid = parse_count(value, &bench_config.max_size);
+        } else if (strcmp(option, "--csv") == 0) {
+            bench_config.csv = fopen(value, "w");
+            if (bench_config.csv == NULL) {
+                perror(value);
+                return errno;
+            }
+            fprintf(bench_config.csv, "suite,name,size,unit,count,trials,median_s,p99_s,min_s,rate,"
+                    "cycles_per_op,ipc,cache_misses_per_op,branch_misses_per_op,page_faults_per_op\n");
+        } else if (strcmp(option, "--json") == 0) {
+            bench_config.json = fopen(value, "w");
+            if (bench_config.json == NULL) {
+                perror(value);
+                return errno;
+            }
+            fprintf(bench_config.json, "[");
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            print_usage(argv[0]);
+            return EINVAL;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Completes and closes the result files, and closes the counters.
+ */
+void bench_finish(void) {
+    if (counters_status == EXIT_SUCCESS) {
+        perf_counters_close(&counters);
+        counters_status = -1;
+    }
+
+    if (bench_config.csv != NULL) {
+        fclose(bench_config.csv);
+        bench_config.csv = NULL;
+    }
+
+    if (bench_config.json != NULL) {
+        fprintf(bench_config.json, "\n]\n");
+        fclose(bench_config.json);
+        bench_config.json = NULL;
+    }
+}
+
+/* Reporting */
+
+/**
+ * Prints the heading of a group of benchmarks and files the results that follow under it.
+ * @param name The name of the suite.
+ */
+void bench_suite(const char *name) {
+    current_suite = name;
+    printf("%s\n", name);
+}
+
+/**
+ * Writes a result to the CSV and JSON files. Names are plain labels without quotes.
+ * @param name The name of the case.
+ * @param size The number of elements the case works on, or 0 if it doesn't apply.
+ * @param unit What count counts, ops or bytes.
+ * @param count The number of units processed in one trial.
+ * @param trials The number of timed trials.
+ * @param median The median time of a trial in seconds.
+ * @param p99 The 99th percentile time of a trial in seconds.
+ * @param fastest The fastest trial in seconds.
+ * @param counters A pointer to the counters summed over the timed trials, or NULL if none were measured.
+ */
+void bench_record(const char *name, size_t size, const char *unit, size_t count, size_t trials,
+                  double median, double p99, double fastest, const perf_counters *counters) {
+    double rate = (double)count / median;
+    double ops = (double)count * trials;
+
+    if (bench_config.csv != NULL) {
+        fprintf(bench_config.csv, "\"%s\",\"%s\",%zu,%s,%zu,%zu,%.9f,%.9f,%.9f,%.1f",
+                current_suite, name, size, unit, count, trials, median, p99, fastest, rate);
+        write_counters(bench_config.csv, false, counters, ops);
+        fprintf(bench_config.csv, "\n");
+    }
+
+    if (bench_config.json != NULL) {
+        fprintf(bench_config.json, "%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"size\": %zu, \"unit\": \"%s\", "
+                "\"count\": %zu, \"trials\": %zu, \"median_s\": %.9f, \"p99_s\": %.9f, \"min_s\": %.9f, \"rate\": %.1f",
+                json_started ? "," : "", current_suite, name, size, unit, count, trials, median, p99, fastest, rate);
+        write_counters(bench_config.json, true, counters, ops);
+        fprintf(bench_config.json, "}");
+        json_started = true;
+    }
+}
+
+/**
+ * Runs a workload for the configured number of warmup and timed trials
+ * and reports the median, 99th percentile and fastest time per operation.
+ * The percentile is taken by nearest rank over the trials, so with few trials it is the slowest one.
+ * With perf set the timed trials are also counted, and the counts are reported per operation.
+ * @param name The name of the case.
+ * @param size The number of elements the case works on.
+ * @param ops The number of operations in one trial.
+ * @param workload A pointer to the workload.
+ * @param context The context passed to the workload.
+ */
+void bench_run(const char *name, size_t size, size_t ops, const bench_workload *workload, void *context) {
+    size_t trials = bench_config.trials;
+    double *times = malloc(trials * sizeof(double));
+
+    if (times == NULL) {
+        fprintf(stderr, "%s: out of memory\n", name);
+        return;
+    }
+
+    if (bench_config.perf && counters_status == -1) {
+        counters_status = perf_counters_open(&counters);
+        if (counters_status != EXIT_SUCCESS) {
+            fprintf(stderr, "perf counters unavailable: %s\n", strerror(counters_status));
+        }
+    }
+
+    bool counting = bench_config.perf && counters_status == EXIT_SUCCESS;
+    perf_counters total = counters;
+    memset(total.values, 0, sizeof(total.values));
+
+    for (size_t i = 0; i < bench_config.warmup + trials; i++) {
+        bool timed = i >= bench_config.warmup;
+
+        if (workload->setup != NULL) {
+            workload->setup(context);
+        }
+
+        if (counting && timed) {
+            perf_counters_start(&counters);
+        }
+        double start = bench_now();
+        workload->run(context);
+        double elapsed = bench_now() - start;
+        if (counting && timed) {
+            perf_counters_stop(&counters);
+            for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+                total.values[c] += counters.values[c];
+            }
+        }
+
+        if (workload->teardown != NULL) {
+            workload->teardown(context);
+        }
+
+        if (timed) {
+            times[i - bench_config.warmup] = elapsed;
+        }
+    }
+
+    qsort(times, trials, sizeof(double), compare_doubles);
+    double median = trials % 2 == 1 ? times[trials / 2] : (times[trials / 2 - 1] + times[trials / 2]) / 2;
+    double p99 = times[(trials * 99 + 99) / 100 - 1];
+
+    printf("%-40s %12zu ops %12.1f ns/op p99 %12.1f ns/op %14.0f ops/s\n", name, ops,
+           median / ops * 1000000000.0, p99 / ops * 1000000000.0, (double)ops / median);
+    if (counting) {
+        printf("%-40s", "");
+        perf_counters_fprint(&total, stdout, ops * trials);
+    }
+    bench_record(name, size, "ops", ops, trials, median, p99, times[0], counting ? &total : NULL);
+
+    free(times);
+}
@@ -0,0 +1,89 @@
+//
+// Created by Christopher Szatmary on 2018-12-16.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_BENCHMARK_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_BENCHMARK_H
+
+#if !defined(_POSIX_C_SOURCE) || _POSIX_C_SOURCE < 200112L
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+#include "../utils/perf_counters.h"
+
+/**
+ * Settings for a run of the benchmarks, filled in from the command line.
+ * Results are always printed, and also written to the CSV and JSON files if they are open.
+ * With perf set the timed trials of bench_run are also measured with hardware counters.
+ */
+typedef struct {
+    size_t warmup;
+    size_t trials;
+    size_t max_size;
+    bool perf;
+    FILE *csv;
+    FILE *json;
+} bench_options;
+
+/**
+ * A benchmark case that is run several times. Only run is timed, setup and teardown
+ * prepare the context before each trial and clean up after it.
+ */
+typedef struct {
+    void (*setup)(void *context);
+    void (*run)(void *context);
+    void (*teardown)(void *context);
+} bench_workload;
+
+extern bench_options bench_config;
+
+int bench_parse_args(int argc, char **argv);
+void bench_finish(void);
+void bench_suite(const char *name);
+void bench_record(const char *name, size_t size, const char *unit, size_t count, size_t trials,
+                  double median, double p99, double fastest, const perf_counters *counters);
+void bench_run(const char *name, size_t size, size_t ops, const bench_workload *workload, void *context);
+
+/**
+ * Returns a monotonic timestamp in seconds.
+ * Only useful for computing the time elapsed between two calls.
+ */
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+/**
+ * Prints the throughput of a benchmark case.
+ * @param name The name of the case.
+ * @param ops The number of operations performed.
+ * @param seconds The time the operations took.
+ */
+static inline void bench_report(const char *name, size_t ops, double seconds) {
+    printf("%-40s %12zu ops %10.4f s %14.0f ops/s\n", name, ops, seconds, (double)ops / seconds);
+    bench_record(name, 0, "ops", ops, 1, seconds, seconds, seconds, NULL);
+}
+
+/**
+ * Prints the data rate of a benchmark case that processes a stream of bytes.
+ * @param name The name of the case.
+ * @param bytes The number of bytes processed.
+ * @param seconds The time the bytes took.
+ */
+static inline void bench_report_bytes(const char *name, size_t bytes, double seconds) {
+    printf("%-40s %12zu B   %10.4f s %14.1f MB/s\n", name, bytes, seconds, (double)bytes / seconds / 1000000.0);
+    bench_record(name, 0, "bytes", bytes, 1, seconds, seconds, seconds, NULL);
+}
+
+/**
+ * Keeps the compiler from optimizing away a computed value.
+ */
+static volatile long bench_sink;
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_BENCHMARK_H
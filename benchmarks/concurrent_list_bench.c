@@ -0,0 +1,129 @@
+//
+// Created by Christopher Szatmary on 2018-12-28.
+//
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "benchmark.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "../data_structures/concurrent_list/concurrent_list.h"
+#include "concurrent_list_bench.h"
+
+#define LIST_OPS 100000
+#define KEY_RANGE 512
+#define MAX_THREADS 8
+
+typedef struct {
+    linked_list *list;
+    pthread_mutex_t lock;
+} locked_list;
+
+typedef struct {
+    void *list;
+    bool locked;
+    size_t ops;
+    unsigned int read_percent;
+    uint32_t seed;
+    long found;
+} list_worker;
+
+/**
+ * Searches, inserts and removes random keys, searching in the worker's share of operations
+ * and splitting the rest evenly between inserts and removes so the list keeps its size.
+ */
+static void *list_work(void *context) {
+    list_worker *worker = context;
+
+    for (size_t i = 0; i < worker->ops; i++) {
+        worker->seed ^= worker->seed << 13;
+        worker->seed ^= worker->seed >> 17;
+        worker->seed ^= worker->seed << 5;
+
+        unsigned int roll = worker->seed % 100;
+        int key = (int)(worker->seed >> 8) % KEY_RANGE;
+
+        if (worker->locked) {
+            locked_list *locked = worker->list;
+            pthread_mutex_lock(&locked->lock);
+            if (roll < worker->read_percent) {
+                worker->found += linked_list_contains(locked->list, key);
+            } else if (roll % 2 == 0) {
+                linked_list_prepend(locked->list, key);
+            } else {
+                int index = linked_list_index_of(locked->list, key);
+                if (index >= 0) {
+                    linked_list_remove(locked->list, index);
+                }
+            }
+            pthread_mutex_unlock(&locked->lock);
+        } else if (roll < worker->read_percent) {
+            worker->found += concurrent_list_contains(worker->list, key);
+        } else if (roll % 2 == 0) {
+            concurrent_list_prepend(worker->list, key);
+        } else {
+            concurrent_list_remove(worker->list, key);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Splits LIST_OPS operations between threads sharing one list of KEY_RANGE / 2 keys and times them.
+ * @param name The name of the list.
+ * @param list A pointer to the list, a locked_list if locked is set.
+ * @param locked Whether the list is a linked list behind one mutex.
+ * @param thread_count The number of threads.
+ * @param read_percent The share of operations that are searches.
+ */
+static void run_threads(const char *name, void *list, bool locked, int thread_count, unsigned int read_percent) {
+    pthread_t threads[MAX_THREADS];
+    list_worker workers[MAX_THREADS];
+
+    double start = bench_now();
+    for (int i = 0; i < thread_count; i++) {
+        workers[i] = (list_worker){ list, locked, LIST_OPS / thread_count, read_percent, 2654435761u * (i + 1), 0 };
+        pthread_create(&threads[i], NULL, list_work, &workers[i]);
+    }
+    for (int i = 0; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        bench_sink += workers[i].found;
+    }
+    double elapsed = bench_now() - start;
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s x%d %u/%u", name, thread_count, read_percent, 100 - read_percent);
+    bench_report(label, (LIST_OPS / thread_count) * thread_count, elapsed);
+}
+
+/**
+ * Compares a linked list behind one mutex with the hand over hand locked concurrent list
+ * under read mostly and write heavy workloads as the number of threads grows.
+ */
+static void bench_mixed() {
+    static const unsigned int read_percents[] = { 90, 50 };
+    int keys[KEY_RANGE / 2];
+    for (int i = 0; i < KEY_RANGE / 2; i++) {
+        keys[i] = i * 2;
+    }
+
+    for (size_t r = 0; r < sizeof(read_percents) / sizeof(read_percents[0]); r++) {
+        for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            locked_list locked = { linked_list_new(keys, KEY_RANGE / 2), PTHREAD_MUTEX_INITIALIZER };
+            run_threads("linked_list + mutex", &locked, true, threads, read_percents[r]);
+            linked_list_delete(&locked.list);
+            pthread_mutex_destroy(&locked.lock);
+
+            concurrent_list *list = concurrent_list_new(keys, KEY_RANGE / 2);
+            run_threads("concurrent_list", list, false, threads, read_percents[r]);
+            concurrent_list_delete(&list);
+        }
+    }
+}
+
+void run_concurrent_list_benchmarks() {
+    bench_suite("concurrent list");
+    bench_mixed();
+    printf("\n");
+}
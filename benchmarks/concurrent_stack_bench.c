@@ -0,0 +1,216 @@
+//
+// Created by Christopher Szatmary on 2018-12-25.
+//
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "benchmark.h"
+#include "../data_structures/stack/list_stack.h"
+#include "../data_structures/stack/concurrent_list_stack.h"
+#include "../data_structures/stack/concurrent_array_stack.h"
+#include "concurrent_stack_bench.h"
+
+#define STACK_OPS 4000000
+#define MAX_THREADS 16
+
+// Values on the stack before a mixed case starts, so pops rarely find it empty
+#define PREFILL 100000
+
+typedef struct {
+    list_stack *stack;
+    pthread_mutex_t lock;
+} locked_stack;
+
+/**
+ * The operations of one of the stacks being compared.
+ */
+typedef struct {
+    const char *name;
+    void *(*create)(void);
+    void (*destroy)(void *stack);
+    void (*push)(void *stack, int value);
+    bool (*try_pop)(void *stack, int *value);
+} stack_kind;
+
+typedef struct {
+    const stack_kind *kind;
+    void *stack;
+    size_t ops;
+    unsigned int push_percent;
+    uint32_t seed;
+    long sum;
+} stack_worker;
+
+static void *locked_create(void) {
+    locked_stack *locked = malloc(sizeof(locked_stack));
+    locked->stack = list_stack_alloc();
+    pthread_mutex_init(&locked->lock, NULL);
+    return locked;
+}
+
+static void locked_destroy(void *stack) {
+    locked_stack *locked = stack;
+    list_stack_delete(&locked->stack);
+    pthread_mutex_destroy(&locked->lock);
+    free(locked);
+}
+
+static void locked_push(void *stack, int value) {
+    locked_stack *locked = stack;
+    pthread_mutex_lock(&locked->lock);
+    list_stack_push(locked->stack, value);
+    pthread_mutex_unlock(&locked->lock);
+}
+
+static bool locked_try_pop(void *stack, int *value) {
+    locked_stack *locked = stack;
+    pthread_mutex_lock(&locked->lock);
+    bool found = locked->stack->length > 0;
+    if (found) {
+        *value = list_stack_pop(locked->stack);
+    }
+    pthread_mutex_unlock(&locked->lock);
+    return found;
+}
+
+static void *list_create(void) {
+    return concurrent_list_stack_alloc();
+}
+
+static void list_destroy(void *stack) {
+    concurrent_list_stack_delete((concurrent_list_stack **)&stack);
+}
+
+static void list_push(void *stack, int value) {
+    concurrent_list_stack_push(stack, value);
+}
+
+static bool list_try_pop(void *stack, int *value) {
+    return concurrent_list_stack_try_pop(stack, value);
+}
+
+static void *array_create(void) {
+    return concurrent_array_stack_alloc();
+}
+
+static void array_destroy(void *stack) {
+    concurrent_array_stack_delete((concurrent_array_stack **)&stack);
+}
+
+static void array_push(void *stack, int value) {
+    concurrent_array_stack_push(stack, value);
+}
+
+static bool array_try_pop(void *stack, int *value) {
+    return concurrent_array_stack_try_pop(stack, value);
+}
+
+static const stack_kind stack_kinds[] = {
+    { "list_stack + mutex", locked_create, locked_destroy, locked_push, locked_try_pop },
+    { "concurrent_list_stack", list_create, list_destroy, list_push, list_try_pop },
+    { "concurrent_array_stack", array_create, array_destroy, array_push, array_try_pop },
+};
+
+/**
+ * Pushes and pops in pairs, or at random in the worker's ratio.
+ */
+static void *stack_work(void *context) {
+    stack_worker *worker = context;
+    const stack_kind *kind = worker->kind;
+
+    for (size_t i = 0; i < worker->ops; i++) {
+        bool push;
+        if (worker->push_percent == 0) {
+            push = i % 2 == 0;
+        } else {
+            worker->seed ^= worker->seed << 13;
+            worker->seed ^= worker->seed >> 17;
+            worker->seed ^= worker->seed << 5;
+            push = worker->seed % 100 < worker->push_percent;
+        }
+
+        int value;
+        if (push) {
+            kind->push(worker->stack, (int)i);
+        } else if (kind->try_pop(worker->stack, &value)) {
+            worker->sum += value;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Splits STACK_OPS operations between threads sharing one stack and times them.
+ * Cases are labelled with the thread count and the push/pop ratio, e.g. "x8 75/25".
+ * @param kind The stack to run on.
+ * @param thread_count The number of threads.
+ * @param push_percent The share of operations that are pushes, or 0 to alternate pushes and pops.
+ */
+static void run_threads(const stack_kind *kind, int thread_count, unsigned int push_percent) {
+    pthread_t threads[MAX_THREADS];
+    stack_worker workers[MAX_THREADS];
+    void *stack = kind->create();
+
+    if (push_percent != 0) {
+        for (int i = 0; i < PREFILL; i++) {
+            kind->push(stack, i);
+        }
+    }
+
+    double start = bench_now();
+    for (int i = 0; i < thread_count; i++) {
+        workers[i] = (stack_worker){ kind, stack, STACK_OPS / thread_count, push_percent, 2654435761u * (i + 1), 0 };
+        pthread_create(&threads[i], NULL, stack_work, &workers[i]);
+    }
+    for (int i = 0; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        bench_sink += workers[i].sum;
+    }
+    double elapsed = bench_now() - start;
+
+    char label[64];
+    if (push_percent == 0) {
+        snprintf(label, sizeof(label), "%s x%d", kind->name, thread_count);
+    } else {
+        snprintf(label, sizeof(label), "%s x%d %u/%u", kind->name, thread_count, push_percent, 100 - push_percent);
+    }
+    bench_report(label, (STACK_OPS / thread_count) * thread_count, elapsed);
+
+    kind->destroy(stack);
+}
+
+/**
+ * Compares the stacks under alternating pushes and pops as the number of threads sharing them grows.
+ */
+static void bench_contention() {
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        for (size_t k = 0; k < sizeof(stack_kinds) / sizeof(stack_kind); k++) {
+            run_threads(&stack_kinds[k], threads, 0);
+        }
+    }
+}
+
+/**
+ * Compares the stacks under random pushes and pops in different ratios,
+ * where the elimination array has fewer pairs to cancel out.
+ */
+static void bench_ratios() {
+    static const unsigned int push_percents[] = { 50, 75, 25 };
+
+    for (size_t r = 0; r < sizeof(push_percents) / sizeof(push_percents[0]); r++) {
+        for (int threads = 2; threads <= MAX_THREADS; threads *= 4) {
+            for (size_t k = 0; k < sizeof(stack_kinds) / sizeof(stack_kind); k++) {
+                run_threads(&stack_kinds[k], threads, push_percents[r]);
+            }
+        }
+    }
+}
+
+void run_concurrent_stack_benchmarks() {
+    bench_suite("concurrent stack");
+    bench_contention();
+    bench_ratios();
+    printf("\n");
+}
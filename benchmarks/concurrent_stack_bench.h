@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-25.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_STACK_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_STACK_BENCH_H
+
+void run_concurrent_stack_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_STACK_BENCH_H
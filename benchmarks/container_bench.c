@@ -0,0 +1,306 @@
+//
+// Created by Christopher Szatmary on 2018-12-31.
+//
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "benchmark.h"
+#include "../data_structures/stack/array_stack.h"
+#include "../data_structures/stack/list_stack.h"
+#include "linked_list_bench.h"
+#include "container_bench.h"
+
+// Each trial does at least this many operations, by repeating the workload on small sizes
+#define MIN_TRIAL_OPS (1 << 20)
+#define BURST_LENGTH 64
+#define RANDOM_READS (1 << 20)
+
+// Elements stepped over per trial by containers that walk to an index
+#define WALK_BUDGET (1 << 24)
+#define MIN_WALKS 16
+
+static const size_t sizes[] = { 10, 1000, 100000, 10000000, 100000000 };
+
+/**
+ * The state of one container benchmark case, shared by its setup, run and teardown.
+ */
+typedef struct {
+    const bench_container *container;
+    size_t size;
+    size_t rounds;
+    void **containers;
+    size_t *indexes;
+    size_t index_count;
+    long sum;
+} container_case;
+
+/* Adapters */
+
+static void *array_create(void) {
+    return array_stack_alloc();
+}
+
+static void array_destroy(void *container) {
+    array_stack *stack = container;
+    array_stack_delete(&stack);
+}
+
+static void array_push(void *container, int value) {
+    array_stack_push(container, value);
+}
+
+static int array_pop(void *container) {
+    return array_stack_pop(container);
+}
+
+static long array_sum(void *container) {
+    array_stack *stack = container;
+    long sum = 0;
+    for (size_t i = 0; i < stack->length; i++) {
+        sum += stack->data[i];
+    }
+    return sum;
+}
+
+static int array_element(void *container, size_t index) {
+    return ((array_stack *)container)->data[index];
+}
+
+static void *stack_create(void) {
+    return list_stack_alloc();
+}
+
+static void stack_destroy(void *container) {
+    list_stack *stack = container;
+    list_stack_delete(&stack);
+}
+
+static void stack_push(void *container, int value) {
+    list_stack_push(container, value);
+}
+
+static int stack_pop(void *container) {
+    return list_stack_pop(container);
+}
+
+static long stack_sum(void *container) {
+    long sum = 0;
+    for (stack_node *current = ((list_stack *)container)->top; current != NULL; current = current->previous) {
+        sum += current->data;
+    }
+    return sum;
+}
+
+static int stack_element(void *container, size_t index) {
+    stack_node *current = ((list_stack *)container)->top;
+    for (size_t i = 0; i < index; i++) {
+        current = current->previous;
+    }
+    return current->data;
+}
+
+static const bench_container array_stack_bench_container = {
+    "array_stack", false, array_create, array_destroy, array_push, array_pop,
+    array_sum, array_element, NULL, NULL
+};
+
+static const bench_container list_stack_bench_container = {
+    "list_stack", true, stack_create, stack_destroy, stack_push, stack_pop,
+    stack_sum, stack_element, NULL, NULL
+};
+
+/* Helpers */
+
+static void *filled(const bench_container *container, size_t size) {
+    void *instance = container->create();
+    for (size_t i = 0; i < size; i++) {
+        container->push(instance, (int)i);
+    }
+    return instance;
+}
+
+static size_t rounds_for(size_t size) {
+    return (MIN_TRIAL_OPS + size - 1) / size;
+}
+
+/**
+ * Fills the index array of a case with random indexes below a bound.
+ * @param test A pointer to the case.
+ * @param count The number of indexes.
+ * @param bound The number of valid indexes.
+ */
+static void random_indexes(container_case *test, size_t count, size_t bound) {
+    uint32_t seed = 2463534242u;
+    test->indexes = malloc(count * sizeof(size_t));
+    test->index_count = count;
+
+    for (size_t i = 0; i < count; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        test->indexes[i] = (size_t)(((uint64_t)seed * bound) >> 32);
+    }
+}
+
+static size_t walks_for(size_t size) {
+    size_t walks = WALK_BUDGET / size;
+    return walks < MIN_WALKS ? MIN_WALKS : walks;
+}
+
+/* Workloads */
+
+static void create_empty(void *context) {
+    container_case *test = context;
+    for (size_t r = 0; r < test->rounds; r++) {
+        test->containers[r] = test->container->create();
+    }
+}
+
+static void create_filled(void *context) {
+    container_case *test = context;
+    for (size_t r = 0; r < test->rounds; r++) {
+        test->containers[r] = filled(test->container, test->size);
+    }
+}
+
+static void destroy_all(void *context) {
+    container_case *test = context;
+    for (size_t r = 0; r < test->rounds; r++) {
+        test->container->destroy(test->containers[r]);
+    }
+}
+
+static void run_push(void *context) {
+    container_case *test = context;
+    for (size_t r = 0; r < test->rounds; r++) {
+        for (size_t i = 0; i < test->size; i++) {
+            test->container->push(test->containers[r], (int)i);
+        }
+    }
+}
+
+static void run_pop(void *context) {
+    container_case *test = context;
+    long sum = 0;
+    for (size_t r = 0; r < test->rounds; r++) {
+        for (size_t i = 0; i < test->size; i++) {
+            sum += test->container->pop(test->containers[r]);
+        }
+    }
+    test->sum += sum;
+}
+
+/**
+ * Pushes and then pops BURST_LENGTH values at a time on top of a container of the case's size,
+ * the pattern of a work list that grows and shrinks around a steady size.
+ */
+static void run_burst(void *context) {
+    container_case *test = context;
+    long sum = 0;
+    for (size_t r = 0; r < test->rounds; r++) {
+        for (int i = 0; i < BURST_LENGTH; i++) {
+            test->container->push(test->containers[0], i);
+        }
+        for (int i = 0; i < BURST_LENGTH; i++) {
+            sum += test->container->pop(test->containers[0]);
+        }
+    }
+    test->sum += sum;
+}
+
+static void run_scan(void *context) {
+    container_case *test = context;
+    long sum = 0;
+    for (size_t r = 0; r < test->rounds; r++) {
+        sum += test->container->sum(test->containers[0]);
+    }
+    test->sum += sum;
+}
+
+static void run_read(void *context) {
+    container_case *test = context;
+    long sum = 0;
+    for (size_t i = 0; i < test->index_count; i++) {
+        sum += test->container->element(test->containers[0], test->indexes[i]);
+    }
+    test->sum += sum;
+}
+
+/**
+ * Inserts at random positions and removes again at the same positions, so the size stays put.
+ */
+static void run_insert(void *context) {
+    container_case *test = context;
+    long sum = 0;
+    for (size_t i = 0; i < test->index_count; i++) {
+        test->container->insert(test->containers[0], test->indexes[i], (int)i);
+        sum += test->container->remove(test->containers[0], test->indexes[i]);
+    }
+    test->sum += sum;
+}
+
+/**
+ * Runs every workload on one container at one size.
+ * @param container A pointer to the container's operations.
+ * @param size The number of elements.
+ */
+static void bench_container_size(const bench_container *container, size_t size) {
+    static const bench_workload push = { create_empty, run_push, destroy_all };
+    static const bench_workload pop = { create_filled, run_pop, destroy_all };
+    static const bench_workload burst = { NULL, run_burst, NULL };
+    static const bench_workload scan = { NULL, run_scan, NULL };
+    static const bench_workload read = { NULL, run_read, NULL };
+    static const bench_workload insert = { NULL, run_insert, NULL };
+
+    size_t rounds = rounds_for(size);
+    void *instance = NULL;
+    container_case test = { container, size, rounds, malloc(rounds * sizeof(void *)), NULL, 0, 0 };
+    char label[64];
+
+    snprintf(label, sizeof(label), "%s push n=%zu", container->name, size);
+    bench_run(label, size, rounds * size, &push, &test);
+    snprintf(label, sizeof(label), "%s pop n=%zu", container->name, size);
+    bench_run(label, size, rounds * size, &pop, &test);
+    free(test.containers);
+
+    // The remaining workloads leave the container as they found it, so it is built once
+    instance = filled(container, size);
+    test.containers = &instance;
+
+    test.rounds = MIN_TRIAL_OPS / (2 * BURST_LENGTH);
+    snprintf(label, sizeof(label), "%s burst %d n=%zu", container->name, BURST_LENGTH, size);
+    bench_run(label, size, test.rounds * 2 * BURST_LENGTH, &burst, &test);
+
+    test.rounds = rounds;
+    snprintf(label, sizeof(label), "%s scan seq n=%zu", container->name, size);
+    bench_run(label, size, rounds * size, &scan, &test);
+
+    random_indexes(&test, container->walks ? walks_for(size) : RANDOM_READS, size);
+    snprintf(label, sizeof(label), "%s read random n=%zu", container->name, size);
+    bench_run(label, size, test.index_count, &read, &test);
+    free(test.indexes);
+
+    if (container->insert != NULL) {
+        random_indexes(&test, walks_for(size), size);
+        snprintf(label, sizeof(label), "%s insert random n=%zu", container->name, size);
+        bench_run(label, size, test.index_count, &insert, &test);
+        free(test.indexes);
+    }
+
+    container->destroy(instance);
+    bench_sink += test.sum;
+}
+
+void run_container_benchmarks() {
+    const bench_container *containers[] = {
+        &array_stack_bench_container, &list_stack_bench_container, &linked_list_bench_container
+    };
+
+    bench_suite("containers");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= bench_config.max_size; s++) {
+        for (size_t c = 0; c < sizeof(containers) / sizeof(containers[0]); c++) {
+            bench_container_size(containers[c], sizes[s]);
+        }
+    }
+    printf("\n");
+}
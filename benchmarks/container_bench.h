@@ -0,0 +1,31 @@
+//
+// Created by Christopher Szatmary on 2018-12-31.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONTAINER_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONTAINER_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * The operations the container benchmarks need, so every container runs the same workloads.
+ * insert and remove are NULL for containers without positional updates,
+ * and walks is set if reaching an element by index takes time proportional to the index.
+ */
+typedef struct {
+    const char *name;
+    bool walks;
+    void *(*create)(void);
+    void (*destroy)(void *container);
+    void (*push)(void *container, int value);
+    int (*pop)(void *container);
+    long (*sum)(void *container);
+    int (*element)(void *container, size_t index);
+    void (*insert)(void *container, size_t index, int value);
+    int (*remove)(void *container, size_t index);
+} bench_container;
+
+void run_container_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONTAINER_BENCH_H
@@ -0,0 +1,134 @@
+//
+// Created by Christopher Szatmary on 2019-01-03.
+//
+
+#include <stdlib.h>
+#include "benchmark.h"
+#include "../utils/growth_policy.h"
+#include "../data_structures/stack/array_stack.h"
+#include "growth_policy_bench.h"
+
+// Each trial does at least this many pushes, by filling several stacks on small sizes
+#define MIN_TRIAL_OPS (1 << 20)
+
+// The increment of the capped policy, 4 MB of ints
+#define CAPPED_LIMIT (1 << 20)
+
+static const size_t sizes[] = { 1000, 100000, 10000000, 100000000 };
+
+typedef struct {
+    const char *name;
+    growth_policy policy;
+} named_policy;
+
+/**
+ * The state of one growth policy benchmark case, shared by its setup, run and teardown.
+ */
+typedef struct {
+    const growth_policy *policy;
+    size_t size;
+    size_t rounds;
+    array_stack **stacks;
+    memory_usage usage;
+} growth_case;
+
+/* Workloads */
+
+static void create_stacks(void *context) {
+    growth_case *test = context;
+    for (size_t r = 0; r < test->rounds; r++) {
+        test->stacks[r] = array_stack_alloc_with_policy(NULL, test->policy);
+    }
+}
+
+static void run_push(void *context) {
+    growth_case *test = context;
+    for (size_t r = 0; r < test->rounds; r++) {
+        for (size_t i = 0; i < test->size; i++) {
+            array_stack_push(test->stacks[r], (int)i);
+        }
+    }
+}
+
+static void destroy_stacks(void *context) {
+    growth_case *test = context;
+    test->usage = array_stack_memory_usage(test->stacks[0]);
+    for (size_t r = 0; r < test->rounds; r++) {
+        array_stack_delete(&test->stacks[r]);
+    }
+}
+
+/* Benchmarks */
+
+/**
+ * Replays the growth of a stack under a policy to find the most memory it holds at once,
+ * which is while a resize has both the old and the new array, and the bytes copied on the way.
+ * @param policy A pointer to the policy.
+ * @param size The number of elements pushed.
+ * @param copied Set to the bytes copied by resizes, assuming none happens in place.
+ * @return The peak in bytes.
+ */
+static size_t growth_peak(const growth_policy *policy, size_t size, size_t *copied) {
+    size_t capacity = 0;
+    size_t peak = 0;
+    *copied = 0;
+
+    while (capacity < size) {
+        size_t next = policy->grow(policy, capacity, capacity + 1);
+        if (capacity + next > peak) {
+            peak = capacity + next;
+        }
+        *copied += capacity;
+        capacity = next;
+    }
+
+    return peak * sizeof(int);
+}
+
+/**
+ * Pushes size values onto stacks growing under a policy, then reports the spare capacity
+ * left at the end and the peak memory of the growth. Memory rows aren't timed,
+ * their times are 1 so the rate column repeats the byte count.
+ * @param named A pointer to the policy and its name.
+ * @param size The number of values to push.
+ */
+static void bench_policy_size(const named_policy *named, size_t size) {
+    static const bench_workload push = { create_stacks, run_push, destroy_stacks };
+
+    size_t rounds = (MIN_TRIAL_OPS + size - 1) / size;
+    growth_case test = { &named->policy, size, rounds, malloc(rounds * sizeof(array_stack *)), { 0, 0, 0 } };
+    char label[64];
+
+    snprintf(label, sizeof(label), "%s push n=%zu", named->name, size);
+    bench_run(label, size, rounds * size, &push, &test);
+
+    size_t copied;
+    size_t peak = growth_peak(&named->policy, size, &copied);
+    printf("%-40s %12zu B spare %5.1f%% peak %12zu B copied %12zu B\n", "", test.usage.slack,
+           100.0 * (double)test.usage.slack / (double)test.usage.payload, peak, copied * sizeof(int));
+
+    snprintf(label, sizeof(label), "%s spare n=%zu", named->name, size);
+    bench_record(label, size, "bytes", test.usage.slack, 1, 1, 1, 1, NULL);
+    snprintf(label, sizeof(label), "%s peak n=%zu", named->name, size);
+    bench_record(label, size, "bytes", peak, 1, 1, 1, 1, NULL);
+
+    free(test.stacks);
+}
+
+void run_growth_policy_benchmarks() {
+    named_policy policies[] = {
+        { "doubling", growth_policy_doubling() },
+        { "geometric 1.5", growth_policy_geometric(1.5) },
+        { "geometric 1.25", growth_policy_geometric(1.25) },
+        { "paged 1.5", growth_policy_paged(1.5) },
+        { "capped 1.5/1M", growth_policy_capped(1.5, CAPPED_LIMIT) },
+    };
+
+    bench_suite("growth_policy");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= bench_config.max_size; s++) {
+        for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+            bench_policy_size(&policies[p], sizes[s]);
+        }
+    }
+    printf("\n");
+}
@@ -0,0 +1,77 @@
+//
+// Created by Christopher Szatmary on 2018-12-24.
+//
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "benchmark.h"
+#include "../data_structures/stack/array_stack.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "int_reader_bench.h"
+
+#define INGEST_COUNT 10000000
+#define INGEST_PATH "/tmp/dsa_bench_ints.txt"
+
+/**
+ * Writes INGEST_COUNT random integers to a text file, one per line.
+ * @return The size of the file in bytes.
+ */
+static size_t write_input() {
+    FILE *file = fopen(INGEST_PATH, "w");
+    if (file == NULL) {
+        return 0;
+    }
+
+    srand(13);
+    for (int i = 0; i < INGEST_COUNT; i++) {
+        fprintf(file, "%d\n", rand() - RAND_MAX / 2);
+    }
+
+    size_t size = (size_t)ftell(file);
+    fclose(file);
+
+    return size;
+}
+
+/**
+ * Reads a file of integers with fscanf and array_stack_push, then with the streaming readers.
+ */
+static void bench_ingest() {
+    size_t size = write_input();
+    if (size == 0) {
+        return;
+    }
+
+    array_stack *stack = array_stack_alloc();
+    FILE *file = fopen(INGEST_PATH, "r");
+    double start = bench_now();
+    int value;
+    while (fscanf(file, "%d", &value) == 1) {
+        array_stack_push(stack, value);
+    }
+    bench_report_bytes("fscanf + array_stack_push", size, bench_now() - start);
+    fclose(file);
+    array_stack_delete(&stack);
+
+    stack = array_stack_alloc();
+    start = bench_now();
+    array_stack_read(stack, INGEST_PATH);
+    bench_report_bytes("array_stack_read", size, bench_now() - start);
+    bench_sink += array_stack_peak(stack);
+    array_stack_delete(&stack);
+
+    linked_list *list = linked_list_alloc();
+    start = bench_now();
+    linked_list_read(list, INGEST_PATH);
+    bench_report_bytes("linked_list_read", size, bench_now() - start);
+    bench_sink += linked_list_last(list);
+    linked_list_delete(&list);
+
+    unlink(INGEST_PATH);
+}
+
+void run_int_reader_benchmarks() {
+    bench_suite("int_reader");
+    bench_ingest();
+    printf("\n");
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-24.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_INT_READER_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_INT_READER_BENCH_H
+
+void run_int_reader_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_INT_READER_BENCH_H
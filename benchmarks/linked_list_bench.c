@@ -0,0 +1,443 @@
+//
+// Created by Christopher Szatmary on 2018-12-16.
+//
+
+#include <stdlib.h>
+#include "benchmark.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "linked_list_bench.h"
+
+#define CHURN_LIST_SIZE 1000
+#define CHURN_ROUNDS 2000000
+#define RANDOM_LIST_SIZE 1000000
+#define RANDOM_ACCESSES 1000
+#define SEQUENTIAL_LIST_SIZE 50000
+#define COMPACT_LIST_SIZE 2000000
+#define COMPACT_SCANS 10
+#define SEARCH_LIST_SIZE 4000000
+#define SEARCH_ROUNDS 3
+#define SORT_LIST_SIZE 1000000
+#define SPLIT_LIST_SIZE 100000
+#define SPLIT_ROUNDS 100
+#define PRINT_LIST_SIZE 10000000
+
+/**
+ * Appends and removes nodes with one malloc and free per node,
+ * the way linked_list did before it took nodes from a pool.
+ */
+static void bench_churn_malloc() {
+    list_node *head = NULL;
+    list_node *tail = NULL;
+
+    double start = bench_now();
+    for (size_t i = 0; i < CHURN_ROUNDS; i++) {
+        list_node *node = malloc(sizeof(list_node));
+        node->data = (int)i;
+        node->next = NULL;
+        node->previous = tail;
+        if (tail == NULL) {
+            head = node;
+        } else {
+            tail->next = node;
+        }
+        tail = node;
+
+        if (i >= CHURN_LIST_SIZE) {
+            list_node *first = head;
+            head = first->next;
+            head->previous = NULL;
+            bench_sink += first->data;
+            free(first);
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    while (head != NULL) {
+        list_node *next = head->next;
+        free(head);
+        head = next;
+    }
+
+    bench_report("churn append/remove_first (malloc)", CHURN_ROUNDS, elapsed);
+}
+
+/**
+ * Appends and removes nodes through linked_list, which recycles them through its pool.
+ */
+static void bench_churn_pool() {
+    linked_list *list = linked_list_alloc();
+
+    double start = bench_now();
+    for (size_t i = 0; i < CHURN_ROUNDS; i++) {
+        linked_list_append(list, (int)i);
+        if (i >= CHURN_LIST_SIZE) {
+            bench_sink += linked_list_remove_first(list);
+        }
+    }
+    double elapsed = bench_now() - start;
+
+    linked_list_delete(&list);
+    bench_report("churn append/remove_first (pool)", CHURN_ROUNDS, elapsed);
+}
+
+/**
+ * Reads, inserts and removes at random positions in a large list.
+ * @param indexed Whether the list has its skip list index enabled.
+ */
+static void bench_random_positional(bool indexed) {
+    linked_list *list = linked_list_alloc();
+    for (int i = 0; i < RANDOM_LIST_SIZE; i++) {
+        linked_list_append(list, i);
+    }
+    if (indexed) {
+        linked_list_index_enable(list);
+    }
+
+    srand(1);
+    double start = bench_now();
+    for (size_t i = 0; i < RANDOM_ACCESSES; i++) {
+        int position = rand() % (int)list->length;
+        bench_sink += linked_list_element(list, position);
+        linked_list_insert(list, (int)i, position);
+        bench_sink += linked_list_remove(list, rand() % (int)list->length);
+    }
+    double elapsed = bench_now() - start;
+
+    linked_list_delete(&list);
+    bench_report(indexed ? "random element/insert/remove (indexed)" : "random element/insert/remove (walk)",
+                 RANDOM_ACCESSES * 3, elapsed);
+}
+
+/**
+ * Visits every element in order by calling linked_list_element for each index.
+ */
+static void bench_sequential_indexed() {
+    linked_list *list = linked_list_alloc();
+    for (int i = 0; i < SEQUENTIAL_LIST_SIZE; i++) {
+        linked_list_append(list, i);
+    }
+
+    double start = bench_now();
+    long sum = 0;
+    for (int i = 0; i < SEQUENTIAL_LIST_SIZE; i++) {
+        sum += linked_list_element(list, i);
+    }
+    bench_sink += sum;
+    double elapsed = bench_now() - start;
+
+    linked_list_delete(&list);
+    bench_report("sequential visit (linked_list_element)", SEQUENTIAL_LIST_SIZE, elapsed);
+}
+
+/**
+ * Visits every element in order with a cursor.
+ */
+static void bench_sequential_cursor() {
+    linked_list *list = linked_list_alloc();
+    for (int i = 0; i < SEQUENTIAL_LIST_SIZE; i++) {
+        linked_list_append(list, i);
+    }
+
+    double start = bench_now();
+    long sum = 0;
+    for (linked_list_cursor cursor = linked_list_cursor_at(list, 0);
+         linked_list_cursor_valid(&cursor); linked_list_cursor_next(&cursor)) {
+        sum += linked_list_cursor_get(&cursor);
+    }
+    bench_sink += sum;
+    double elapsed = bench_now() - start;
+
+    linked_list_delete(&list);
+    bench_report("sequential visit (cursor)", SEQUENTIAL_LIST_SIZE, elapsed);
+}
+
+/**
+ * Sums a list COMPACT_SCANS times and reports the time per element.
+ * @param list A pointer to the linked list.
+ * @param name The name of the case.
+ */
+static void bench_scan(linked_list *list, const char *name) {
+    double start = bench_now();
+    for (int round = 0; round < COMPACT_SCANS; round++) {
+        long sum = 0;
+        for (list_node *current = list->head; current != NULL; current = current->next) {
+            sum += current->data;
+        }
+        bench_sink += sum;
+    }
+    double elapsed = bench_now() - start;
+
+    bench_report(name, list->length * COMPACT_SCANS, elapsed);
+}
+
+/**
+ * Scrambles the memory order of a list with cursor inserts and removes,
+ * then compares traversal before and after linked_list_compact.
+ */
+static void bench_compact() {
+    linked_list *list = linked_list_alloc();
+    for (int i = 0; i < COMPACT_LIST_SIZE; i++) {
+        linked_list_append(list, i);
+    }
+
+    // Remove random nodes, then refill the freed slots at other random places
+    srand(2);
+    for (int pass = 0; pass < 2; pass++) {
+        for (linked_list_cursor cursor = linked_list_cursor_at(list, 0); linked_list_cursor_valid(&cursor);) {
+            if (rand() % 2 == 0) {
+                linked_list_cursor_remove(&cursor);
+            } else {
+                linked_list_cursor_next(&cursor);
+            }
+        }
+        for (linked_list_cursor cursor = linked_list_cursor_at(list, 0); list->length < COMPACT_LIST_SIZE;) {
+            if (!linked_list_cursor_valid(&cursor)) {
+                cursor = linked_list_cursor_at(list, 0);
+            }
+            if (rand() % 2 == 0) {
+                linked_list_cursor_insert_after(&cursor, rand());
+            }
+            linked_list_cursor_next(&cursor);
+        }
+    }
+
+    printf("fragmentation before compact: %.3f\n", linked_list_fragmentation(list));
+    bench_scan(list, "scan fragmented list");
+
+    double start = bench_now();
+    linked_list_compact(list);
+    bench_report("linked_list_compact", list->length, bench_now() - start);
+
+    printf("fragmentation after compact: %.3f\n", linked_list_fragmentation(list));
+    bench_scan(list, "scan compacted list");
+
+    linked_list_delete(&list);
+}
+
+/**
+ * Relinks the nodes of a list in a random order so that every step of a walk misses the cache.
+ * @param list A pointer to a list built by linked_list_init.
+ */
+static void scramble(linked_list *list) {
+    size_t length = list->length;
+    list_node **nodes = malloc(length * sizeof(list_node *));
+    size_t i = 0;
+    for (list_node *current = list->head; current != NULL; current = current->next) {
+        nodes[i++] = current;
+    }
+
+    srand(3);
+    for (i = length - 1; i > 0; i--) {
+        size_t j = ((size_t)rand() * RAND_MAX + rand()) % (i + 1);
+        list_node *swap = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = swap;
+    }
+
+    for (i = 0; i < length; i++) {
+        nodes[i]->previous = i == 0 ? NULL : nodes[i - 1];
+        nodes[i]->next = i == length - 1 ? NULL : nodes[i + 1];
+    }
+    list->head = nodes[0];
+    list->tail = nodes[length - 1];
+
+    free(nodes);
+}
+
+/**
+ * Counts a value in a list far larger than the last level cache,
+ * with a plain walk and with linked_list_count.
+ */
+static void bench_search() {
+    int *values = malloc(SEARCH_LIST_SIZE * sizeof(int));
+    for (int i = 0; i < SEARCH_LIST_SIZE; i++) {
+        values[i] = i % 1000;
+    }
+    linked_list *list = linked_list_new(values, SEARCH_LIST_SIZE);
+    free(values);
+    scramble(list);
+
+    double start = bench_now();
+    for (int round = 0; round < SEARCH_ROUNDS; round++) {
+        size_t count = 0;
+        for (list_node *current = list->head; current != NULL; current = current->next) {
+            count += current->data == 7;
+        }
+        bench_sink += (long)count;
+    }
+    bench_report("count (naive walk)", SEARCH_LIST_SIZE * SEARCH_ROUNDS, bench_now() - start);
+
+    start = bench_now();
+    for (int round = 0; round < SEARCH_ROUNDS; round++) {
+        bench_sink += (long)linked_list_count(list, 7);
+    }
+    bench_report("linked_list_count (2 chains)", SEARCH_LIST_SIZE * SEARCH_ROUNDS, bench_now() - start);
+
+    linked_list_index_enable(list);
+    start = bench_now();
+    for (int round = 0; round < SEARCH_ROUNDS; round++) {
+        bench_sink += (long)linked_list_count(list, 7);
+    }
+    bench_report("linked_list_count (indexed, 8 chains)", SEARCH_LIST_SIZE * SEARCH_ROUNDS, bench_now() - start);
+
+    start = bench_now();
+    for (int round = 0; round < SEARCH_ROUNDS; round++) {
+        bench_sink += linked_list_contains(list, -1);
+    }
+    bench_report("linked_list_contains miss (indexed)", SEARCH_LIST_SIZE * SEARCH_ROUNDS, bench_now() - start);
+
+    linked_list_delete(&list);
+}
+
+/**
+ * Sorts a list of random values in place, then merges two sorted halves back together.
+ */
+static void bench_sort() {
+    srand(11);
+    linked_list *list = linked_list_alloc();
+    linked_list *other = linked_list_alloc();
+    for (int i = 0; i < SORT_LIST_SIZE; i++) {
+        linked_list_append(i % 2 == 0 ? list : other, rand());
+    }
+
+    double start = bench_now();
+    linked_list_sort(list);
+    linked_list_sort(other);
+    bench_report("linked_list_sort", SORT_LIST_SIZE, bench_now() - start);
+
+    start = bench_now();
+    linked_list_merge_sorted(list, other);
+    bench_report("linked_list_merge_sorted", SORT_LIST_SIZE, bench_now() - start);
+    bench_sink += linked_list_first(list);
+
+    linked_list_delete(&other);
+    linked_list_delete(&list);
+}
+
+/**
+ * Moves the second half of a list to another list and back,
+ * element by element and with linked_list_split_at and linked_list_concat.
+ */
+static void bench_split_concat() {
+    linked_list *list = linked_list_alloc();
+    for (int i = 0; i < SPLIT_LIST_SIZE; i++) {
+        linked_list_append(list, i);
+    }
+
+    linked_list *other = linked_list_alloc();
+    double start = bench_now();
+    for (int round = 0; round < SPLIT_ROUNDS; round++) {
+        for (int i = 0; i < SPLIT_LIST_SIZE / 2; i++) {
+            linked_list_prepend(other, linked_list_remove_last(list));
+        }
+        while (other->length > 0) {
+            linked_list_append(list, linked_list_remove_first(other));
+        }
+    }
+    bench_report("split/join (remove + append)", SPLIT_ROUNDS, bench_now() - start);
+    linked_list_delete(&other);
+
+    start = bench_now();
+    for (int round = 0; round < SPLIT_ROUNDS; round++) {
+        linked_list *rest = linked_list_split_at(list, SPLIT_LIST_SIZE / 2);
+        linked_list_concat(list, rest);
+        linked_list_delete(&rest);
+    }
+    bench_report("split/join (split_at + concat)", SPLIT_ROUNDS, bench_now() - start);
+    bench_sink += linked_list_last(list);
+
+    linked_list_delete(&list);
+}
+
+/**
+ * Prints a large list to /dev/null one printf per node, the way linked_list_print used to,
+ * and with the buffered linked_list_fprint.
+ */
+static void bench_print() {
+    FILE *null_file = fopen("/dev/null", "w");
+    if (null_file == NULL) {
+        return;
+    }
+
+    int *values = malloc(PRINT_LIST_SIZE * sizeof(int));
+    for (int i = 0; i < PRINT_LIST_SIZE; i++) {
+        values[i] = rand();
+    }
+    linked_list *list = linked_list_new(values, PRINT_LIST_SIZE);
+    free(values);
+
+    double start = bench_now();
+    for (list_node *current = list->head; current != NULL; current = current->next) {
+        fprintf(null_file, "%d -> ", current->data);
+    }
+    fprintf(null_file, "NULL\n");
+    fflush(null_file);
+    bench_report("print (fprintf per node)", PRINT_LIST_SIZE, bench_now() - start);
+
+    start = bench_now();
+    linked_list_fprint(list, null_file, true);
+    bench_report("linked_list_fprint", PRINT_LIST_SIZE, bench_now() - start);
+
+    linked_list_delete(&list);
+    fclose(null_file);
+}
+
+/* Container suite */
+
+static void *list_create(void) {
+    return linked_list_alloc();
+}
+
+static void list_destroy(void *container) {
+    linked_list *list = container;
+    linked_list_delete(&list);
+}
+
+static void list_push(void *container, int value) {
+    linked_list_append(container, value);
+}
+
+static int list_pop(void *container) {
+    return linked_list_remove_last(container);
+}
+
+static long list_sum(void *container) {
+    long sum = 0;
+    for (list_node *current = ((linked_list *)container)->head; current != NULL; current = current->next) {
+        sum += current->data;
+    }
+    return sum;
+}
+
+static int list_element(void *container, size_t index) {
+    return linked_list_element(container, (int)index);
+}
+
+static void list_insert(void *container, size_t index, int value) {
+    linked_list_insert(container, value, (int)index);
+}
+
+static int list_remove(void *container, size_t index) {
+    return linked_list_remove(container, (int)index);
+}
+
+const bench_container linked_list_bench_container = {
+    "linked_list", true, list_create, list_destroy, list_push, list_pop,
+    list_sum, list_element, list_insert, list_remove
+};
+
+void run_linked_list_benchmarks() {
+    bench_suite("linked_list");
+    bench_churn_malloc();
+    bench_churn_pool();
+    bench_random_positional(false);
+    bench_random_positional(true);
+    bench_sequential_indexed();
+    bench_sequential_cursor();
+    bench_compact();
+    bench_search();
+    bench_sort();
+    bench_split_concat();
+    bench_print();
+    printf("\n");
+}
@@ -0,0 +1,15 @@
+//
+// Created by Christopher Szatmary on 2018-12-16.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_LINKED_LIST_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_LINKED_LIST_BENCH_H
+
+#include "container_bench.h"
+
+// Lives here because linked_list.h and list_stack.h can't be included together
+extern const bench_container linked_list_bench_container;
+
+void run_linked_list_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_LINKED_LIST_BENCH_H
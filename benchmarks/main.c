@@ -0,0 +1,36 @@
+#include <stdlib.h>
+#include "benchmark.h"
+#include "container_bench.h"
+#include "linked_list_bench.h"
+#include "arena_bench.h"
+#include "unrolled_list_bench.h"
+#include "snapshot_bench.h"
+#include "int_reader_bench.h"
+#include "concurrent_stack_bench.h"
+#include "task_pool_bench.h"
+#include "concurrent_list_bench.h"
+#include "rcu_list_bench.h"
+#include "mpmc_queue_bench.h"
+#include "growth_policy_bench.h"
+
+int main(int argc, char **argv) {
+    if (bench_parse_args(argc, argv) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    run_container_benchmarks();
+    run_linked_list_benchmarks();
+    run_arena_benchmarks();
+    run_unrolled_list_benchmarks();
+    run_snapshot_benchmarks();
+    run_int_reader_benchmarks();
+    run_concurrent_stack_benchmarks();
+    run_task_pool_benchmarks();
+    run_concurrent_list_benchmarks();
+    run_rcu_list_benchmarks();
+    run_mpmc_queue_benchmarks();
+    run_growth_policy_benchmarks();
+    bench_finish();
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+//
+// Created by Christopher Szatmary on 2018-12-30.
+//
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "benchmark.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "../data_structures/queue/mpmc_queue.h"
+#include "mpmc_queue_bench.h"
+
+#define QUEUE_OPS 1000000
+#define QUEUE_CAPACITY 1024
+#define BATCH_SIZE 64
+#define ROUND_TRIPS 100000
+#define MAX_PAIRS 4
+
+/**
+ * A bounded queue made of a linked list behind one mutex, with condition variables
+ * to sleep on while it is full or empty.
+ */
+typedef struct {
+    linked_list *list;
+    pthread_mutex_t lock;
+    pthread_cond_t not_full;
+    pthread_cond_t not_empty;
+} locked_queue;
+
+typedef struct {
+    void *queue;
+    int kind;
+    size_t ops;
+    long sum;
+} queue_worker;
+
+enum { LOCKED, MPMC, MPMC_BATCH };
+
+static void locked_push(locked_queue *queue, int value) {
+    pthread_mutex_lock(&queue->lock);
+    while (queue->list->length >= QUEUE_CAPACITY) {
+        pthread_cond_wait(&queue->not_full, &queue->lock);
+    }
+    linked_list_append(queue->list, value);
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static int locked_pop(locked_queue *queue) {
+    pthread_mutex_lock(&queue->lock);
+    while (queue->list->length == 0) {
+        pthread_cond_wait(&queue->not_empty, &queue->lock);
+    }
+    int value = linked_list_remove_first(queue->list);
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+    return value;
+}
+
+static void *produce(void *context) {
+    queue_worker *worker = context;
+
+    if (worker->kind == LOCKED) {
+        for (size_t i = 0; i < worker->ops; i++) {
+            locked_push(worker->queue, (int)i);
+        }
+    } else if (worker->kind == MPMC) {
+        for (size_t i = 0; i < worker->ops; i++) {
+            mpmc_queue_push(worker->queue, (int)i);
+        }
+    } else {
+        int batch[BATCH_SIZE];
+        for (size_t i = 0; i < worker->ops; i += BATCH_SIZE) {
+            size_t count = worker->ops - i < BATCH_SIZE ? worker->ops - i : BATCH_SIZE;
+            for (size_t j = 0; j < count; j++) {
+                batch[j] = (int)(i + j);
+            }
+
+            // Push what fits at once, block on single pushes only when the queue is full
+            size_t pushed = mpmc_queue_try_push_all(worker->queue, batch, count);
+            while (pushed < count) {
+                mpmc_queue_push(worker->queue, batch[pushed++]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void *consume(void *context) {
+    queue_worker *worker = context;
+    long sum = 0;
+
+    if (worker->kind == LOCKED) {
+        for (size_t i = 0; i < worker->ops; i++) {
+            sum += locked_pop(worker->queue);
+        }
+    } else if (worker->kind == MPMC) {
+        for (size_t i = 0; i < worker->ops; i++) {
+            sum += mpmc_queue_pop(worker->queue);
+        }
+    } else {
+        int batch[BATCH_SIZE];
+        size_t popped = 0;
+        while (popped < worker->ops) {
+            size_t want = worker->ops - popped < BATCH_SIZE ? worker->ops - popped : BATCH_SIZE;
+            size_t count = mpmc_queue_try_pop_all(worker->queue, batch, want);
+
+            // Sleep for a single value when nothing is ready
+            if (count == 0) {
+                batch[0] = mpmc_queue_pop(worker->queue);
+                count = 1;
+            }
+            for (size_t j = 0; j < count; j++) {
+                sum += batch[j];
+            }
+            popped += count;
+        }
+    }
+
+    worker->sum = sum;
+    return NULL;
+}
+
+/**
+ * Moves QUEUE_OPS values through a queue from producers to as many consumers and times it.
+ * @param name The name of the queue.
+ * @param queue A pointer to the queue, a locked_queue if kind is LOCKED.
+ * @param kind How the queue is used.
+ * @param pairs The number of producers, and of consumers.
+ */
+static void run_pairs(const char *name, void *queue, int kind, int pairs) {
+    pthread_t producers[MAX_PAIRS];
+    pthread_t consumers[MAX_PAIRS];
+    queue_worker workers[2 * MAX_PAIRS];
+    size_t ops = QUEUE_OPS / pairs;
+
+    double start = bench_now();
+    for (int i = 0; i < pairs; i++) {
+        workers[i] = (queue_worker){ queue, kind, ops, 0 };
+        workers[MAX_PAIRS + i] = (queue_worker){ queue, kind, ops, 0 };
+        pthread_create(&consumers[i], NULL, consume, &workers[MAX_PAIRS + i]);
+        pthread_create(&producers[i], NULL, produce, &workers[i]);
+    }
+    for (int i = 0; i < pairs; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        bench_sink += workers[MAX_PAIRS + i].sum;
+    }
+    double elapsed = bench_now() - start;
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s x%d/%d", name, pairs, pairs);
+    bench_report(label, ops * pairs, elapsed);
+}
+
+/**
+ * Compares a mutex and condition variable queue with the MPMC queue, one value and
+ * BATCH_SIZE values at a time, as the number of producer and consumer pairs grows.
+ */
+static void bench_throughput() {
+    for (int pairs = 1; pairs <= MAX_PAIRS; pairs *= 2) {
+        locked_queue locked = { linked_list_alloc(), PTHREAD_MUTEX_INITIALIZER,
+                                PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+        run_pairs("linked_list + mutex", &locked, LOCKED, pairs);
+        linked_list_delete(&locked.list);
+        pthread_mutex_destroy(&locked.lock);
+        pthread_cond_destroy(&locked.not_full);
+        pthread_cond_destroy(&locked.not_empty);
+
+        mpmc_queue *queue = mpmc_queue_new(QUEUE_CAPACITY);
+        run_pairs("mpmc_queue", queue, MPMC, pairs);
+        run_pairs("mpmc_queue batch 64", queue, MPMC_BATCH, pairs);
+        mpmc_queue_delete(&queue);
+    }
+}
+
+typedef struct {
+    mpmc_queue *requests;
+    mpmc_queue *replies;
+} ping_pong;
+
+static void *pong(void *context) {
+    ping_pong *queues = context;
+
+    for (int i = 0; i < ROUND_TRIPS; i++) {
+        mpmc_queue_push(queues->replies, mpmc_queue_pop(queues->requests) + 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * Bounces a value between two threads through a pair of queues, each round trip
+ * costs two hand offs including any sleep and wake up on the way.
+ */
+static void bench_latency() {
+    ping_pong queues = { mpmc_queue_new(QUEUE_CAPACITY), mpmc_queue_new(QUEUE_CAPACITY) };
+    pthread_t thread;
+    int value = 0;
+
+    double start = bench_now();
+    pthread_create(&thread, NULL, pong, &queues);
+    for (int i = 0; i < ROUND_TRIPS; i++) {
+        mpmc_queue_push(queues.requests, value);
+        value = mpmc_queue_pop(queues.replies);
+    }
+    pthread_join(thread, NULL);
+    double elapsed = bench_now() - start;
+
+    bench_sink += value;
+    bench_report("mpmc_queue round trip", ROUND_TRIPS, elapsed);
+    printf("%-40s %12.0f ns\n", "mpmc_queue round trip latency", elapsed / ROUND_TRIPS * 1000000000.0);
+
+    mpmc_queue_delete(&queues.requests);
+    mpmc_queue_delete(&queues.replies);
+}
+
+void run_mpmc_queue_benchmarks() {
+    bench_suite("mpmc queue");
+    bench_throughput();
+    bench_latency();
+    printf("\n");
+}
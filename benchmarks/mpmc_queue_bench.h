@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-30.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_MPMC_QUEUE_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_MPMC_QUEUE_BENCH_H
+
+void run_mpmc_queue_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_MPMC_QUEUE_BENCH_H
@@ -0,0 +1,161 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "benchmark.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "../data_structures/rcu_list/rcu_list.h"
+#include "rcu_list_bench.h"
+
+#define LIST_LENGTH 1000
+#define TRAVERSALS 40000
+#define MAX_READERS 8
+
+// Pause between two writes, so writes stay rare next to reads
+#define WRITE_INTERVAL_NS 50000
+
+typedef struct {
+    linked_list *list;
+    pthread_mutex_t lock;
+} locked_list;
+
+typedef struct {
+    void *list;
+    bool rcu;
+    size_t traversals;
+    long sum;
+} list_reader;
+
+typedef struct {
+    void *list;
+    bool rcu;
+    _Atomic bool done;
+    size_t writes;
+} list_writer;
+
+/**
+ * Sums the whole list over and over, inside a read section or holding the mutex.
+ */
+static void *read_work(void *context) {
+    list_reader *reader = context;
+    long sum = 0;
+
+    if (reader->rcu) {
+        rcu_list *list = reader->list;
+        epoch_reader *own = rcu_list_reader_register(list);
+
+        for (size_t i = 0; i < reader->traversals; i++) {
+            rcu_list_read_lock(list, own);
+            for (rcu_list_node *node = rcu_list_head(list); node != NULL; node = rcu_list_next(node)) {
+                sum += node->data;
+            }
+            rcu_list_read_unlock(own);
+        }
+
+        rcu_list_reader_unregister(own);
+    } else {
+        locked_list *locked = reader->list;
+
+        for (size_t i = 0; i < reader->traversals; i++) {
+            pthread_mutex_lock(&locked->lock);
+            for (list_node *node = locked->list->head; node != NULL; node = node->next) {
+                sum += node->data;
+            }
+            pthread_mutex_unlock(&locked->lock);
+        }
+    }
+
+    reader->sum = sum;
+    return NULL;
+}
+
+/**
+ * Replaces an element every WRITE_INTERVAL_NS until the readers are done.
+ */
+static void *write_work(void *context) {
+    list_writer *writer = context;
+    struct timespec pause = { 0, WRITE_INTERVAL_NS };
+
+    while (!atomic_load(&writer->done)) {
+        int index = (int)(writer->writes % LIST_LENGTH);
+
+        if (writer->rcu) {
+            rcu_list_set(writer->list, index, (int)writer->writes);
+        } else {
+            locked_list *locked = writer->list;
+            pthread_mutex_lock(&locked->lock);
+            linked_list_node(locked->list, index)->data = (int)writer->writes;
+            pthread_mutex_unlock(&locked->lock);
+        }
+
+        writer->writes++;
+        nanosleep(&pause, NULL);
+    }
+
+    return NULL;
+}
+
+/**
+ * Splits TRAVERSALS full traversals between readers while one writer keeps updating the list.
+ * @param name The name of the list.
+ * @param list A pointer to the list, a locked_list unless rcu is set.
+ * @param rcu Whether the list is an RCU list.
+ * @param reader_count The number of reader threads.
+ */
+static void run_readers(const char *name, void *list, bool rcu, int reader_count) {
+    pthread_t readers[MAX_READERS];
+    list_reader work[MAX_READERS];
+    pthread_t writer_thread;
+    list_writer writer = { list, rcu, false, 0 };
+
+    pthread_create(&writer_thread, NULL, write_work, &writer);
+
+    double start = bench_now();
+    for (int i = 0; i < reader_count; i++) {
+        work[i] = (list_reader){ list, rcu, TRAVERSALS / reader_count, 0 };
+        pthread_create(&readers[i], NULL, read_work, &work[i]);
+    }
+    for (int i = 0; i < reader_count; i++) {
+        pthread_join(readers[i], NULL);
+        bench_sink += work[i].sum;
+    }
+    double elapsed = bench_now() - start;
+
+    atomic_store(&writer.done, true);
+    pthread_join(writer_thread, NULL);
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s traversals x%d", name, reader_count);
+    bench_report(label, (TRAVERSALS / reader_count) * reader_count, elapsed);
+}
+
+/**
+ * Compares full traversals of a linked list behind a mutex with an RCU list
+ * as the number of readers grows, with one writer making occasional updates.
+ */
+static void bench_read_mostly() {
+    int values[LIST_LENGTH];
+    for (int i = 0; i < LIST_LENGTH; i++) {
+        values[i] = i;
+    }
+
+    for (int readers = 1; readers <= MAX_READERS; readers *= 2) {
+        locked_list locked = { linked_list_new(values, LIST_LENGTH), PTHREAD_MUTEX_INITIALIZER };
+        run_readers("linked_list + mutex", &locked, false, readers);
+        linked_list_delete(&locked.list);
+        pthread_mutex_destroy(&locked.lock);
+
+        rcu_list *list = rcu_list_new(values, LIST_LENGTH);
+        run_readers("rcu_list", list, true, readers);
+        rcu_list_delete(&list);
+    }
+}
+
+void run_rcu_list_benchmarks() {
+    bench_suite("rcu list");
+    bench_read_mostly();
+    printf("\n");
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_RCU_LIST_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_RCU_LIST_BENCH_H
+
+void run_rcu_list_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_RCU_LIST_BENCH_H
@@ -0,0 +1,69 @@
+//
+// Created by Christopher Szatmary on 2018-12-23.
+//
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "benchmark.h"
+#include "../data_structures/stack/array_stack.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "snapshot_bench.h"
+
+#define SNAPSHOT_LENGTH 16000000
+#define SNAPSHOT_PATH "/tmp/dsa_bench_snapshot"
+
+/**
+ * Restores containers of SNAPSHOT_LENGTH elements from a snapshot file,
+ * compared to rebuilding them from an array already in memory.
+ */
+static void bench_restore() {
+    int *values = malloc(SNAPSHOT_LENGTH * sizeof(int));
+    for (int i = 0; i < SNAPSHOT_LENGTH; i++) {
+        values[i] = rand();
+    }
+
+    array_stack *stack = array_stack_new(values, SNAPSHOT_LENGTH);
+    double start = bench_now();
+    array_stack_save(stack, SNAPSHOT_PATH);
+    bench_report("array_stack_save", SNAPSHOT_LENGTH, bench_now() - start);
+    array_stack_delete(&stack);
+
+    start = bench_now();
+    stack = array_stack_new(values, SNAPSHOT_LENGTH);
+    bench_report("array_stack_new (from memory)", SNAPSHOT_LENGTH, bench_now() - start);
+    array_stack_delete(&stack);
+
+    stack = array_stack_alloc();
+    start = bench_now();
+    array_stack_load(stack, SNAPSHOT_PATH, false);
+    bench_report("array_stack_load (mapped)", SNAPSHOT_LENGTH, bench_now() - start);
+    bench_sink += array_stack_peak(stack);
+    array_stack_delete(&stack);
+
+    stack = array_stack_alloc();
+    start = bench_now();
+    array_stack_load(stack, SNAPSHOT_PATH, true);
+    bench_report("array_stack_load (mapped, verified)", SNAPSHOT_LENGTH, bench_now() - start);
+    array_stack_delete(&stack);
+
+    start = bench_now();
+    linked_list *list = linked_list_new(values, SNAPSHOT_LENGTH);
+    bench_report("linked_list_new (from memory)", SNAPSHOT_LENGTH, bench_now() - start);
+    linked_list_delete(&list);
+
+    list = linked_list_alloc();
+    start = bench_now();
+    linked_list_load(list, SNAPSHOT_PATH);
+    bench_report("linked_list_load", SNAPSHOT_LENGTH, bench_now() - start);
+    bench_sink += linked_list_last(list);
+    linked_list_delete(&list);
+
+    free(values);
+    unlink(SNAPSHOT_PATH);
+}
+
+void run_snapshot_benchmarks() {
+    bench_suite("snapshot");
+    bench_restore();
+    printf("\n");
+}
@@ -0,0 +1,91 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#include <stdlib.h>
+#include "benchmark.h"
+#include "../utils/task_pool.h"
+#include "../data_structures/stack/array_stack.h"
+#include "task_pool_bench.h"
+
+#define SUM_LENGTH 64000000
+#define SUM_CUTOFF 16384
+#define MAX_WORKERS 16
+
+typedef struct {
+    const int *values;
+    size_t length;
+    long sum;
+} sum_range;
+
+static long serial_sum(const int *values, size_t length) {
+    long sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+/**
+ * Sums a range of values, splitting it in half into tasks until it is SUM_CUTOFF long.
+ */
+static void parallel_sum(task_pool *pool, void *argument) {
+    sum_range *range = argument;
+
+    if (range->length <= SUM_CUTOFF) {
+        range->sum = serial_sum(range->values, range->length);
+        return;
+    }
+
+    size_t half = range->length / 2;
+    sum_range left = { range->values, half, 0 };
+    sum_range right = { range->values + half, range->length - half, 0 };
+
+    task left_task;
+    task_pool_spawn(pool, &left_task, parallel_sum, &left);
+    parallel_sum(pool, &right);
+    task_pool_wait(pool, &left_task);
+
+    range->sum = left.sum + right.sum;
+}
+
+/**
+ * Sums the data of an array stack of SUM_LENGTH elements
+ * on task pools of a growing number of workers.
+ */
+static void bench_parallel_sum() {
+    array_stack *stack = array_stack_alloc();
+    array_stack_reserve_capacity(stack, SUM_LENGTH);
+    for (int i = 0; i < SUM_LENGTH; i++) {
+        array_stack_push(stack, rand() % 1000);
+    }
+
+    double start = bench_now();
+    bench_sink += serial_sum(stack->data, stack->length);
+    bench_report("serial sum", SUM_LENGTH, bench_now() - start);
+
+    for (size_t workers = 1; workers <= MAX_WORKERS; workers *= 2) {
+        task_pool pool;
+        task_pool_init(&pool, workers);
+
+        sum_range range = { stack->data, stack->length, 0 };
+        start = bench_now();
+        task_pool_run(&pool, parallel_sum, &range);
+        double elapsed = bench_now() - start;
+        bench_sink += range.sum;
+
+        char label[64];
+        snprintf(label, sizeof(label), "task_pool parallel sum x%zu", workers);
+        bench_report(label, SUM_LENGTH, elapsed);
+
+        task_pool_release(&pool);
+    }
+
+    array_stack_delete(&stack);
+}
+
+void run_task_pool_benchmarks() {
+    bench_suite("task pool");
+    bench_parallel_sum();
+    printf("\n");
+}
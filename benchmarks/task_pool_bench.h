@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_TASK_POOL_BENCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_TASK_POOL_BENCH_H
+
+void run_task_pool_benchmarks();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_TASK_POOL_BENCH_H
@@ -0,0 +1,86 @@
+//
+// Created by Christopher Szatmary on 2018-12-18.
+//
+
+#include <stdlib.h>
+#include "benchmark.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "../data_structures/unrolled_list/unrolled_list.h"
+#include "unrolled_list_bench.h"
+
+#define SCAN_LENGTH 4000000
+#define SCAN_ROUNDS 10
+
+/**
+ * Sums every element of a linked list, one pointer chase per element.
+ */
+static void bench_scan_linked_list(int *values) {
+    linked_list *list = linked_list_new(values, SCAN_LENGTH);
+
+    double start = bench_now();
+    for (int round = 0; round < SCAN_ROUNDS; round++) {
+        long sum = 0;
+        for (list_node *current = list->head; current != NULL; current = current->next) {
+            sum += current->data;
+        }
+        bench_sink += sum;
+    }
+    double elapsed = bench_now() - start;
+
+    linked_list_delete(&list);
+    bench_report("scan linked_list", (size_t)SCAN_LENGTH * SCAN_ROUNDS, elapsed);
+}
+
+/**
+ * Sums every element of an unrolled list, one pointer chase per node.
+ */
+static void bench_scan_unrolled_list(int *values) {
+    unrolled_list *list = unrolled_list_new(values, SCAN_LENGTH);
+
+    double start = bench_now();
+    for (int round = 0; round < SCAN_ROUNDS; round++) {
+        long sum = 0;
+        for (unrolled_node *current = list->head; current != NULL; current = current->next) {
+            for (size_t i = 0; i < current->count; i++) {
+                sum += current->data[i];
+            }
+        }
+        bench_sink += sum;
+    }
+    double elapsed = bench_now() - start;
+
+    unrolled_list_delete(&list);
+    bench_report("scan unrolled_list", (size_t)SCAN_LENGTH * SCAN_ROUNDS, elapsed);
+}
+
+/**
+ * Sums every element of a plain array, the upper bound for a scan.
+ */
+static void bench_scan_array(int *values) {
+    double start = bench_now();
+    for (int round = 0; round < SCAN_ROUNDS; round++) {
+        long sum = 0;
+        for (size_t i = 0; i < SCAN_LENGTH; i++) {
+            sum += values[i];
+        }
+        bench_sink += sum;
+    }
+    double elapsed = bench_now() - start;
+
+    bench_report("scan array", (size_t)SCAN_LENGTH * SCAN_ROUNDS, elapsed);
+}
+
+void run_unrolled_list_benchmarks() {
+    int *values = malloc(SCAN_LENGTH * sizeof(int));
+    for (int i = 0; i < SCAN_LENGTH; i++) {
+        values[i] = i;
+    }
+
+    bench_suite("unrolled_list");
+    bench_scan_linked_list(values);
+    bench_scan_unrolled_list(values);
+    bench_scan_array(values);
+    printf("\n");
+
+    free(values);
+}
@@ -0,0 +1,472 @@
+//
+// Created by Christopher Szatmary on 2018-12-21.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include "compact_list.h"
+#include "../../utils/error.h"
+
+#define NIL COMPACT_LIST_NIL
+
+/* Helpers */
+
+/**
+ * Re-sizes the node array of a compact list to the desired capacity.
+ * @param list A pointer to the compact list.
+ * @param capacity The new number of node slots.
+ * @return An integer indicating the status.
+ */
+static int resize_nodes(compact_list *list, size_t capacity) {
+    // Every slot must be addressable by a 32 bit index other than NIL
+    if (capacity > NIL) {
+        return ENOMEM;
+    }
+
+    compact_node *new_nodes = allocator_realloc(list->allocator, list->nodes,
+                                                list->capacity * sizeof(compact_node),
+                                                capacity * sizeof(compact_node));
+
+    if (new_nodes == NULL) {
+        return ENOMEM;
+    }
+
+    list->nodes = new_nodes;
+    list->capacity = capacity;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Takes a free slot and initializes a node in it.
+ * Slots of removed nodes are reused first, otherwise the array is doubled when full.
+ * @param list A pointer to the compact list.
+ * @param value The data value the node should have.
+ * @param next The index of the next node.
+ * @param previous The index of the previous node.
+ * @return The index of the newly created node, or NIL if the allocation failed.
+ */
+static uint32_t node_new(compact_list *list, int value, uint32_t next, uint32_t previous) {
+    uint32_t index;
+
+    if (list->free_list != NIL) {
+        index = list->free_list;
+        list->free_list = list->nodes[index].next;
+    } else {
+        if (list->used == list->capacity) {
+            size_t capacity = list->capacity == 0 ? 2 : list->capacity * 2;
+            if (resize_nodes(list, capacity) != EXIT_SUCCESS) {
+                return NIL;
+            }
+        }
+
+        index = (uint32_t)list->used++;
+    }
+
+    compact_node *node = &list->nodes[index];
+    node->data = value;
+    node->next = next;
+    node->previous = previous;
+
+    return index;
+}
+
+/**
+ * Returns the slot of a node to the free list.
+ * @param list A pointer to the compact list.
+ * @param index The index of the node.
+ */
+static void node_free(compact_list *list, uint32_t index) {
+    list->nodes[index].next = list->free_list;
+    list->free_list = index;
+}
+
+/**
+ * Gets the index of the node at the given position in a compact list.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the compact list.
+ * @param index The position of the node to access.
+ * @return The index of the node in the node array.
+ */
+static uint32_t compact_list_node(compact_list *list, int index) {
+    int list_length = (int)list->length;
+    int max_index = list_length - 1;
+    int min_index = list_length * -1;
+
+    // Ensure that a valid index was given.
+    if (index < min_index || index > max_index) {
+        fatal_error_print(INVALID_INDEX, "Index out of range\n");
+    }
+
+    int real_index = index < 0 ? list_length + index : index;
+
+    uint32_t current;
+    if (real_index <= max_index / 2) {
+        current = list->head;
+        for (int i = 0; i < real_index; i++) {
+            current = list->nodes[current].next;
+        }
+    } else {
+        current = list->tail;
+        for (int i = max_index; i > real_index; i--) {
+            current = list->nodes[current].previous;
+        }
+    }
+
+    return current;
+}
+
+/**
+ * Unlinks a node from a compact list and frees its slot.
+ * @param list A pointer to the compact list.
+ * @param index The index of the node to remove.
+ * @return The data of the removed node.
+ */
+static int node_remove(compact_list *list, uint32_t index) {
+    compact_node *node = &list->nodes[index];
+
+    if (node->previous == NIL) {
+        list->head = node->next;
+    } else {
+        list->nodes[node->previous].next = node->next;
+    }
+
+    if (node->next == NIL) {
+        list->tail = node->previous;
+    } else {
+        list->nodes[node->next].previous = node->previous;
+    }
+
+    int data = node->data;
+    node_free(list, index);
+    list->length--;
+
+    return data;
+}
+
+/* Construction */
+
+/**
+ * Allocates a compact list.
+ * @return A pointer to the allocated compact list.
+ */
+compact_list *compact_list_alloc() {
+    return compact_list_alloc_with(NULL);
+}
+
+/**
+ * Allocates a compact list whose memory comes from the given allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated compact list.
+ */
+compact_list *compact_list_alloc_with(const allocator *allocator) {
+    compact_list *list = allocator_alloc(allocator, sizeof(compact_list));
+
+    // Ensure the allocation succeeded, then set the default values
+    if (list != NULL) {
+        list->nodes = NULL;
+        list->head = NIL;
+        list->tail = NIL;
+        list->free_list = NIL;
+        list->length = 0;
+        list->used = 0;
+        list->capacity = 0;
+        list->allocator = allocator;
+    }
+
+    return list;
+}
+
+/**
+ * Initializes a compact list using an array.
+ * The nodes fill the start of the node array in list order.
+ * @param list A pointer to the list to initialize.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return An integer indicating the status.
+ */
+int compact_list_init(compact_list *list, int *values, size_t length) {
+    // Just return if no elements in the array
+    if (length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // Abort if the list isn't empty
+    if (list->head != NIL) {
+        return LIST_NOT_EMPTY;
+    }
+
+    // Start from an empty node array so the nodes are stored in order
+    list->used = 0;
+    list->free_list = NIL;
+    if (list->capacity < length && resize_nodes(list, length) != EXIT_SUCCESS) {
+        return ENOMEM;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        compact_node *node = &list->nodes[i];
+        node->data = values[i];
+        node->previous = i == 0 ? NIL : (uint32_t)(i - 1);
+        node->next = i == length - 1 ? NIL : (uint32_t)(i + 1);
+    }
+
+    list->head = 0;
+    list->tail = (uint32_t)(length - 1);
+    list->used = length;
+    list->length = length;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Allocates and initializes a compact list using an array.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return A pointer to the newly created compact list.
+ */
+compact_list *compact_list_new(int *values, size_t length) {
+    compact_list *list = compact_list_alloc();
+    compact_list_init(list, values, length);
+    return list;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes a compact list and deallocates its node array.
+ * @param list The compact list to deinitialize.
+ */
+void compact_list_deinit(compact_list *list) {
+    allocator_free(list->allocator, list->nodes, list->capacity * sizeof(compact_node));
+    list->nodes = NULL;
+    list->head = NIL;
+    list->tail = NIL;
+    list->free_list = NIL;
+    list->length = 0;
+    list->used = 0;
+    list->capacity = 0;
+}
+
+/**
+ * Deallocates the given compact list pointer.
+ * @param list A pointer to a compact list pointer.
+ */
+void compact_list_dealloc(compact_list **list) {
+    allocator_free((*list)->allocator, *list, sizeof(compact_list));
+    *list = NULL;
+}
+
+/**
+ * Deinitializes a compact list and then deallocates it.
+ * @param list A pointer to a compact list pointer.
+ */
+void compact_list_delete(compact_list **list) {
+    compact_list_deinit(*list);
+    compact_list_dealloc(list);
+}
+
+/* Accessing */
+
+/**
+ * Retrieves the first element in the compact list.
+ * @param list A pointer to the compact list.
+ * @return The first element in the list.
+ */
+int compact_list_first(compact_list *list) {
+    if (list->head == NIL) {
+        fatal_error_print(LIST_EMPTY, "Can't get first element from empty list");
+    }
+
+    return list->nodes[list->head].data;
+}
+
+/**
+ * Retrieves the last element in the compact list.
+ * @param list A pointer to the compact list.
+ * @return The last element in the list.
+ */
+int compact_list_last(compact_list *list) {
+    if (list->tail == NIL) {
+        fatal_error_print(LIST_EMPTY, "Can't get last element from empty list");
+    }
+
+    return list->nodes[list->tail].data;
+}
+
+/**
+ * Retrieves the element at the given index in the compact list.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the compact list.
+ * @param index The index of the element to retrieve.
+ * @return The element at the given index.
+ */
+int compact_list_element(compact_list *list, int index) {
+    return list->nodes[compact_list_node(list, index)].data;
+}
+
+/**
+ * Prints a compact list in order.
+ * @param list A pointer to the compact list.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ */
+void compact_list_print(compact_list *list, bool new_line) {
+    for (uint32_t current = list->head; current != NIL; current = list->nodes[current].next) {
+        printf("%d -> ", list->nodes[current].data);
+    }
+
+    printf("NULL");
+
+    if (new_line) {
+        printf("\n");
+    }
+}
+
+/**
+ * Prints a compact list in reverse order.
+ * @param list A pointer to the compact list.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ */
+void compact_list_print_rev(compact_list *list, bool new_line) {
+    for (uint32_t current = list->tail; current != NIL; current = list->nodes[current].previous) {
+        printf("%d <- ", list->nodes[current].data);
+    }
+
+    printf("NULL");
+
+    if (new_line) {
+        printf("\n");
+    }
+}
+
+/* Mutation */
+
+/**
+ * Ensures the compact list has the correct length stored.
+ * If the length stored is incorrect it will be corrected.
+ * @param list A pointer to the compact list.
+ * @return An integer indicating whether or not there was an difference found.
+ */
+int compact_list_ensure_len(compact_list *list) {
+    size_t count = 0;
+    for (uint32_t current = list->head; current != NIL; current = list->nodes[current].next) {
+        count++;
+    }
+
+    if (count != list->length) {
+        list->length = count;
+        return LENGTHS_DIFFERENT;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Adds a value to the end of a compact list.
+ * @param list A pointer to the compact list.
+ * @param value The value to add to the list.
+ */
+void compact_list_append(compact_list *list, int value) {
+    uint32_t new_node = node_new(list, value, NIL, list->tail);
+
+    if (new_node == NIL) {
+        fatal_error_print(ENOMEM, "Can't grow the node array of a compact list\n");
+    }
+
+    if (list->tail == NIL) {
+        list->head = new_node;
+    } else {
+        list->nodes[list->tail].next = new_node;
+    }
+
+    list->tail = new_node;
+    list->length++;
+}
+
+/**
+ * Adds a value to the beginning of a compact list.
+ * @param list A pointer to the compact list.
+ * @param value The value to add to the list.
+ */
+void compact_list_prepend(compact_list *list, int value) {
+    uint32_t new_node = node_new(list, value, list->head, NIL);
+
+    if (new_node == NIL) {
+        fatal_error_print(ENOMEM, "Can't grow the node array of a compact list\n");
+    }
+
+    if (list->head == NIL) {
+        list->tail = new_node;
+    } else {
+        list->nodes[list->head].previous = new_node;
+    }
+
+    list->head = new_node;
+    list->length++;
+}
+
+/**
+ * Inserts a value into a compact list.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the compact list.
+ * @param value The value to insert into the list.
+ * @param index The index at which to insert the value.
+ */
+void compact_list_insert(compact_list *list, int value, int index) {
+    int list_length = (int)list->length;
+    int real_index = index < 0 ? list_length + index : index;
+
+    if (real_index == 0) {
+        compact_list_prepend(list, value);
+    } else if (real_index == list_length) {
+        compact_list_append(list, value);
+    } else {
+        uint32_t previous_node = compact_list_node(list, real_index - 1);
+        uint32_t next_node = list->nodes[previous_node].next;
+        uint32_t new_node = node_new(list, value, next_node, previous_node);
+
+        if (new_node == NIL) {
+            fatal_error_print(ENOMEM, "Can't grow the node array of a compact list\n");
+        }
+
+        list->nodes[previous_node].next = new_node;
+        list->nodes[next_node].previous = new_node;
+        list->length++;
+    }
+}
+
+/**
+ * Removes the last element in a compact list.
+ * @param list A pointer to the compact list.
+ * @return The element that was removed.
+ */
+int compact_list_remove_last(compact_list *list) {
+    if (list->tail == NIL) {
+        fatal_error_print(LIST_EMPTY, "Can't remove last element from an empty list");
+    }
+
+    return node_remove(list, list->tail);
+}
+
+/**
+ * Removes the first element in a compact list.
+ * @param list A pointer to the compact list.
+ * @return The element that was removed.
+ */
+int compact_list_remove_first(compact_list *list) {
+    if (list->head == NIL) {
+        fatal_error_print(LIST_EMPTY, "Can't remove first element from an empty list");
+    }
+
+    return node_remove(list, list->head);
+}
+
+/**
+ * Removes the element at the given index in a compact list.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the compact list.
+ * @return The element that was removed.
+ */
+int compact_list_remove(compact_list *list, int index) {
+    return node_remove(list, compact_list_node(list, index));
+}
@@ -0,0 +1,62 @@
+//
+// Created by Christopher Szatmary on 2018-12-21.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_COMPACT_LIST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_COMPACT_LIST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../utils/allocator.h"
+
+#define COMPACT_LIST_NIL UINT32_MAX
+
+/**
+ * Nodes live in one growable array and link to each other by index,
+ * so the whole list can be moved or written out without fixing up pointers.
+ */
+typedef struct {
+    int data;
+    uint32_t next;
+    uint32_t previous;
+} compact_node;
+
+typedef struct {
+    compact_node *nodes;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t free_list;
+    size_t length;
+    size_t used;
+    size_t capacity;
+    const allocator *allocator;
+} compact_list;
+
+// Construction
+compact_list *compact_list_alloc();
+compact_list *compact_list_alloc_with(const allocator *allocator);
+int compact_list_init(compact_list *list, int *values, size_t length);
+compact_list *compact_list_new(int *values, size_t length);
+
+// Deletion
+void compact_list_deinit(compact_list *list);
+void compact_list_dealloc(compact_list **list);
+void compact_list_delete(compact_list **list);
+
+// Accessing
+int compact_list_first(compact_list *list);
+int compact_list_last(compact_list *list);
+int compact_list_element(compact_list *list, int index);
+void compact_list_print(compact_list *list, bool new_line);
+void compact_list_print_rev(compact_list *list, bool new_line);
+
+// Mutation
+int compact_list_ensure_len(compact_list *list);
+void compact_list_append(compact_list *list, int value);
+void compact_list_prepend(compact_list *list, int value);
+void compact_list_insert(compact_list *list, int value, int index);
+int compact_list_remove_last(compact_list *list);
+int compact_list_remove_first(compact_list *list);
+int compact_list_remove(compact_list *list, int index);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_COMPACT_LIST_H
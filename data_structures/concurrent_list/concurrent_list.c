@@ -0,0 +1,294 @@
+//
+// Created by Christopher Szatmary on 2018-12-28.
+//
+
+#include <stdlib.h>
+#include <errno.h>
+#include "concurrent_list.h"
+#include "../../utils/error.h"
+
+/* Helpers */
+
+/**
+ * Allocates a node with its own lock.
+ * @param list A pointer to the concurrent list.
+ * @param value The value of the node.
+ * @return A pointer to the node, or NULL if it couldn't be allocated.
+ */
+static concurrent_list_node *node_alloc(concurrent_list *list, int value) {
+    concurrent_list_node *node = allocator_alloc(list->allocator, sizeof(concurrent_list_node));
+
+    if (node != NULL) {
+        node->data = value;
+        node->next = NULL;
+        pthread_mutex_init(&node->lock, NULL);
+    }
+
+    return node;
+}
+
+static void node_free(concurrent_list *list, concurrent_list_node *node) {
+    pthread_mutex_destroy(&node->lock);
+    allocator_free(list->allocator, node, sizeof(concurrent_list_node));
+}
+
+/**
+ * Walks a concurrent list hand over hand until it finds a value.
+ * @param list A pointer to the concurrent list.
+ * @param value The value to search for.
+ * @param previous Set to the node before the one found, or the last node if nothing was found.
+ * It is left locked.
+ * @return A pointer to the first node holding the value, left locked, or NULL if there is none.
+ */
+static concurrent_list_node *find_locked(concurrent_list *list, int value, concurrent_list_node **previous) {
+    concurrent_list_node *before = &list->head;
+    pthread_mutex_lock(&before->lock);
+
+    concurrent_list_node *current = before->next;
+    while (current != NULL) {
+        pthread_mutex_lock(&current->lock);
+
+        if (current->data == value) {
+            *previous = before;
+            return current;
+        }
+
+        pthread_mutex_unlock(&before->lock);
+        before = current;
+        current = current->next;
+    }
+
+    *previous = before;
+    return NULL;
+}
+
+/* Construction */
+
+/**
+ * Allocates a concurrent list.
+ * @return A pointer to the allocated concurrent list.
+ */
+concurrent_list *concurrent_list_alloc() {
+    return concurrent_list_alloc_with(NULL);
+}
+
+/**
+ * Allocates a concurrent list whose memory comes from the given allocator.
+ * Nodes are allocated and freed by whichever thread inserts or removes them,
+ * so the allocator must be thread safe.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated concurrent list.
+ */
+concurrent_list *concurrent_list_alloc_with(const allocator *allocator) {
+    concurrent_list *list = allocator_alloc(allocator, sizeof(concurrent_list));
+
+    if (list != NULL) {
+        list->head.next = NULL;
+        pthread_mutex_init(&list->head.lock, NULL);
+        atomic_init(&list->length, 0);
+        list->allocator = allocator;
+    }
+
+    return list;
+}
+
+/**
+ * Initializes a concurrent list using an array, keeping the order of the values.
+ * Must not run while other threads use the list.
+ * @param list A pointer to the list to initialize.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return An integer indicating the status.
+ */
+int concurrent_list_init(concurrent_list *list, int *values, size_t length) {
+    // Just return if no elements in the array
+    if (length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // Abort if the list isn't empty
+    if (list->head.next != NULL) {
+        return LIST_NOT_EMPTY;
+    }
+
+    concurrent_list_node *last = &list->head;
+    for (size_t i = 0; i < length; i++) {
+        concurrent_list_node *node = node_alloc(list, values[i]);
+
+        // Ensure that the node was allocated
+        if (node == NULL) {
+            return ENOMEM;
+        }
+
+        last->next = node;
+        last = node;
+        atomic_fetch_add_explicit(&list->length, 1, memory_order_relaxed);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Allocates and initializes a concurrent list using an array.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return A pointer to the newly created concurrent list.
+ */
+concurrent_list *concurrent_list_new(int *values, size_t length) {
+    concurrent_list *list = concurrent_list_alloc();
+    concurrent_list_init(list, values, length);
+    return list;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes a concurrent list and deallocates every node.
+ * Must not run while other threads use the list.
+ * @param list A pointer to the list to deinitialize.
+ */
+void concurrent_list_deinit(concurrent_list *list) {
+    concurrent_list_node *node = list->head.next;
+
+    while (node != NULL) {
+        concurrent_list_node *next = node->next;
+        node_free(list, node);
+        node = next;
+    }
+
+    list->head.next = NULL;
+    atomic_store(&list->length, 0);
+}
+
+/**
+ * Deallocates the given concurrent list pointer.
+ * @param list A pointer to a concurrent list pointer.
+ */
+void concurrent_list_dealloc(concurrent_list **list) {
+    pthread_mutex_destroy(&(*list)->head.lock);
+    allocator_free((*list)->allocator, *list, sizeof(concurrent_list));
+    *list = NULL;
+}
+
+/**
+ * Deinitializes a concurrent list and then deallocates it.
+ * @param list A pointer to a concurrent list pointer.
+ */
+void concurrent_list_delete(concurrent_list **list) {
+    concurrent_list_deinit(*list);
+    concurrent_list_dealloc(list);
+}
+
+/* Accessing */
+
+/**
+ * Returns the number of nodes in a concurrent list.
+ * While other threads insert or remove this is only a snapshot.
+ * @param list A pointer to the concurrent list.
+ * @return The number of nodes.
+ */
+size_t concurrent_list_length(concurrent_list *list) {
+    return atomic_load_explicit(&list->length, memory_order_relaxed);
+}
+
+/**
+ * Checks whether a concurrent list contains a value. Safe to call from any thread.
+ * @param list A pointer to the concurrent list.
+ * @param value The value to search for.
+ * @return true if a node holds the value.
+ */
+bool concurrent_list_contains(concurrent_list *list, int value) {
+    concurrent_list_node *previous;
+    concurrent_list_node *node = find_locked(list, value, &previous);
+
+    if (node != NULL) {
+        pthread_mutex_unlock(&node->lock);
+    }
+    pthread_mutex_unlock(&previous->lock);
+
+    return node != NULL;
+}
+
+/* Mutation */
+
+/**
+ * Inserts a value at the front of a concurrent list. Safe to call from any thread.
+ * @param list A pointer to the concurrent list.
+ * @param value The value to insert.
+ * @return An integer indicating the status.
+ */
+int concurrent_list_prepend(concurrent_list *list, int value) {
+    concurrent_list_node *node = node_alloc(list, value);
+
+    if (node == NULL) {
+        return ENOMEM;
+    }
+
+    pthread_mutex_lock(&list->head.lock);
+    node->next = list->head.next;
+    list->head.next = node;
+    pthread_mutex_unlock(&list->head.lock);
+
+    atomic_fetch_add_explicit(&list->length, 1, memory_order_relaxed);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Inserts a value after the first node holding another value. Safe to call from any thread.
+ * @param list A pointer to the concurrent list.
+ * @param after The value of the node to insert after.
+ * @param value The value to insert.
+ * @return An integer indicating the status, DOES_NOT_EXIST if no node holds after.
+ */
+int concurrent_list_insert_after(concurrent_list *list, int after, int value) {
+    // Allocate before walking so no locks are held while allocating
+    concurrent_list_node *node = node_alloc(list, value);
+
+    if (node == NULL) {
+        return ENOMEM;
+    }
+
+    concurrent_list_node *previous;
+    concurrent_list_node *found = find_locked(list, after, &previous);
+    pthread_mutex_unlock(&previous->lock);
+
+    if (found == NULL) {
+        node_free(list, node);
+        return DOES_NOT_EXIST;
+    }
+
+    node->next = found->next;
+    found->next = node;
+    pthread_mutex_unlock(&found->lock);
+
+    atomic_fetch_add_explicit(&list->length, 1, memory_order_relaxed);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Removes the first node holding a value. Safe to call from any thread.
+ * @param list A pointer to the concurrent list.
+ * @param value The value to remove.
+ * @return true if a node was removed.
+ */
+bool concurrent_list_remove(concurrent_list *list, int value) {
+    concurrent_list_node *previous;
+    concurrent_list_node *node = find_locked(list, value, &previous);
+
+    if (node == NULL) {
+        pthread_mutex_unlock(&previous->lock);
+        return false;
+    }
+
+    // Any other thread reaching the node would need the lock of previous first
+    previous->next = node->next;
+    pthread_mutex_unlock(&node->lock);
+    pthread_mutex_unlock(&previous->lock);
+
+    node_free(list, node);
+    atomic_fetch_sub_explicit(&list->length, 1, memory_order_relaxed);
+
+    return true;
+}
@@ -0,0 +1,52 @@
+//
+// Created by Christopher Szatmary on 2018-12-28.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "../../utils/allocator.h"
+
+typedef struct concurrent_list_node {
+    int data;
+    struct concurrent_list_node *next;
+    pthread_mutex_t lock;
+} concurrent_list_node;
+
+/**
+ * A singly linked list that any number of threads can search and modify at the same time.
+ * Every node has its own lock and threads walk the list hand over hand, locking the next node
+ * before letting go of the current one. A node is only unlinked while its predecessor and itself
+ * are locked, so no other thread can be on it and it can be freed right away.
+ * Threads only wait for each other where their walks overlap.
+ */
+typedef struct {
+    concurrent_list_node head;
+    _Atomic size_t length;
+    const allocator *allocator;
+} concurrent_list;
+
+// Construction
+concurrent_list *concurrent_list_alloc();
+concurrent_list *concurrent_list_alloc_with(const allocator *allocator);
+int concurrent_list_init(concurrent_list *list, int *values, size_t length);
+concurrent_list *concurrent_list_new(int *values, size_t length);
+
+// Deletion
+void concurrent_list_deinit(concurrent_list *list);
+void concurrent_list_dealloc(concurrent_list **list);
+void concurrent_list_delete(concurrent_list **list);
+
+// Accessing
+size_t concurrent_list_length(concurrent_list *list);
+bool concurrent_list_contains(concurrent_list *list, int value);
+
+// Mutation
+int concurrent_list_prepend(concurrent_list *list, int value);
+int concurrent_list_insert_after(concurrent_list *list, int after, int value);
+bool concurrent_list_remove(concurrent_list *list, int value);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_H
@@ -4,52 +4,434 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
 #include "linked_list.h"
 #include "../../utils/error.h"
+#include "../../utils/instrument.h"
+#include "../../utils/int_reader.h"
+
+// Number of independent walks a search interleaves to overlap their cache misses
+#define SEARCH_CHAINS 8
+
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
+
+typedef enum {
+    SEARCH_ANY,
+    SEARCH_FIRST,
+    SEARCH_COUNT
+} search_mode;
+
+typedef struct {
+    list_node *node;
+    size_t position;
+    size_t remaining;
+    bool forward;
+} search_chain;
 
 /* Helpers */
 
 /**
  * Allocates and initializes a new list_node.
+ * @param list A pointer to the linked list the node belongs to.
  * @param value The data value the node should have.
  * @param next A pointer to the next node.
  * @param previous A pointer to the previous node.
  * @return A pointer to the newly created node.
  */
-static list_node *node_new(int value, list_node *next, list_node *previous) {
-    list_node *node = malloc(sizeof(list_node));
+static list_node *node_new(linked_list *list, int value, list_node *next, list_node *previous) {
+    list_node *node = node_pool_take(list->pool);
 
     // Ensure the allocation succeeded, then initialize the node
     if (node != NULL) {
         node->data = value;
         node->next = next;
         node->previous = previous;
+        INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_ALLOCS, 1);
+        INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, (int64_t)sizeof(list_node));
     }
 
     return node;
 }
 
+/**
+ * Returns a node to the pool of the linked list it belongs to.
+ * @param list A pointer to the linked list.
+ * @param node A pointer to the node to release.
+ */
+static void node_free(linked_list *list, list_node *node) {
+    node_pool_give(list->pool, node);
+    INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_FREES, 1);
+    INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, -(int64_t)sizeof(list_node));
+}
+
+/**
+ * Gets the node that follows another in the order a linked list is read in.
+ * @param list A pointer to the linked list.
+ * @param node A pointer to a node in the list.
+ * @return A pointer to the following node, or NULL at the end of the list.
+ */
+static list_node *node_after(linked_list *list, list_node *node) {
+    return list->reversed ? node->previous : node->next;
+}
+
+/**
+ * Gets the node that precedes another in the order a linked list is read in.
+ * @param list A pointer to the linked list.
+ * @param node A pointer to a node in the list.
+ * @return A pointer to the preceding node, or NULL at the start of the list.
+ */
+static list_node *node_before(linked_list *list, list_node *node) {
+    return list->reversed ? node->next : node->previous;
+}
+
+/**
+ * Converts a position in the order a linked list is read in to the position of the node counted from the head.
+ * @param list A pointer to the linked list.
+ * @param position The position of a node in the list.
+ * @return The number of links between the head and the node.
+ */
+static size_t node_position(linked_list *list, size_t position) {
+    return list->reversed ? list->length - 1 - position : position;
+}
+
+/**
+ * Gets the node the given number of links away from the head of a linked list.
+ * Uses the skip list index when enabled, otherwise walks from the closest end.
+ * @param list A pointer to the linked list.
+ * @param position The position of the node counted from the head, which must be in range.
+ * @return A pointer to the node.
+ */
+static list_node *node_at(linked_list *list, size_t position) {
+    if (list->index != NULL) {
+        return list_index_node(list->index, list->head, position);
+    }
+
+    list_node *current;
+    if (position <= (list->length - 1) / 2) {
+        current = list->head;
+        for (size_t i = 0; i < position; i++) {
+            current = current->next;
+        }
+        INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_STEPS, position);
+    } else {
+        current = list->tail;
+        for (size_t i = list->length - 1; i > position; i--) {
+            current = current->previous;
+        }
+        INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_STEPS, list->length - 1 - position);
+    }
+
+    return current;
+}
+
+/**
+ * Links a new node between two neighbouring nodes of a linked list.
+ * @param list A pointer to the linked list.
+ * @param value The value of the new node.
+ * @param previous_node A pointer to the node before the new one, or NULL to make it the head.
+ * @param next_node A pointer to the node after the new one, or NULL to make it the tail.
+ * @param position The position the new node will have counted from the head.
+ */
+static void node_link(linked_list *list, int value, list_node *previous_node, list_node *next_node, size_t position) {
+    list_node *new_node = node_new(list, value, next_node, previous_node);
+
+    if (previous_node == NULL) {
+        list->head = new_node;
+    } else {
+        previous_node->next = new_node;
+    }
+
+    if (next_node == NULL) {
+        list->tail = new_node;
+    } else {
+        next_node->previous = new_node;
+    }
+
+    list->length++;
+
+    if (list->index != NULL) {
+        if (next_node == NULL) {
+            list_index_append(list->index, new_node, position);
+        } else if (previous_node == NULL) {
+            list_index_prepend(list->index, new_node);
+        } else {
+            list_index_insert(list->index, new_node, position);
+        }
+    }
+}
+
+/**
+ * Unlinks a node from a linked list and deallocates it.
+ * @param list A pointer to the linked list.
+ * @param node A pointer to the node to remove.
+ * @param position The position of the node counted from the head.
+ * @return The element that was removed.
+ */
+static int node_unlink(linked_list *list, list_node *node, size_t position) {
+    list_node *previous_node = node->previous;
+    list_node *next_node = node->next;
+
+    if (previous_node == NULL) {
+        list->head = next_node;
+    } else {
+        previous_node->next = next_node;
+    }
+
+    if (next_node == NULL) {
+        list->tail = previous_node;
+    } else {
+        next_node->previous = previous_node;
+    }
+
+    int data = node->data;
+    node_free(list, node);
+    list->length--;
+
+    if (list->index != NULL) {
+        if (previous_node == NULL) {
+            list_index_remove_first(list->index);
+        } else if (next_node == NULL) {
+            list_index_remove_last(list->index, position);
+        } else {
+            list_index_remove(list->index, position);
+        }
+    }
+
+    return data;
+}
+
+/**
+ * Swaps the next and previous links of every node in a chain.
+ * The links leaving the chain at either end are swapped too and must be fixed by the caller.
+ * @param first A pointer to the first node of the chain.
+ * @param last A pointer to the last node of the chain.
+ */
+static void chain_reverse(list_node *first, list_node *last) {
+    list_node *current = first;
+    while (true) {
+        list_node *next = current->next;
+        current->next = current->previous;
+        current->previous = next;
+
+        if (current == last) {
+            break;
+        }
+        current = next;
+    }
+}
+
+/**
+ * Builds the skip list index of a linked list again after its nodes were reordered or replaced.
+ * @param list A pointer to the linked list.
+ */
+static void index_rebuild(linked_list *list) {
+    if (list->index == NULL) {
+        return;
+    }
+
+    list_index_clear(list->index);
+
+    size_t position = 0;
+    for (list_node *node = list->head; node != NULL; node = node->next) {
+        list_index_append(list->index, node, position++);
+    }
+}
+
+/**
+ * Reverses the links of a linked list and toggles its reversed flag,
+ * so the list reads the same but its nodes are laid out the other way round. O(n).
+ * @param list A pointer to the linked list.
+ */
+static void orientation_flip(linked_list *list) {
+    if (list->head != NULL) {
+        chain_reverse(list->head, list->tail);
+        list_node *head = list->head;
+        list->head = list->tail;
+        list->tail = head;
+    }
+
+    list->reversed = !list->reversed;
+    index_rebuild(list);
+}
+
+/**
+ * Makes two linked lists take their nodes from the same pool, so nodes can move between them.
+ * A pool used by only one list is merged into the other list's pool in O(1).
+ * @param list A pointer to the linked list.
+ * @param other A pointer to the linked list whose nodes will move.
+ * @return false if both lists use pools shared with others, or different allocators.
+ */
+static bool pools_unify(linked_list *list, linked_list *other) {
+    if (list->pool == other->pool) {
+        return true;
+    }
+
+    if (list->pool->allocator != other->pool->allocator) {
+        return false;
+    }
+
+    linked_list *keeper = list;
+    linked_list *giver = other;
+    if (giver->pool->users != 1) {
+        keeper = other;
+        giver = list;
+    }
+
+    if (giver->pool->users != 1) {
+        return false;
+    }
+
+    node_pool_absorb(keeper->pool, giver->pool);
+    node_pool_drop(giver->pool);
+    node_pool_retain(keeper->pool);
+    giver->pool = keeper->pool;
+
+    return true;
+}
+
+/**
+ * Copies a chain of nodes into new nodes taken from the pool of a linked list.
+ * Used when a chain has to move between lists whose pools can't be unified.
+ * @param list A pointer to the linked list the copies will belong to.
+ * @param first Set to the first node of the chain, replaced by the first copy.
+ * @param last Set to the last node of the chain, replaced by the last copy.
+ * @return An integer indicating the status, nothing is copied on failure.
+ */
+static int chain_copy(linked_list *list, list_node **first, list_node **last) {
+    list_node *copy_first = NULL;
+    list_node *copy_last = NULL;
+    list_node *current = *first;
+    while (current != NULL) {
+        list_node *next = current == *last ? NULL : current->next;
+        list_node *copy = node_new(list, current->data, NULL, copy_last);
+
+        // Ensure the copy was allocated, otherwise undo the copies made so far
+        if (copy == NULL) {
+            while (copy_first != NULL) {
+                list_node *copy_next = copy_first->next;
+                node_free(list, copy_first);
+                copy_first = copy_next;
+            }
+            return ENOMEM;
+        }
+
+        if (copy_last == NULL) {
+            copy_first = copy;
+        } else {
+            copy_last->next = copy;
+        }
+        copy_last = copy;
+        current = next;
+    }
+
+    *first = copy_first;
+    *last = copy_last;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Returns every node of a chain to the pool of a linked list.
+ * @param list A pointer to the linked list the chain was taken from.
+ * @param first A pointer to the first node of the chain.
+ * @param last A pointer to the last node of the chain.
+ */
+static void chain_free(linked_list *list, list_node *first, list_node *last) {
+    list_node *current = first;
+    while (current != NULL) {
+        list_node *next = current == last ? NULL : current->next;
+        node_free(list, current);
+        current = next;
+    }
+}
+
+/**
+ * Adds a batch of integers parsed by the int reader to the end of a linked list.
+ * @param context A pointer to the linked list.
+ * @param values The integers to add.
+ * @param count The number of integers.
+ * @return An integer indicating the status.
+ */
+static int append_all_sink(void *context, const int *values, size_t count) {
+    return linked_list_append_all(context, values, count);
+}
+
 /* Construction */
 
 /**
  * Allocates a linked list.
+ * The list takes its nodes from a pool of its own.
  * @return A pointer to the allocated linked list.
  */
 linked_list *linked_list_alloc() {
-    linked_list *list = malloc(sizeof(linked_list));
+    return linked_list_alloc_with(NULL);
+}
+
+/**
+ * Allocates a linked list whose memory comes from the given allocator.
+ * The list and the pool its nodes are taken from both use the allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated linked list.
+ */
+linked_list *linked_list_alloc_with(const allocator *allocator) {
+    linked_list *list = allocator_alloc(allocator, sizeof(linked_list));
 
     // Ensure the allocation succeeded, then set the default values
     if (list != NULL) {
         list->head = NULL;
         list->tail = NULL;
         list->length = 0;
+        list->reversed = false;
+        list->pool = node_pool_new(sizeof(list_node), allocator);
+        list->allocator = allocator;
+        list->index = NULL;
+
+        // Ensure the pool was allocated
+        if (list->pool == NULL) {
+            allocator_free(allocator, list, sizeof(linked_list));
+            return NULL;
+        }
+    }
+
+    return list;
+}
+
+/**
+ * Allocates a linked list that takes its nodes from a pool shared with other lists.
+ * The list itself is allocated with the pool's allocator.
+ * @param pool A pointer to a pool initialized with linked_list_pool_init.
+ * @return A pointer to the allocated linked list.
+ */
+linked_list *linked_list_alloc_pooled(node_pool *pool) {
+    linked_list *list = linked_list_alloc_with(pool->allocator);
+
+    if (list != NULL) {
+        node_pool_drop(list->pool);
+        node_pool_retain(pool);
+        list->pool = pool;
     }
 
     return list;
 }
 
+/**
+ * Initializes a node pool that can be shared between linked lists.
+ * The pool must outlive every list using it and is released with node_pool_release.
+ * @param pool A pointer to the pool to initialize.
+ * @param allocator A pointer to the allocator the pool takes memory from, or NULL to use the heap.
+ */
+void linked_list_pool_init(node_pool *pool, const allocator *allocator) {
+    node_pool_init(pool, sizeof(list_node), allocator);
+}
+
 /**
  * Initializes a linked list using an array.
+ * All nodes are allocated as one contiguous block and linked in address order.
  * @param list A pointer to the list to initialize.
  * @param values An array of values to populate the list.
  * @param length The length of the values array.
@@ -66,17 +448,35 @@ int linked_list_init(linked_list *list, int *values, size_t length) {
         return LIST_NOT_EMPTY;
     }
 
-    // Loop through each element in the array and create a node to add to the list
-    list_node *current = node_new(values[0], NULL, NULL);
-    list->head = current;
-    for (int i = 1; i < length; i++) {
-        list_node *next = node_new(values[i], NULL, current);
-        current->next = next;
-        current = next;
+    // Allocate every node in one block so the list is laid out in order in memory
+    list_node *nodes = node_pool_take_block(list->pool, length);
+
+    // Ensure that the nodes were allocated
+    if (nodes == NULL) {
+        return ENOMEM;
+    }
+
+    INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_ALLOCS, length);
+    INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, (int64_t)(length * sizeof(list_node)));
+
+    // Loop through each element in the array and link its node to the ones around it
+    for (size_t i = 0; i < length; i++) {
+        nodes[i].data = values[i];
+        nodes[i].previous = i == 0 ? NULL : &nodes[i - 1];
+        nodes[i].next = i == length - 1 ? NULL : &nodes[i + 1];
     }
 
-    list->tail = current;
+    list->head = nodes;
+    list->tail = &nodes[length - 1];
     list->length = length;
+    list->reversed = false;
+
+    if (list->index != NULL) {
+        size_t position = 0;
+        for (list_node *node = list->head; node != NULL; node = node->next) {
+            list_index_append(list->index, node, position++);
+        }
+    }
 
     return EXIT_SUCCESS;
 }
@@ -93,24 +493,100 @@ linked_list *linked_list_new(int *values, size_t length) {
     return list;
 }
 
+/* Snapshots */
+
+/**
+ * Saves the elements of a linked list in order to a snapshot file.
+ * @param list A pointer to the linked list.
+ * @param path The path of the file, which is replaced if it exists.
+ * @return An integer indicating the status.
+ */
+int linked_list_save(linked_list *list, const char *path) {
+    // The writer is only needed for the call, so it comes from the heap rather than the list's allocator
+    snapshot_writer *writer = malloc(sizeof(snapshot_writer));
+
+    if (writer == NULL) {
+        return ENOMEM;
+    }
+
+    int status = snapshot_writer_open(writer, path);
+    if (status == EXIT_SUCCESS) {
+        // Gather the elements into batches so the writer copies them in bulk
+        int batch[1024];
+        size_t count = 0;
+        for (list_node *node = list->reversed ? list->tail : list->head; node != NULL; node = node_after(list, node)) {
+            batch[count++] = node->data;
+            if (count == sizeof(batch) / sizeof(int)) {
+                snapshot_writer_write(writer, batch, count);
+                count = 0;
+            }
+        }
+
+        snapshot_writer_write(writer, batch, count);
+        status = snapshot_writer_close(writer);
+    }
+
+    free(writer);
+
+    return status;
+}
+
+/**
+ * Initializes an empty linked list from a snapshot file.
+ * The file is mapped and its checksum verified, then the nodes are built as one contiguous block.
+ * @param list A pointer to the linked list to initialize.
+ * @param path The path of a file written by linked_list_save or array_stack_save.
+ * @return An integer indicating the status, INVALID_SNAPSHOT if the file isn't a valid snapshot.
+ */
+int linked_list_load(linked_list *list, const char *path) {
+    // Abort if the list isn't empty
+    if (list->head != NULL) {
+        return LIST_NOT_EMPTY;
+    }
+
+    snapshot_mapping mapping;
+    int status = snapshot_map(&mapping, path, true);
+    if (status != EXIT_SUCCESS) {
+        return status;
+    }
+
+    status = linked_list_init(list, mapping.data, mapping.length);
+    snapshot_unmap(&mapping);
+
+    return status;
+}
+
 /* Deletion */
 
 /**
  * Deinitializes a linked list and deallocates each node inside it.
+ * A list that is the only user of its pool releases all nodes at once, or leaves them
+ * to the allocator if it only releases in bulk. A list sharing its pool hands each node back to it.
  * @param list The linked list to deinitialize.
  */
 void linked_list_deinit(linked_list *list) {
-    // Loop through each node and deallocate it
-    list_node *current = list->head;
-    while (current != NULL) {
-        list_node *next = current->next;
-        free(current);
-        current = next;
+    if (list->pool->users == 1) {
+        node_pool_release(list->pool);
+        INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_FREES, list->length);
+        INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, -(int64_t)(list->length * sizeof(list_node)));
+    } else {
+        // Loop through each node and return it to the shared pool
+        list_node *current = list->head;
+        while (current != NULL) {
+            list_node *next = current->next;
+            node_free(list, current);
+            current = next;
+        }
+    }
+
+    if (list->index != NULL) {
+        list_index_clear(list->index);
     }
 
     list->head = NULL;
     list->tail = NULL;
     list->length = 0;
+    list->reversed = false;
 }
 
 /**
@@ -118,7 +594,9 @@ void linked_list_deinit(linked_list *list) {
  * @param list A pointer to a linked list pointer.
  */
 void linked_list_dealloc(linked_list **list) {
-    free(*list);
+    linked_list_index_disable(*list);
+    node_pool_drop((*list)->pool);
+    allocator_free((*list)->allocator, *list, sizeof(linked_list));
     *list = NULL;
 }
 
@@ -131,10 +609,51 @@ void linked_list_delete(linked_list **list) {
     linked_list_dealloc(list);
 }
 
+/* Indexing */
+
+/**
+ * Builds a skip list index over a linked list.
+ * While enabled the index is kept up to date by every mutation,
+ * making positional access, insertion and removal O(log n).
+ * @param list A pointer to the linked list.
+ * @return An integer indicating the status.
+ */
+int linked_list_index_enable(linked_list *list) {
+    if (list->index != NULL) {
+        return EXIT_SUCCESS;
+    }
+
+    list->index = list_index_new(list->allocator);
+
+    // Ensure that the index was allocated
+    if (list->index == NULL) {
+        return ENOMEM;
+    }
+
+    size_t position = 0;
+    for (list_node *node = list->head; node != NULL; node = node->next) {
+        list_index_append(list->index, node, position++);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Removes the skip list index from a linked list and deallocates it.
+ * @param list A pointer to the linked list.
+ */
+void linked_list_index_disable(linked_list *list) {
+    if (list->index != NULL) {
+        list_index_delete(list->index);
+        list->index = NULL;
+    }
+}
+
 /* Accessing */
 
 /**
  * Gets the node at the given index in a linked list.
+ * Uses the skip list index when enabled, otherwise walks from the closest end.
  * Supports reverse indexing through negative numbers.
  * @param list A pointer to the linked_list.
  * @param index The index of the node to access.
@@ -152,20 +671,7 @@ list_node *linked_list_node(linked_list *list, int index) {
 
     int real_index = index < 0 ? list_length + index : index;
 
-    list_node *current;
-    if (real_index <= max_index / 2) {
-        current = list->head;
-        for (int i = 0; i < real_index; i++) {
-            current = current->next;
-        }
-    } else {
-        current = list->tail;
-        for (int i = max_index; i > real_index; i--) {
-            current = current->previous;
-        }
-    }
-
-    return current;
+    return node_at(list, node_position(list, (size_t)real_index));
 }
 
 /**
@@ -178,7 +684,7 @@ int linked_list_first(linked_list *list) {
         fatal_error_print(LIST_EMPTY, "Can't get first element from empty list");
     }
 
-    return list->head->data;
+    return list->reversed ? list->tail->data : list->head->data;
 }
 
 /**
@@ -191,7 +697,7 @@ int linked_list_last(linked_list *list) {
         fatal_error_print(LIST_EMPTY, "Can't get last element from empty list");
     }
 
-    return list->tail->data;
+    return list->reversed ? list->head->data : list->tail->data;
 }
 
 /**
@@ -206,22 +712,90 @@ int linked_list_element(linked_list *list, int index) {
 }
 
 /**
- * Prints a linked list in order.
+ * Writes the elements of a linked list to an output buffer, each followed by a separator, then NULL.
  * @param list A pointer to the linked list.
- * @param new_line A boolean indicating whether or not to add a newline character.
+ * @param out A pointer to the output buffer.
+ * @param forward Whether to write the list in order or in reverse order.
  */
-void linked_list_print(linked_list *list, bool new_line) {
-    list_node *current = list->head;
+static void format_nodes(linked_list *list, output_buffer *out, bool forward) {
+    const char *separator = forward ? " -> " : " <- ";
+    bool from_head = forward != list->reversed;
+
+    list_node *current = from_head ? list->head : list->tail;
     while (current != NULL) {
-        printf("%d -> ", current->data);
-        current = current->next;
+        output_buffer_write_int(out, current->data);
+        output_buffer_write(out, separator, 4);
+        current = from_head ? current->next : current->previous;
     }
 
-    printf("NULL");
-
-    if (new_line) {
-        printf("\n");
-    }
+    output_buffer_write(out, "NULL", 4);
+}
+
+/**
+ * Writes a linked list in order to an output buffer, in the same format as linked_list_print.
+ * @param list A pointer to the linked list.
+ * @param out A pointer to an output buffer writing to a stream, file descriptor or memory.
+ */
+void linked_list_format(linked_list *list, output_buffer *out) {
+    format_nodes(list, out, true);
+}
+
+/**
+ * Writes a linked list in reverse order to an output buffer, in the same format as linked_list_print_rev.
+ * @param list A pointer to the linked list.
+ * @param out A pointer to an output buffer writing to a stream, file descriptor or memory.
+ */
+void linked_list_format_rev(linked_list *list, output_buffer *out) {
+    format_nodes(list, out, false);
+}
+
+/**
+ * Prints a linked list in order to a stream.
+ * The text is formatted into a buffer and written in large chunks.
+ * @param list A pointer to the linked list.
+ * @param file The stream to print to.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ * @return An integer indicating the status.
+ */
+int linked_list_fprint(linked_list *list, FILE *file, bool new_line) {
+    output_buffer out;
+    output_buffer_init_file(&out, file);
+    format_nodes(list, &out, true);
+
+    if (new_line) {
+        output_buffer_write(&out, "\n", 1);
+    }
+
+    return output_buffer_flush(&out);
+}
+
+/**
+ * Prints a linked list in reverse order to a stream.
+ * The text is formatted into a buffer and written in large chunks.
+ * @param list A pointer to the linked list.
+ * @param file The stream to print to.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ * @return An integer indicating the status.
+ */
+int linked_list_fprint_rev(linked_list *list, FILE *file, bool new_line) {
+    output_buffer out;
+    output_buffer_init_file(&out, file);
+    format_nodes(list, &out, false);
+
+    if (new_line) {
+        output_buffer_write(&out, "\n", 1);
+    }
+
+    return output_buffer_flush(&out);
+}
+
+/**
+ * Prints a linked list in order.
+ * @param list A pointer to the linked list.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ */
+void linked_list_print(linked_list *list, bool new_line) {
+    linked_list_fprint(list, stdout, new_line);
 }
 
 /**
@@ -230,17 +804,379 @@ void linked_list_print(linked_list *list, bool new_line) {
  * @param new_line A boolean indicating whether or not to add a newline character.
  */
 void linked_list_print_rev(linked_list *list, bool new_line) {
-    list_node *current = list->tail;
-    while (current != NULL) {
-        printf("%d <- ", current->data);
-        current = current->previous;
+    linked_list_fprint_rev(list, stdout, new_line);
+}
+
+/* Searching */
+
+/**
+ * Splits a linked list into segments that can be walked independently.
+ * With the index enabled the segments start at towers spread over the list,
+ * otherwise the list is walked from both ends towards the middle.
+ * @param list A pointer to the linked list.
+ * @param chains An array of at least SEARCH_CHAINS + 1 chains to fill in.
+ * @return The number of chains.
+ */
+static size_t search_chains(linked_list *list, search_chain *chains) {
+    if (list->length == 0) {
+        return 0;
     }
 
-    printf("NULL");
+    list_node *starts[SEARCH_CHAINS];
+    size_t positions[SEARCH_CHAINS];
+    size_t segments = list->index != NULL ? list_index_segments(list->index, starts, positions, SEARCH_CHAINS) : 0;
 
-    if (new_line) {
-        printf("\n");
+    if (segments == 0) {
+        chains[0] = (search_chain) { list->head, 0, (list->length + 1) / 2, true };
+        chains[1] = (search_chain) { list->tail, list->length - 1, list->length / 2, false };
+        return list->length > 1 ? 2 : 1;
+    }
+
+    // Cover the nodes before the first tower with a chain from the head
+    size_t count = 0;
+    if (positions[0] != 0) {
+        chains[count++] = (search_chain) { list->head, 0, positions[0], true };
+    }
+
+    for (size_t i = 0; i < segments; i++) {
+        size_t end = i + 1 < segments ? positions[i + 1] : list->length;
+        chains[count++] = (search_chain) { starts[i], positions[i], end - positions[i], true };
     }
+
+    return count;
+}
+
+/**
+ * Searches a linked list for a value by walking several segments round robin.
+ * The next node of each segment is prefetched while the other segments are visited,
+ * so the walk isn't limited by the latency of one pointer chase at a time.
+ * @param list A pointer to the linked list.
+ * @param value The value to search for.
+ * @param mode Whether to stop at any match, find the first match or count every match.
+ * @param match Set to the first matching node for SEARCH_FIRST, or any match for SEARCH_ANY.
+ * @param match_position Set to the position of that node.
+ * @return The number of matches seen, which is only the total for SEARCH_COUNT.
+ */
+static size_t search(linked_list *list, int value, search_mode mode, list_node **match, size_t *match_position) {
+    search_chain chains[SEARCH_CHAINS + 1];
+    size_t chain_count = search_chains(list, chains);
+
+    // Chains follow the links from the head, so count their positions in reading order
+    if (list->reversed) {
+        for (size_t i = 0; i < chain_count; i++) {
+            chains[i].position = list->length - 1 - chains[i].position;
+        }
+    }
+
+    size_t matches = 0;
+    size_t steps = 0;
+    list_node *best = NULL;
+    size_t best_position = SIZE_MAX;
+
+    for (size_t active = chain_count; active > 0;) {
+        active = 0;
+        for (size_t i = 0; i < chain_count; i++) {
+            search_chain *chain = &chains[i];
+            if (chain->remaining == 0) {
+                continue;
+            }
+
+            // Stop walking segments that only hold positions after the best match
+            bool ascending = chain->forward != list->reversed;
+            size_t lowest = ascending ? chain->position : chain->position - chain->remaining + 1;
+            if (mode == SEARCH_FIRST && lowest > best_position) {
+                chain->remaining = 0;
+                continue;
+            }
+
+            list_node *node = chain->node;
+            list_node *next = chain->forward ? node->next : node->previous;
+            PREFETCH(next);
+            steps++;
+
+            if (node->data == value) {
+                matches++;
+                if (chain->position < best_position) {
+                    best = node;
+                    best_position = chain->position;
+                }
+
+                if (mode == SEARCH_ANY) {
+                    active = 0;
+                    break;
+                }
+            }
+
+            chain->node = next;
+            chain->position = ascending ? chain->position + 1 : chain->position - 1;
+            chain->remaining--;
+            if (chain->remaining > 0) {
+                active++;
+            }
+        }
+    }
+
+    if (match != NULL) {
+        *match = best;
+        *match_position = best_position;
+    }
+
+    INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_STEPS, steps);
+
+    return matches;
+}
+
+/**
+ * Finds the first node holding the given value in a linked list.
+ * @param list A pointer to the linked list.
+ * @param value The value to search for.
+ * @return A pointer to the first node with the value, or NULL if there is none.
+ */
+list_node *linked_list_find(linked_list *list, int value) {
+    list_node *match;
+    size_t position;
+    search(list, value, SEARCH_FIRST, &match, &position);
+    return match;
+}
+
+/**
+ * Finds the index of the first occurrence of a value in a linked list.
+ * @param list A pointer to the linked list.
+ * @param value The value to search for.
+ * @return The index of the first occurrence, or -1 if the value isn't in the list.
+ */
+int linked_list_index_of(linked_list *list, int value) {
+    list_node *match;
+    size_t position;
+    search(list, value, SEARCH_FIRST, &match, &position);
+    return match != NULL ? (int)position : -1;
+}
+
+/**
+ * Counts the occurrences of a value in a linked list.
+ * @param list A pointer to the linked list.
+ * @param value The value to count.
+ * @return The number of nodes holding the value.
+ */
+size_t linked_list_count(linked_list *list, int value) {
+    return search(list, value, SEARCH_COUNT, NULL, NULL);
+}
+
+/**
+ * Checks whether a value is in a linked list.
+ * @param list A pointer to the linked list.
+ * @param value The value to search for.
+ * @return true if at least one node holds the value.
+ */
+bool linked_list_contains(linked_list *list, int value) {
+    return search(list, value, SEARCH_ANY, NULL, NULL) > 0;
+}
+
+/* Cursors */
+
+/**
+ * Creates a cursor positioned on the node at the given index in a linked list.
+ * An index equal to the length of the list gives a cursor past the end,
+ * where linked_list_cursor_insert_before appends.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the linked list.
+ * @param index The index of the node to position the cursor on.
+ * @return A cursor on the node at the index.
+ */
+linked_list_cursor linked_list_cursor_at(linked_list *list, int index) {
+    int list_length = (int)list->length;
+    int real_index = index < 0 ? list_length + index : index;
+
+    linked_list_cursor cursor;
+    cursor.list = list;
+    cursor.node = real_index == list_length ? NULL : linked_list_node(list, index);
+    cursor.position = (size_t)real_index;
+
+    return cursor;
+}
+
+/**
+ * Checks whether a cursor is positioned on a node.
+ * @param cursor A pointer to the cursor.
+ * @return false if the cursor has moved past either end of the list.
+ */
+bool linked_list_cursor_valid(linked_list_cursor *cursor) {
+    return cursor->node != NULL;
+}
+
+/**
+ * Moves a cursor to the next node.
+ * @param cursor A pointer to the cursor.
+ * @return false if the cursor moved past the end of the list.
+ */
+bool linked_list_cursor_next(linked_list_cursor *cursor) {
+    if (cursor->node == NULL) {
+        fatal_error_print(DOES_NOT_EXIST, "Can't move a cursor that is past the end of the list\n");
+    }
+
+    cursor->node = node_after(cursor->list, cursor->node);
+    cursor->position++;
+
+    return cursor->node != NULL;
+}
+
+/**
+ * Moves a cursor to the previous node.
+ * A cursor past the end of the list moves onto the last node.
+ * @param cursor A pointer to the cursor.
+ * @return false if the cursor moved past the beginning of the list.
+ */
+bool linked_list_cursor_prev(linked_list_cursor *cursor) {
+    if (cursor->node == NULL) {
+        if (cursor->position != cursor->list->length || cursor->list->tail == NULL) {
+            fatal_error_print(DOES_NOT_EXIST, "Can't move a cursor that is before the start of the list\n");
+        }
+
+        cursor->node = cursor->list->reversed ? cursor->list->head : cursor->list->tail;
+    } else {
+        cursor->node = node_before(cursor->list, cursor->node);
+    }
+    cursor->position--;
+
+    return cursor->node != NULL;
+}
+
+/**
+ * Retrieves the element a cursor is positioned on.
+ * @param cursor A pointer to the cursor.
+ * @return The element at the cursor.
+ */
+int linked_list_cursor_get(linked_list_cursor *cursor) {
+    if (cursor->node == NULL) {
+        fatal_error_print(DOES_NOT_EXIST, "Cursor is not positioned on a node\n");
+    }
+
+    return cursor->node->data;
+}
+
+/**
+ * Replaces the element a cursor is positioned on.
+ * @param cursor A pointer to the cursor.
+ * @param value The new value of the element.
+ */
+void linked_list_cursor_set(linked_list_cursor *cursor, int value) {
+    if (cursor->node == NULL) {
+        fatal_error_print(DOES_NOT_EXIST, "Cursor is not positioned on a node\n");
+    }
+
+    cursor->node->data = value;
+}
+
+/**
+ * Inserts a value before the node a cursor is positioned on.
+ * The cursor stays on the same node. A cursor past the end appends the value.
+ * @param cursor A pointer to the cursor.
+ * @param value The value to insert into the list.
+ */
+void linked_list_cursor_insert_before(linked_list_cursor *cursor, int value) {
+    linked_list *list = cursor->list;
+    list_node *node = cursor->node;
+
+    if (node == NULL) {
+        linked_list_append(list, value);
+    } else if (list->reversed) {
+        node_link(list, value, node, node->next, node_position(list, cursor->position) + 1);
+    } else {
+        node_link(list, value, node->previous, node, cursor->position);
+    }
+
+    cursor->position++;
+}
+
+/**
+ * Inserts a value after the node a cursor is positioned on.
+ * The cursor stays on the same node.
+ * @param cursor A pointer to the cursor.
+ * @param value The value to insert into the list.
+ */
+void linked_list_cursor_insert_after(linked_list_cursor *cursor, int value) {
+    linked_list *list = cursor->list;
+    list_node *node = cursor->node;
+
+    if (node == NULL) {
+        fatal_error_print(DOES_NOT_EXIST, "Cursor is not positioned on a node\n");
+    }
+
+    if (list->reversed) {
+        node_link(list, value, node->previous, node, node_position(list, cursor->position));
+    } else {
+        node_link(list, value, node, node->next, cursor->position + 1);
+    }
+}
+
+/**
+ * Removes the node a cursor is positioned on.
+ * The cursor moves onto the node that followed it, or past the end if it was the last node.
+ * @param cursor A pointer to the cursor.
+ * @return The element that was removed.
+ */
+int linked_list_cursor_remove(linked_list_cursor *cursor) {
+    linked_list *list = cursor->list;
+    list_node *node_to_remove = cursor->node;
+
+    if (node_to_remove == NULL) {
+        fatal_error_print(DOES_NOT_EXIST, "Cursor is not positioned on a node\n");
+    }
+
+    cursor->node = node_after(list, node_to_remove);
+
+    return node_unlink(list, node_to_remove, node_position(list, cursor->position));
+}
+
+/**
+ * Measures how far the order of a linked list has drifted from the order of its nodes in memory.
+ * @param list A pointer to the linked list.
+ * @return The fraction of links that don't point to the adjacent node in memory,
+ * from 0 for a list laid out in order to 1 when no neighbours are adjacent.
+ */
+double linked_list_fragmentation(linked_list *list) {
+    if (list->length < 2) {
+        return 0;
+    }
+
+    size_t scattered = 0;
+    for (list_node *current = list->head; current->next != NULL; current = current->next) {
+        if (current->next != current + 1) {
+            scattered++;
+        }
+    }
+
+    return (double)scattered / (double)(list->length - 1);
+}
+
+/**
+ * Reports how the memory held by a linked list is spent.
+ * A list that is the only user of its pool owns the pool's spare nodes and chunk headers,
+ * spare nodes of a shared pool belong to no list in particular and aren't counted.
+ * @param list A pointer to the linked list.
+ * @return The memory usage of the list.
+ */
+memory_usage linked_list_memory_usage(linked_list *list) {
+    memory_usage usage;
+
+    if (list->pool->users == 1) {
+        usage = node_pool_memory_usage(list->pool, list->length, sizeof(int));
+        usage.overhead += sizeof(node_pool);
+    } else {
+        usage.payload = list->length * sizeof(int);
+        usage.overhead = list->length * (list->pool->node_size - sizeof(int));
+        usage.slack = 0;
+    }
+
+    usage.overhead += sizeof(linked_list);
+
+    if (list->index != NULL) {
+        memory_usage index_usage = list_index_memory_usage(list->index);
+        usage.overhead += index_usage.overhead;
+        usage.slack += index_usage.slack;
+    }
+
+    return usage;
 }
 
 /* Mutation */
@@ -274,17 +1210,11 @@ int linked_list_ensure_len(linked_list *list) {
  * @param value The value to add to the list.
  */
 void linked_list_append(linked_list *list, int value) {
-    if (list->tail == NULL) {
-        list->tail = node_new(value, NULL, NULL);
-        list->head = list->tail;
-        list->length = 1;
-        return;
+    if (list->reversed) {
+        node_link(list, value, NULL, list->head, 0);
+    } else {
+        node_link(list, value, list->tail, NULL, list->length);
     }
-
-    list_node *new_node = node_new(value, NULL, list->tail);
-    list->tail->next = new_node;
-    list->tail = new_node;
-    list->length++;
 }
 
 /**
@@ -293,17 +1223,11 @@ void linked_list_append(linked_list *list, int value) {
  * @param value The value to add to the list.
  */
 void linked_list_prepend(linked_list *list, int value) {
-    if (list->head == NULL) {
-        list->head = node_new(value, NULL, NULL);
-        list->tail = list->head;
-        list->length = 1;
-        return;
+    if (list->reversed) {
+        node_link(list, value, list->tail, NULL, list->length);
+    } else {
+        node_link(list, value, NULL, list->head, 0);
     }
-
-    list_node *new_node = node_new(value, list->head, NULL);
-    list->head->previous = new_node;
-    list->head = new_node;
-    list->length++;
 }
 
 /**
@@ -322,15 +1246,93 @@ void linked_list_insert(linked_list *list, int value, int index) {
     } else if (real_index == list_length) {
         linked_list_append(list, value);
     } else {
-        list_node *previous_node = linked_list_node(list, real_index - 1);
-        list_node *next_node = previous_node->next;
-        list_node *new_node = node_new(value, next_node, previous_node);
-        previous_node->next = new_node;
-        next_node->previous = new_node;
-        list->length++;
+        // The node that will end up before the new one, counted from the head
+        size_t position = list->reversed ? (size_t)(list_length - real_index) : (size_t)real_index;
+        list_node *previous_node = linked_list_node(list, list->reversed ? real_index : real_index - 1);
+        node_link(list, value, previous_node, previous_node->next, position);
     }
 }
 
+/**
+ * Adds every value of an array to the end of a linked list, in order.
+ * The new nodes are allocated as one contiguous block.
+ * @param list A pointer to the linked list.
+ * @param values The values to add.
+ * @param count The number of values.
+ * @return An integer indicating the status.
+ */
+int linked_list_append_all(linked_list *list, const int *values, size_t count) {
+    if (count == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    list_node *nodes = node_pool_take_block(list->pool, count);
+
+    // Ensure that the nodes were allocated
+    if (nodes == NULL) {
+        return ENOMEM;
+    }
+
+    INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_ALLOCS, count);
+    INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, (int64_t)(count * sizeof(list_node)));
+
+    for (size_t i = 0; i < count; i++) {
+        nodes[i].data = values[i];
+        nodes[i].previous = i == 0 ? NULL : &nodes[i - 1];
+        nodes[i].next = i == count - 1 ? NULL : &nodes[i + 1];
+    }
+
+    list_node *first = nodes;
+    list_node *last = &nodes[count - 1];
+    size_t position = list->length;
+
+    // A reversed list is appended to at its head, so link the block the other way round
+    if (list->reversed) {
+        chain_reverse(first, last);
+        first = last;
+        last = nodes;
+
+        last->next = list->head;
+        if (list->head == NULL) {
+            list->tail = last;
+        } else {
+            list->head->previous = last;
+        }
+        list->head = first;
+    } else {
+        first->previous = list->tail;
+        if (list->tail == NULL) {
+            list->head = first;
+        } else {
+            list->tail->next = first;
+        }
+        list->tail = last;
+    }
+
+    list->length += count;
+
+    if (list->reversed) {
+        index_rebuild(list);
+    } else if (list->index != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            list_index_append(list->index, &nodes[i], position + i);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Adds every integer in a text file to the end of a linked list, in the order they appear.
+ * The file is streamed in chunks, see int_reader_read_path for the format.
+ * @param list A pointer to the linked list.
+ * @param path The path of the file.
+ * @return An integer indicating the status. Integers read before an error stay in the list.
+ */
+int linked_list_read(linked_list *list, const char *path) {
+    return int_reader_read_path(path, append_all_sink, list);
+}
+
 /**
  * Removes the last element in a linked list.
  * @param list A pointer to the linked list.
@@ -341,15 +1343,11 @@ int linked_list_remove_last(linked_list *list) {
         fatal_error_print(LIST_EMPTY, "Can't remove last element from an empty list");
     }
 
-    list_node *node = list->tail;
-    list->tail = node->previous;
-    list->tail->next = NULL;
-
-    int data = node->data;
-    free(node);
-    list->length--;
+    if (list->reversed) {
+        return node_unlink(list, list->head, 0);
+    }
 
-    return data;
+    return node_unlink(list, list->tail, list->length - 1);
 }
 
 /**
@@ -362,15 +1360,11 @@ int linked_list_remove_first(linked_list *list) {
         fatal_error_print(LIST_EMPTY, "Can't remove first element from an empty list");
     }
 
-    list_node *node = list->head;
-    list->head = node->next;
-    list->head->previous = NULL;
-
-    int data = node->data;
-    free(node);
-    list->length--;
+    if (list->reversed) {
+        return node_unlink(list, list->tail, list->length - 1);
+    }
 
-    return data;
+    return node_unlink(list, list->head, 0);
 }
 
 /**
@@ -383,21 +1377,390 @@ int linked_list_remove(linked_list *list, int index) {
     int list_length = (int)list->length;
     int real_index = index < 0 ? list_length + index : index;
 
-    if (real_index == 0) {
-        return linked_list_remove_first(list);
-    } else if (real_index == list_length - 1) {
-        return linked_list_remove_last(list);
+    list_node *node_to_remove = linked_list_node(list, index);
+
+    return node_unlink(list, node_to_remove, node_position(list, (size_t)real_index));
+}
+
+/**
+ * Moves every node of a linked list into one contiguous block in list order.
+ * A list that is the only user of its pool gets a fresh pool and the old one is released,
+ * a list sharing its pool hands its old nodes back to it.
+ * Node pointers and cursors into the list are invalidated.
+ * @param list A pointer to the linked list.
+ * @return An integer indicating the status.
+ */
+int linked_list_compact(linked_list *list) {
+    if (list->length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    bool sole_user = list->pool->users == 1;
+    node_pool fresh_pool;
+    node_pool *pool = list->pool;
+    if (sole_user) {
+        node_pool_init(&fresh_pool, sizeof(list_node), list->pool->allocator);
+        pool = &fresh_pool;
+    }
+
+    list_node *nodes = node_pool_take_block(pool, list->length);
+
+    // Ensure that the nodes were allocated, the list is left untouched if not
+    if (nodes == NULL) {
+        return ENOMEM;
+    }
+
+    INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_ALLOCS, list->length);
+    INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, (int64_t)(list->length * sizeof(list_node)));
+    INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_BYTES_MOVED, list->length * sizeof(int));
+
+    // Lay the nodes out in the order the list is read in, which undoes any reversal
+    size_t i = 0;
+    list_node *current = list->reversed ? list->tail : list->head;
+    while (current != NULL) {
+        list_node *next = node_after(list, current);
+        nodes[i].data = current->data;
+        nodes[i].previous = i == 0 ? NULL : &nodes[i - 1];
+        nodes[i].next = i == list->length - 1 ? NULL : &nodes[i + 1];
+
+        if (!sole_user) {
+            node_free(list, current);
+        }
+
+        current = next;
+        i++;
+    }
+
+    if (sole_user) {
+        node_pool_release(list->pool);
+        INSTRUMENT_ADD(INSTRUMENT_LINKED_LIST, INSTRUMENT_FREES, list->length);
+        INSTRUMENT_MEMORY(INSTRUMENT_LINKED_LIST, -(int64_t)(list->length * sizeof(list_node)));
+        *list->pool = fresh_pool;
+    }
+
+    list->head = nodes;
+    list->tail = &nodes[list->length - 1];
+    list->reversed = false;
+
+    // The index points at the old nodes, so build it again
+    index_rebuild(list);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Reverses a linked list in O(1) by flipping the direction it is read in.
+ * Node links and the index are left as they are. Cursors into the list are invalidated.
+ * @param list A pointer to the linked list.
+ */
+void linked_list_reverse(linked_list *list) {
+    list->reversed = !list->reversed;
+}
+
+/**
+ * Moves every node of another linked list to the end of a linked list, leaving the other list empty.
+ * The nodes are relinked, not copied, unless both lists share their pools with other lists.
+ * O(1) when neither list has an index, an index is rebuilt in O(n).
+ * If only one list is reversed the shorter one has its links reversed first.
+ * @param list A pointer to the linked list to add to.
+ * @param other A pointer to the linked list whose nodes are moved.
+ * @return An integer indicating the status.
+ */
+int linked_list_concat(linked_list *list, linked_list *other) {
+    if (other->length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    if (list->reversed != other->reversed) {
+        orientation_flip(list->length < other->length ? list : other);
+    }
+
+    return linked_list_splice(list, (int)list->length, other, 0, other->length);
+}
+
+/**
+ * Moves a range of nodes from another linked list into a linked list.
+ * The nodes are relinked, not copied, unless both lists share their pools with other lists.
+ * Besides finding the two ends of the range and the insertion point, this is O(1)
+ * when neither list has an index and both are read in the same direction.
+ * Otherwise the range is reversed in O(count) and an index is rebuilt in O(n).
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the linked list to move the nodes into.
+ * @param index The index in the list the first moved node will have.
+ * @param other A pointer to the linked list to take the nodes from.
+ * @param start The index in the other list of the first node to move.
+ * @param count The number of nodes to move.
+ * @return An integer indicating the status.
+ */
+int linked_list_splice(linked_list *list, int index, linked_list *other, int start, size_t count) {
+    if (list == other) {
+        fatal_error_print(INVALID_INDEX, "Can't splice a list into itself\n");
+    }
+
+    int list_length = (int)list->length;
+    int real_index = index < 0 ? list_length + index : index;
+    int real_start = start < 0 ? (int)other->length + start : start;
+
+    // Ensure that the insertion point and the range are valid
+    if (real_index < 0 || real_index > list_length) {
+        fatal_error_print(INVALID_INDEX, "Index out of range\n");
+    }
+    if (real_start < 0 || (size_t)real_start + count > other->length) {
+        fatal_error_print(INVALID_INDEX, "Range out of range\n");
+    }
+
+    if (count == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // Find the ends of the range in the order the nodes are linked from the head
+    list_node *first = linked_list_node(other, real_start);
+    list_node *last = count == 1 ? first : linked_list_node(other, real_start + (int)count - 1);
+    if (other->reversed) {
+        list_node *swap = first;
+        first = last;
+        last = swap;
+    }
+
+    // Copy the range before touching either list, so a failed allocation changes nothing
+    list_node *moved_first = first;
+    list_node *moved_last = last;
+    bool copied = !pools_unify(list, other);
+    if (copied) {
+        int status = chain_copy(list, &moved_first, &moved_last);
+        if (status != EXIT_SUCCESS) {
+            return status;
+        }
+    }
+
+    // Unlink the range from the other list
+    if (first->previous == NULL) {
+        other->head = last->next;
     } else {
-        list_node *node_to_remove = linked_list_node(list, index);
-        list_node *previous_node = node_to_remove->previous;
-        list_node *next_node = node_to_remove->next;
-        previous_node->next = next_node;
-        next_node->previous = previous_node;
+        first->previous->next = last->next;
+    }
+    if (last->next == NULL) {
+        other->tail = first->previous;
+    } else {
+        last->next->previous = first->previous;
+    }
+    other->length -= count;
 
-        int data = node_to_remove->data;
-        free(node_to_remove);
-        list->length--;
+    if (copied) {
+        chain_free(other, first, last);
+    }
 
-        return data;
+    if (list->reversed != other->reversed) {
+        chain_reverse(moved_first, moved_last);
+        list_node *swap = moved_first;
+        moved_first = moved_last;
+        moved_last = swap;
     }
+
+    // Link the range in at the insertion point counted from the head
+    size_t position = list->reversed ? (size_t)(list_length - real_index) : (size_t)real_index;
+    list_node *previous_node = position == 0 ? NULL : node_at(list, position - 1);
+    list_node *next_node = previous_node == NULL ? list->head : previous_node->next;
+
+    moved_first->previous = previous_node;
+    moved_last->next = next_node;
+    if (previous_node == NULL) {
+        list->head = moved_first;
+    } else {
+        previous_node->next = moved_first;
+    }
+    if (next_node == NULL) {
+        list->tail = moved_last;
+    } else {
+        next_node->previous = moved_last;
+    }
+    list->length += count;
+
+    index_rebuild(list);
+    index_rebuild(other);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Splits a linked list in two at the given index.
+ * The new list shares the pool of the list, so the nodes after the index are moved without copying.
+ * It is indexed if the list is, which rebuilds both indexes in O(n).
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the linked list, which keeps the elements before the index.
+ * @param index The index of the first element to move to the new list.
+ * @return A pointer to a new linked list holding the elements from the index on, or NULL if it couldn't be allocated.
+ */
+linked_list *linked_list_split_at(linked_list *list, int index) {
+    int list_length = (int)list->length;
+    int real_index = index < 0 ? list_length + index : index;
+
+    // Ensure that a valid index was given
+    if (real_index < 0 || real_index > list_length) {
+        fatal_error_print(INVALID_INDEX, "Index out of range\n");
+    }
+
+    linked_list *rest = linked_list_alloc_pooled(list->pool);
+    if (rest == NULL) {
+        return NULL;
+    }
+    rest->reversed = list->reversed;
+
+    if (list->index != NULL && linked_list_index_enable(rest) != EXIT_SUCCESS) {
+        linked_list_dealloc(&rest);
+        return NULL;
+    }
+
+    linked_list_splice(rest, 0, list, real_index, (size_t)(list_length - real_index));
+
+    return rest;
+}
+
+/* Sorting */
+
+/**
+ * Sorts a linked list in ascending order by relinking its nodes.
+ * Bottom-up merge sort: runs of 1, 2, 4, ... nodes are merged in place,
+ * so it is stable, O(n log n) and allocates nothing.
+ * @param list A pointer to the linked list.
+ */
+void linked_list_sort(linked_list *list) {
+    if (list->length < 2) {
+        return;
+    }
+
+    // Sorting relinks every node, so undo any pending reversal to keep equal elements in order
+    if (list->reversed) {
+        orientation_flip(list);
+    }
+
+    list_node *head = list->head;
+    list_node *tail = NULL;
+
+    for (size_t run = 1;; run *= 2) {
+        list_node *left = head;
+        head = NULL;
+        tail = NULL;
+        size_t merges = 0;
+
+        while (left != NULL) {
+            merges++;
+
+            // The right run starts after at most run nodes
+            list_node *right = left;
+            size_t left_size = 0;
+            while (left_size < run && right != NULL) {
+                left_size++;
+                right = right->next;
+            }
+            size_t right_size = run;
+
+            // Merge the two runs, taking from the left run on ties to keep the sort stable
+            while (left_size > 0 || (right_size > 0 && right != NULL)) {
+                list_node *next;
+                if (left_size == 0) {
+                    next = right;
+                    right = right->next;
+                    right_size--;
+                } else if (right_size == 0 || right == NULL || left->data <= right->data) {
+                    next = left;
+                    left = left->next;
+                    left_size--;
+                } else {
+                    next = right;
+                    right = right->next;
+                    right_size--;
+                }
+
+                if (tail == NULL) {
+                    head = next;
+                } else {
+                    tail->next = next;
+                }
+                next->previous = tail;
+                tail = next;
+            }
+
+            left = right;
+        }
+
+        tail->next = NULL;
+
+        if (merges <= 1) {
+            break;
+        }
+    }
+
+    list->head = head;
+    list->tail = tail;
+
+    index_rebuild(list);
+}
+
+/**
+ * Merges a sorted linked list into another sorted linked list.
+ * The nodes of the other list are relinked, not copied, and the other list is left empty.
+ * Equal elements keep their order, with elements of the list before those of the other list.
+ * @param list A pointer to the sorted linked list to merge into.
+ * @param other A pointer to the sorted linked list to merge from.
+ * @return An integer indicating the status.
+ */
+int linked_list_merge_sorted(linked_list *list, linked_list *other) {
+    if (list == other || other->head == NULL) {
+        return EXIT_SUCCESS;
+    }
+
+    // Merging works on the links, so undo any pending reversal first
+    if (list->reversed) {
+        orientation_flip(list);
+    }
+    if (other->reversed) {
+        orientation_flip(other);
+    }
+
+    list_node *right = other->head;
+    list_node *right_last = other->tail;
+    if (!pools_unify(list, other)) {
+        int status = chain_copy(list, &right, &right_last);
+        if (status != EXIT_SUCCESS) {
+            return status;
+        }
+        chain_free(other, other->head, other->tail);
+    }
+
+    list_node *left = list->head;
+    list_node *head = NULL;
+    list_node *tail = NULL;
+    while (left != NULL || right != NULL) {
+        list_node *next;
+        if (right == NULL || (left != NULL && left->data <= right->data)) {
+            next = left;
+            left = left->next;
+        } else {
+            next = right;
+            right = right == right_last ? NULL : right->next;
+        }
+
+        if (tail == NULL) {
+            head = next;
+        } else {
+            tail->next = next;
+        }
+        next->previous = tail;
+        tail = next;
+    }
+    tail->next = NULL;
+
+    list->head = head;
+    list->tail = tail;
+    list->length += other->length;
+
+    other->head = NULL;
+    other->tail = NULL;
+    other->length = 0;
+
+    index_rebuild(list);
+    index_rebuild(other);
+
+    return EXIT_SUCCESS;
 }
@@ -6,6 +6,10 @@
 #define DATA_STRUCTURES_AND_ALGORITHMS_LINKED_LIST_H
 
 #include <stdbool.h>
+#include "../../utils/node_pool.h"
+#include "../../utils/output_buffer.h"
+#include "../../utils/snapshot.h"
+#include "list_index.h"
 
 typedef struct node {
     int data;
@@ -13,36 +17,96 @@ typedef struct node {
     struct node *previous;
 } list_node;
 
+/**
+ * While reversed is set the list is read from tail to head. The nodes keep their links,
+ * every function swaps the roles of head and tail and of next and previous instead.
+ */
 typedef struct {
     list_node *head;
     list_node *tail;
     size_t length;
+    bool reversed;
+    node_pool *pool;
+    const allocator *allocator;
+    list_index *index;
 } linked_list;
 
+typedef struct {
+    linked_list *list;
+    list_node *node;
+    size_t position;
+} linked_list_cursor;
+
 // Construction
 linked_list *linked_list_alloc();
+linked_list *linked_list_alloc_with(const allocator *allocator);
+linked_list *linked_list_alloc_pooled(node_pool *pool);
+void linked_list_pool_init(node_pool *pool, const allocator *allocator);
 int linked_list_init(linked_list *list, int *values, size_t length);
 linked_list *linked_list_new(int *values, size_t length);
 
+// Snapshots
+int linked_list_save(linked_list *list, const char *path);
+int linked_list_load(linked_list *list, const char *path);
+
 // Deletion
 void linked_list_deinit(linked_list *list);
 void linked_list_dealloc(linked_list **list);
 void linked_list_delete(linked_list **list);
 
+// Indexing
+int linked_list_index_enable(linked_list *list);
+void linked_list_index_disable(linked_list *list);
+
 // Accessing
+list_node *linked_list_node(linked_list *list, int index);
 int linked_list_first(linked_list *list);
 int linked_list_last(linked_list *list);
 int linked_list_element(linked_list *list, int index);
 void linked_list_print(linked_list *list, bool new_line);
 void linked_list_print_rev(linked_list *list, bool new_line);
+void linked_list_format(linked_list *list, output_buffer *out);
+void linked_list_format_rev(linked_list *list, output_buffer *out);
+int linked_list_fprint(linked_list *list, FILE *file, bool new_line);
+int linked_list_fprint_rev(linked_list *list, FILE *file, bool new_line);
+double linked_list_fragmentation(linked_list *list);
+memory_usage linked_list_memory_usage(linked_list *list);
+
+// Searching
+list_node *linked_list_find(linked_list *list, int value);
+int linked_list_index_of(linked_list *list, int value);
+size_t linked_list_count(linked_list *list, int value);
+bool linked_list_contains(linked_list *list, int value);
+
+// Cursors
+linked_list_cursor linked_list_cursor_at(linked_list *list, int index);
+bool linked_list_cursor_valid(linked_list_cursor *cursor);
+bool linked_list_cursor_next(linked_list_cursor *cursor);
+bool linked_list_cursor_prev(linked_list_cursor *cursor);
+int linked_list_cursor_get(linked_list_cursor *cursor);
+void linked_list_cursor_set(linked_list_cursor *cursor, int value);
+void linked_list_cursor_insert_before(linked_list_cursor *cursor, int value);
+void linked_list_cursor_insert_after(linked_list_cursor *cursor, int value);
+int linked_list_cursor_remove(linked_list_cursor *cursor);
 
 // Mutation
 int linked_list_ensure_len(linked_list *list);
 void linked_list_append(linked_list *list, int value);
 void linked_list_prepend(linked_list *list, int value);
 void linked_list_insert(linked_list *list, int value, int index);
+int linked_list_append_all(linked_list *list, const int *values, size_t count);
+int linked_list_read(linked_list *list, const char *path);
 int linked_list_remove_last(linked_list *list);
 int linked_list_remove_first(linked_list *list);
 int linked_list_remove(linked_list *list, int index);
+int linked_list_compact(linked_list *list);
+void linked_list_reverse(linked_list *list);
+int linked_list_concat(linked_list *list, linked_list *other);
+int linked_list_splice(linked_list *list, int index, linked_list *other, int start, size_t count);
+linked_list *linked_list_split_at(linked_list *list, int index);
+
+// Sorting
+void linked_list_sort(linked_list *list);
+int linked_list_merge_sorted(linked_list *list, linked_list *other);
 
 #endif //DATA_STRUCTURES_AND_ALGORITHMS_LINKED_LIST_H
@@ -0,0 +1,566 @@
+//
+// Created by Christopher Szatmary on 2018-12-19.
+//
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "list_index.h"
+#include "linked_list.h"
+
+#define MAX_LEVELS 32
+
+typedef struct index_tower index_tower;
+
+typedef struct {
+    index_tower *next;
+    index_tower *previous;
+    size_t span;
+} index_link;
+
+struct index_tower {
+    list_node *node;
+    size_t height;
+    index_link links[];
+};
+
+/**
+ * first_pos and last_pos are stored relative to offset,
+ * so shifting every position for a prepend or remove_first is O(1).
+ */
+struct list_index {
+    index_tower *first[MAX_LEVELS];
+    index_tower *last[MAX_LEVELS];
+    long first_pos[MAX_LEVELS];
+    long last_pos[MAX_LEVELS];
+    long offset;
+    size_t levels;
+    uint64_t seed;
+    const allocator *allocator;
+};
+
+/* Helpers */
+
+/**
+ * Picks the height of the tower for a new node.
+ * A node gets a tower with probability 1/4 and every further level with probability 1/4.
+ * @param index A pointer to the list index.
+ * @return The height of the tower, 0 if the node shouldn't be indexed.
+ */
+static size_t random_height(list_index *index) {
+    // xorshift64*
+    index->seed ^= index->seed >> 12;
+    index->seed ^= index->seed << 25;
+    index->seed ^= index->seed >> 27;
+    uint64_t bits = index->seed * 0x2545F4914F6CDD1DULL;
+
+    size_t height = 0;
+    while (height < MAX_LEVELS && (bits & 3) == 0) {
+        height++;
+        bits >>= 2;
+    }
+
+    return height;
+}
+
+/**
+ * Allocates a tower for a node.
+ * @param index A pointer to the list index.
+ * @param node A pointer to the node the tower belongs to.
+ * @param height The number of levels of the tower.
+ * @return A pointer to the tower, or NULL if the allocation failed.
+ */
+static index_tower *tower_new(list_index *index, list_node *node, size_t height) {
+    index_tower *tower = allocator_alloc(index->allocator, sizeof(index_tower) + height * sizeof(index_link));
+
+    if (tower != NULL) {
+        tower->node = node;
+        tower->height = height;
+    }
+
+    return tower;
+}
+
+/**
+ * Deallocates a tower.
+ * @param index A pointer to the list index.
+ * @param tower A pointer to the tower.
+ */
+static void tower_free(list_index *index, index_tower *tower) {
+    allocator_free(index->allocator, tower, sizeof(index_tower) + tower->height * sizeof(index_link));
+}
+
+/**
+ * Finds the last tower before the given position on every level in use.
+ * @param index A pointer to the list index.
+ * @param position The position to search for.
+ * @param predecessors Set to the last tower before the position on each level, or NULL if there is none.
+ * @param positions Set to the position of each predecessor.
+ */
+static void index_find(list_index *index, long position, index_tower **predecessors, long *positions) {
+    index_tower *current = NULL;
+    long current_pos = -1;
+
+    for (size_t level = index->levels; level-- > 0;) {
+        while (true) {
+            index_tower *next = current != NULL ? current->links[level].next : index->first[level];
+            if (next == NULL) {
+                break;
+            }
+
+            long next_pos = current != NULL
+                            ? current_pos + (long)current->links[level].span
+                            : index->first_pos[level] + index->offset;
+            if (next_pos >= position) {
+                break;
+            }
+
+            current = next;
+            current_pos = next_pos;
+        }
+
+        predecessors[level] = current;
+        positions[level] = current_pos;
+    }
+}
+
+/**
+ * Links a tower into one level, after the given predecessor.
+ * Positions of the surrounding towers must already account for the new node.
+ * @param index A pointer to the list index.
+ * @param tower A pointer to the tower to link.
+ * @param level The level to link the tower into.
+ * @param predecessor A pointer to the tower before it on this level, or NULL if it will be the first.
+ * @param predecessor_pos The position of the predecessor.
+ * @param position The position of the tower's node.
+ */
+static void tower_link(list_index *index, index_tower *tower, size_t level,
+                       index_tower *predecessor, long predecessor_pos, long position) {
+    index_link *link = &tower->links[level];
+    index_tower *next;
+    long next_pos = 0;
+
+    if (predecessor != NULL) {
+        next = predecessor->links[level].next;
+        next_pos = predecessor_pos + (long)predecessor->links[level].span;
+        predecessor->links[level].next = tower;
+        predecessor->links[level].span = (size_t)(position - predecessor_pos);
+    } else {
+        next = index->first[level];
+        next_pos = index->first_pos[level] + index->offset;
+        index->first[level] = tower;
+        index->first_pos[level] = position - index->offset;
+    }
+
+    link->next = next;
+    link->previous = predecessor;
+
+    if (next != NULL) {
+        link->span = (size_t)(next_pos - position);
+        next->links[level].previous = tower;
+    } else {
+        link->span = 0;
+        index->last[level] = tower;
+        index->last_pos[level] = position - index->offset;
+    }
+}
+
+/**
+ * Unlinks a tower from one level.
+ * Positions are left as they were before the removal, the caller shifts them afterwards.
+ * @param index A pointer to the list index.
+ * @param tower A pointer to the tower to unlink.
+ * @param level The level to unlink the tower from.
+ * @param predecessor A pointer to the tower before it on this level, or NULL if it is the first.
+ * @param predecessor_pos The position of the predecessor.
+ * @param position The position of the tower's node.
+ */
+static void tower_unlink(list_index *index, index_tower *tower, size_t level,
+                         index_tower *predecessor, long predecessor_pos, long position) {
+    index_link *link = &tower->links[level];
+    index_tower *next = link->next;
+
+    if (next != NULL) {
+        next->links[level].previous = predecessor;
+    } else {
+        index->last[level] = predecessor;
+        index->last_pos[level] = predecessor != NULL ? predecessor_pos - index->offset : 0;
+    }
+
+    if (predecessor != NULL) {
+        predecessor->links[level].next = next;
+        predecessor->links[level].span = next != NULL ? predecessor->links[level].span + link->span : 0;
+    } else {
+        index->first[level] = next;
+        index->first_pos[level] = next != NULL ? position + (long)link->span - index->offset : 0;
+    }
+}
+
+/**
+ * Drops empty levels from the top of the index.
+ * @param index A pointer to the list index.
+ */
+static void index_shrink(list_index *index) {
+    while (index->levels > 0 && index->first[index->levels - 1] == NULL) {
+        index->levels--;
+    }
+}
+
+/**
+ * Creates a tower for a node if it is picked to be indexed.
+ * @param index A pointer to the list index.
+ * @param node A pointer to the node.
+ * @return A pointer to the tower, or NULL if the node isn't indexed.
+ */
+static index_tower *index_promote(list_index *index, list_node *node) {
+    size_t height = random_height(index);
+
+    // A node without a tower is still reachable by walking from the tower before it
+    return height == 0 ? NULL : tower_new(index, node, height);
+}
+
+/* Construction */
+
+/**
+ * Allocates an empty list index.
+ * @param allocator A pointer to the allocator towers are taken from, or NULL to use the heap.
+ * @return A pointer to the list index.
+ */
+list_index *list_index_new(const allocator *allocator) {
+    list_index *index = allocator_alloc(allocator, sizeof(list_index));
+
+    if (index != NULL) {
+        index->allocator = allocator;
+        index->seed = 0x9E3779B97F4A7C15ULL ^ (uint64_t)(uintptr_t)index;
+        index->levels = 0;
+        list_index_clear(index);
+    }
+
+    return index;
+}
+
+/* Deletion */
+
+/**
+ * Deallocates every tower in the index, leaving it empty.
+ * @param index A pointer to the list index.
+ */
+void list_index_clear(list_index *index) {
+    // Every tower is on the bottom level
+    index_tower *current = index->levels > 0 && allocator_frees(index->allocator) ? index->first[0] : NULL;
+    while (current != NULL) {
+        index_tower *next = current->links[0].next;
+        tower_free(index, current);
+        current = next;
+    }
+
+    for (size_t level = 0; level < MAX_LEVELS; level++) {
+        index->first[level] = NULL;
+        index->last[level] = NULL;
+        index->first_pos[level] = 0;
+        index->last_pos[level] = 0;
+    }
+
+    index->offset = 0;
+    index->levels = 0;
+}
+
+/**
+ * Deallocates a list index and all of its towers.
+ * @param index A pointer to the list index.
+ */
+void list_index_delete(list_index *index) {
+    list_index_clear(index);
+    allocator_free(index->allocator, index, sizeof(list_index));
+}
+
+/* Accessing */
+
+/**
+ * Finds the node at the given position.
+ * @param index A pointer to the list index.
+ * @param head A pointer to the first node in the list.
+ * @param position The position of the node, which must be in range.
+ * @return A pointer to the node at the position.
+ */
+list_node *list_index_node(list_index *index, list_node *head, size_t position) {
+    index_tower *current = NULL;
+    long current_pos = 0;
+
+    for (size_t level = index->levels; level-- > 0;) {
+        while (true) {
+            index_tower *next = current != NULL ? current->links[level].next : index->first[level];
+            if (next == NULL) {
+                break;
+            }
+
+            long next_pos = current != NULL
+                            ? current_pos + (long)current->links[level].span
+                            : index->first_pos[level] + index->offset;
+            if (next_pos > (long)position) {
+                break;
+            }
+
+            current = next;
+            current_pos = next_pos;
+        }
+    }
+
+    // Walk the rest of the way along the list itself
+    list_node *node = current != NULL ? current->node : head;
+    for (long i = current_pos; i < (long)position; i++) {
+        node = node->next;
+    }
+
+    return node;
+}
+
+/**
+ * Picks nodes spread evenly over the list, to split it into segments that can be walked independently.
+ * Uses the highest level with enough towers so only a few towers are visited.
+ * @param index A pointer to the list index.
+ * @param starts Set to the first node of each segment, in list order.
+ * @param positions Set to the position of each of those nodes.
+ * @param count The maximum number of segments.
+ * @return The number of segments found, 0 if the index is empty.
+ */
+size_t list_index_segments(list_index *index, list_node **starts, size_t *positions, size_t count) {
+    if (index->levels == 0 || count == 0) {
+        return 0;
+    }
+
+    // Find the highest level with at least count towers, which has about 4 * count at most
+    size_t level = index->levels;
+    size_t towers = 0;
+    while (level-- > 0) {
+        towers = 0;
+        for (index_tower *tower = index->first[level]; tower != NULL; tower = tower->links[level].next) {
+            towers++;
+        }
+
+        if (towers >= count || level == 0) {
+            break;
+        }
+    }
+
+    // Take every stride-th tower on that level
+    size_t stride = towers > count ? towers / count : 1;
+    size_t found = 0;
+    size_t seen = 0;
+    long position = index->first_pos[level] + index->offset;
+    for (index_tower *tower = index->first[level]; tower != NULL && found < count; seen++) {
+        if (seen % stride == 0) {
+            starts[found] = tower->node;
+            positions[found] = (size_t)position;
+            found++;
+        }
+
+        position += (long)tower->links[level].span;
+        tower = tower->links[level].next;
+    }
+
+    return found;
+}
+
+/**
+ * Reports the memory taken by the index and its towers, all of which is overhead.
+ * @param index A pointer to the list index.
+ * @return The memory usage of the index.
+ */
+memory_usage list_index_memory_usage(list_index *index) {
+    memory_usage usage = { 0, sizeof(list_index), 0 };
+
+    // Every tower is on the bottom level
+    index_tower *current = index->levels > 0 ? index->first[0] : NULL;
+    while (current != NULL) {
+        size_t size = sizeof(index_tower) + current->height * sizeof(index_link);
+        usage.overhead += size;
+        usage.slack += allocator_slack(index->allocator, current, size);
+        current = current->links[0].next;
+    }
+
+    return usage;
+}
+
+/* Mutation */
+
+/**
+ * Updates the index after a node was added to the front of the list.
+ * @param index A pointer to the list index.
+ * @param node A pointer to the new first node.
+ */
+void list_index_prepend(list_index *index, list_node *node) {
+    // Every existing node moves back one position
+    index->offset++;
+
+    index_tower *tower = index_promote(index, node);
+    if (tower == NULL) {
+        return;
+    }
+
+    for (size_t level = 0; level < tower->height; level++) {
+        tower_link(index, tower, level, NULL, -1, 0);
+    }
+
+    if (tower->height > index->levels) {
+        index->levels = tower->height;
+    }
+}
+
+/**
+ * Updates the index after a node was added to the end of the list.
+ * @param index A pointer to the list index.
+ * @param node A pointer to the new last node.
+ * @param position The position of the new last node.
+ */
+void list_index_append(list_index *index, list_node *node, size_t position) {
+    index_tower *tower = index_promote(index, node);
+    if (tower == NULL) {
+        return;
+    }
+
+    for (size_t level = 0; level < tower->height; level++) {
+        index_tower *last = index->last[level];
+        tower_link(index, tower, level, last, index->last_pos[level] + index->offset, (long)position);
+    }
+
+    if (tower->height > index->levels) {
+        index->levels = tower->height;
+    }
+}
+
+/**
+ * Updates the index after a node was inserted into the list.
+ * @param index A pointer to the list index.
+ * @param node A pointer to the new node.
+ * @param position The position of the new node.
+ */
+void list_index_insert(list_index *index, list_node *node, size_t position) {
+    index_tower *predecessors[MAX_LEVELS];
+    long positions[MAX_LEVELS];
+    long pos = (long)position;
+    index_find(index, pos, predecessors, positions);
+
+    // Every tower at or after the position moves back one place
+    for (size_t level = 0; level < index->levels; level++) {
+        if (predecessors[level] != NULL) {
+            if (predecessors[level]->links[level].next != NULL) {
+                predecessors[level]->links[level].span++;
+            }
+        } else if (index->first[level] != NULL) {
+            index->first_pos[level]++;
+        }
+
+        if (index->last[level] != NULL && index->last_pos[level] + index->offset >= pos) {
+            index->last_pos[level]++;
+        }
+    }
+
+    index_tower *tower = index_promote(index, node);
+    if (tower == NULL) {
+        return;
+    }
+
+    for (size_t level = 0; level < tower->height; level++) {
+        if (level < index->levels) {
+            tower_link(index, tower, level, predecessors[level], positions[level], pos);
+        } else {
+            tower_link(index, tower, level, NULL, -1, pos);
+        }
+    }
+
+    if (tower->height > index->levels) {
+        index->levels = tower->height;
+    }
+}
+
+/**
+ * Updates the index after the first node was removed from the list.
+ * @param index A pointer to the list index.
+ */
+void list_index_remove_first(list_index *index) {
+    index_tower *tower = index->first[0];
+
+    if (tower != NULL && index->first_pos[0] + index->offset == 0) {
+        for (size_t level = 0; level < tower->height; level++) {
+            tower_unlink(index, tower, level, NULL, -1, 0);
+        }
+
+        tower_free(index, tower);
+        index_shrink(index);
+    }
+
+    // Every remaining node moves forward one position
+    index->offset--;
+}
+
+/**
+ * Updates the index after the last node was removed from the list.
+ * @param index A pointer to the list index.
+ * @param position The position the removed node had.
+ */
+void list_index_remove_last(list_index *index, size_t position) {
+    index_tower *tower = index->last[0];
+    long pos = (long)position;
+
+    if (tower == NULL || index->last_pos[0] + index->offset != pos) {
+        return;
+    }
+
+    for (size_t level = 0; level < tower->height; level++) {
+        index_tower *previous = tower->links[level].previous;
+        long previous_pos = previous != NULL ? pos - (long)previous->links[level].span : -1;
+        tower_unlink(index, tower, level, previous, previous_pos, pos);
+    }
+
+    tower_free(index, tower);
+    index_shrink(index);
+}
+
+/**
+ * Updates the index after a node was removed from the list.
+ * @param index A pointer to the list index.
+ * @param position The position the removed node had.
+ */
+void list_index_remove(list_index *index, size_t position) {
+    index_tower *predecessors[MAX_LEVELS];
+    long positions[MAX_LEVELS];
+    long pos = (long)position;
+    index_find(index, pos, predecessors, positions);
+
+    index_tower *removed = NULL;
+    for (size_t level = 0; level < index->levels; level++) {
+        index_tower *predecessor = predecessors[level];
+        index_tower *next = predecessor != NULL ? predecessor->links[level].next : index->first[level];
+        if (next == NULL) {
+            continue;
+        }
+
+        long next_pos = predecessor != NULL
+                        ? positions[level] + (long)predecessor->links[level].span
+                        : index->first_pos[level] + index->offset;
+        if (next_pos == pos) {
+            removed = next;
+            tower_unlink(index, next, level, predecessor, positions[level], pos);
+        }
+    }
+
+    // Every tower after the position moves forward one place
+    for (size_t level = 0; level < index->levels; level++) {
+        if (predecessors[level] != NULL) {
+            if (predecessors[level]->links[level].next != NULL) {
+                predecessors[level]->links[level].span--;
+            }
+        } else if (index->first[level] != NULL) {
+            index->first_pos[level]--;
+        }
+
+        if (index->last[level] != NULL && index->last_pos[level] + index->offset > pos) {
+            index->last_pos[level]--;
+        }
+    }
+
+    if (removed != NULL) {
+        tower_free(index, removed);
+        index_shrink(index);
+    }
+}
@@ -0,0 +1,41 @@
+//
+// Created by Christopher Szatmary on 2018-12-19.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_LIST_INDEX_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_LIST_INDEX_H
+
+#include <stddef.h>
+#include "../../utils/allocator.h"
+
+struct node;
+
+/**
+ * An indexable skip list over the nodes of a linked list.
+ * Some nodes get a tower of express links, each link storing how many positions it spans,
+ * so the node at any position can be found in O(log n) expected time.
+ * The linked list itself acts as the bottom level and is not duplicated.
+ */
+typedef struct list_index list_index;
+
+// Construction
+list_index *list_index_new(const allocator *allocator);
+
+// Deletion
+void list_index_clear(list_index *index);
+void list_index_delete(list_index *index);
+
+// Accessing
+struct node *list_index_node(list_index *index, struct node *head, size_t position);
+size_t list_index_segments(list_index *index, struct node **starts, size_t *positions, size_t count);
+memory_usage list_index_memory_usage(list_index *index);
+
+// Mutation
+void list_index_prepend(list_index *index, struct node *node);
+void list_index_append(list_index *index, struct node *node, size_t position);
+void list_index_insert(list_index *index, struct node *node, size_t position);
+void list_index_remove_first(list_index *index);
+void list_index_remove_last(list_index *index, size_t position);
+void list_index_remove(list_index *index, size_t position);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_LIST_INDEX_H
@@ -0,0 +1,463 @@
+//
+// Created by Christopher Szatmary on 2018-12-30.
+//
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#include "mpmc_queue.h"
+#include "../../utils/error.h"
+
+/* Helpers */
+
+/**
+ * Sleeps until a wait word no longer holds a value or the thread is woken.
+ * Without futexes the thread just yields, the caller checks again either way.
+ * @param word A pointer to the wait word.
+ * @param seen The value the caller saw before deciding to sleep.
+ */
+static void futex_wait(_Atomic uint32_t *word, uint32_t seen) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)seen;
+    sched_yield();
+#endif
+}
+
+/**
+ * Wakes threads sleeping on a wait word.
+ * @param word A pointer to the wait word.
+ * @param count The most threads to wake.
+ */
+static void futex_wake(_Atomic uint32_t *word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+/**
+ * Wakes the threads blocked waiting for the other end of the queue to move, if there are any.
+ * The first operation to see waiters takes them all, so the operations that follow don't make
+ * a system call each while the woken threads are still waiting to be scheduled.
+ * Pairs with the waiter count incremented in wait_on, so either the waiter sees
+ * the change to the queue or the change sees the waiter.
+ * @param word A pointer to the wait word of the waiting threads.
+ * @param waiters A pointer to the number of waiting threads.
+ */
+static void wake_waiters(_Atomic uint32_t *word, _Atomic uint32_t *waiters) {
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(waiters, memory_order_relaxed) > 0 &&
+        atomic_exchange_explicit(waiters, 0, memory_order_relaxed) > 0) {
+        atomic_fetch_add_explicit(word, 1, memory_order_release);
+        futex_wake(word, INT_MAX);
+    }
+}
+
+/**
+ * Blocks until an operation that can't make progress yet succeeds.
+ * A waiter that succeeds without sleeping leaves its count behind, which costs
+ * at most one needless wake up later.
+ * @param queue A pointer to the MPMC queue.
+ * @param word A pointer to the wait word bumped when the operation may succeed.
+ * @param waiters A pointer to the number of threads waiting on the word.
+ * @param attempt The operation, tried once more after announcing the wait.
+ * @param value The value passed on to the operation.
+ */
+static void wait_on(mpmc_queue *queue, _Atomic uint32_t *word, _Atomic uint32_t *waiters,
+                    bool (*attempt)(mpmc_queue *, int *), int *value) {
+    while (true) {
+        uint32_t seen = atomic_load_explicit(word, memory_order_acquire);
+        atomic_fetch_add(waiters, 1);
+
+        if (attempt(queue, value)) {
+            return;
+        }
+
+        futex_wait(word, seen);
+
+        if (attempt(queue, value)) {
+            return;
+        }
+    }
+}
+
+static bool attempt_push(mpmc_queue *queue, int *value) {
+    return mpmc_queue_try_push(queue, *value);
+}
+
+static bool attempt_pop(mpmc_queue *queue, int *value) {
+    return mpmc_queue_try_pop(queue, value);
+}
+
+/**
+ * Counts the slots from a position on that are ready for a batch operation, stopping at the
+ * first one that isn't, so a batch never claims a slot a peer is still pushing to or popping from.
+ * A ready slot stays ready until the position is claimed, only the thread claiming it moves it on.
+ * @param queue A pointer to the MPMC queue.
+ * @param position The first position of the batch.
+ * @param filled false for pushes, which need slots freed for this lap, true for pops, which need them filled.
+ * @param count The most slots to count.
+ * @return The number of ready slots.
+ */
+static size_t slots_ready(mpmc_queue *queue, size_t position, bool filled, size_t count) {
+    size_t limit = count < queue->mask + 1 ? count : queue->mask + 1;
+    size_t ready = 0;
+
+    while (ready < limit) {
+        mpmc_queue_slot *slot = &queue->slots[(position + ready) & queue->mask];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != position + ready + filled) {
+            break;
+        }
+        ready++;
+    }
+
+    return ready;
+}
+
+/**
+ * Claims the ready slots at the start of a batch with one compare and swap on head or tail.
+ * Never waits for other threads, a batch whose first slot isn't ready claims nothing.
+ * @param queue A pointer to the MPMC queue.
+ * @param end A pointer to the tail for pushes or the head for pops.
+ * @param filled false for pushes, true for pops.
+ * @param count The most slots to claim.
+ * @param position Set to the first position claimed.
+ * @return The number of slots claimed.
+ */
+static size_t slots_claim(mpmc_queue *queue, _Atomic size_t *end, bool filled, size_t count, size_t *position) {
+    size_t first = atomic_load_explicit(end, memory_order_relaxed);
+
+    while (count > 0) {
+        size_t claimed = slots_ready(queue, first, filled, count);
+
+        if (claimed == 0) {
+            // A slot ahead of this lap means another thread already claimed the position
+            size_t sequence = atomic_load_explicit(&queue->slots[first & queue->mask].sequence, memory_order_relaxed);
+            if ((intptr_t)sequence - (intptr_t)(first + filled) < 0) {
+                return 0;
+            }
+            first = atomic_load_explicit(end, memory_order_relaxed);
+        } else if (atomic_compare_exchange_weak_explicit(end, &first, first + claimed,
+                                                         memory_order_relaxed, memory_order_relaxed)) {
+            *position = first;
+            return claimed;
+        }
+    }
+
+    return 0;
+}
+
+/* Construction */
+
+/**
+ * Allocates an MPMC queue. It has no room until it is initialized.
+ * @return A pointer to the allocated MPMC queue.
+ */
+mpmc_queue *mpmc_queue_alloc() {
+    return mpmc_queue_alloc_with(NULL);
+}
+
+/**
+ * Allocates an MPMC queue whose memory comes from the given allocator.
+ * The ring is allocated once, the allocator is never used while threads use the queue.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated MPMC queue.
+ */
+mpmc_queue *mpmc_queue_alloc_with(const allocator *allocator) {
+    mpmc_queue *queue = allocator_alloc(allocator, sizeof(mpmc_queue));
+
+    if (queue != NULL) {
+        queue->slots = NULL;
+        queue->mask = 0;
+        queue->allocator = allocator;
+        atomic_init(&queue->tail, 0);
+        atomic_init(&queue->head, 0);
+        atomic_init(&queue->pushes, 0);
+        atomic_init(&queue->pop_waiters, 0);
+        atomic_init(&queue->pops, 0);
+        atomic_init(&queue->push_waiters, 0);
+    }
+
+    return queue;
+}
+
+/**
+ * Initializes an MPMC queue with room for a number of values.
+ * Must not run while other threads use the queue.
+ * @param queue A pointer to the queue to initialize.
+ * @param capacity The number of values the queue can hold, rounded up to a power of two.
+ * @return An integer indicating the status.
+ */
+int mpmc_queue_init(mpmc_queue *queue, size_t capacity) {
+    // Abort if the queue already has a ring
+    if (queue->slots != NULL) {
+        return SPACE_ALREADY_ALLOCATED;
+    }
+
+    size_t actual_capacity = 2;
+    while (actual_capacity < capacity) {
+        actual_capacity *= 2;
+    }
+
+    mpmc_queue_slot *slots = allocator_alloc(queue->allocator, actual_capacity * sizeof(mpmc_queue_slot));
+
+    // Ensure that the ring was allocated
+    if (slots == NULL) {
+        return ENOMEM;
+    }
+
+    // Slot i is free for the push at position i
+    for (size_t i = 0; i < actual_capacity; i++) {
+        atomic_init(&slots[i].sequence, i);
+    }
+
+    queue->slots = slots;
+    queue->mask = actual_capacity - 1;
+    atomic_store(&queue->tail, 0);
+    atomic_store(&queue->head, 0);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Allocates and initializes an MPMC queue.
+ * @param capacity The number of values the queue can hold, rounded up to a power of two.
+ * @return A pointer to the newly created MPMC queue.
+ */
+mpmc_queue *mpmc_queue_new(size_t capacity) {
+    mpmc_queue *queue = mpmc_queue_alloc();
+    mpmc_queue_init(queue, capacity);
+    return queue;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes an MPMC queue and deallocates its ring.
+ * Must not run while other threads use the queue.
+ * @param queue A pointer to the queue to deinitialize.
+ */
+void mpmc_queue_deinit(mpmc_queue *queue) {
+    if (queue->slots != NULL) {
+        allocator_free(queue->allocator, queue->slots, (queue->mask + 1) * sizeof(mpmc_queue_slot));
+    }
+
+    queue->slots = NULL;
+    queue->mask = 0;
+    atomic_store(&queue->tail, 0);
+    atomic_store(&queue->head, 0);
+}
+
+/**
+ * Deallocates the given MPMC queue pointer.
+ * @param queue A pointer to an MPMC queue pointer.
+ */
+void mpmc_queue_dealloc(mpmc_queue **queue) {
+    allocator_free((*queue)->allocator, *queue, sizeof(mpmc_queue));
+    *queue = NULL;
+}
+
+/**
+ * Deinitializes an MPMC queue and then deallocates it.
+ * @param queue A pointer to an MPMC queue pointer.
+ */
+void mpmc_queue_delete(mpmc_queue **queue) {
+    mpmc_queue_deinit(*queue);
+    mpmc_queue_dealloc(queue);
+}
+
+/* Accessing */
+
+/**
+ * Returns the number of values in an MPMC queue.
+ * While other threads push or pop this is only a snapshot.
+ * @param queue A pointer to the MPMC queue.
+ * @return The number of values.
+ */
+size_t mpmc_queue_length(mpmc_queue *queue) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+    return tail > head ? tail - head : 0;
+}
+
+/**
+ * Returns the number of values an MPMC queue can hold.
+ * @param queue A pointer to the MPMC queue.
+ * @return The capacity.
+ */
+size_t mpmc_queue_capacity(mpmc_queue *queue) {
+    return queue->slots == NULL ? 0 : queue->mask + 1;
+}
+
+/* Mutation */
+
+/**
+ * Pushes a value onto the back of the MPMC queue if there is room. Safe to call from any thread.
+ * @param queue A pointer to the MPMC queue.
+ * @param value The value to push.
+ * @return false if the queue was full.
+ */
+bool mpmc_queue_try_push(mpmc_queue *queue, int value) {
+    size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    mpmc_queue_slot *slot;
+
+    while (true) {
+        slot = &queue->slots[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot still holds the value from the last lap
+            return false;
+        } else {
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+
+    slot->data = value;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    wake_waiters(&queue->pushes, &queue->pop_waiters);
+
+    return true;
+}
+
+/**
+ * Removes the value at the front of the MPMC queue if there is one. Safe to call from any thread.
+ * @param queue A pointer to the MPMC queue.
+ * @param value Set to the removed value.
+ * @return false if the queue was empty.
+ */
+bool mpmc_queue_try_pop(mpmc_queue *queue, int *value) {
+    size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    mpmc_queue_slot *slot;
+
+    while (true) {
+        slot = &queue->slots[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot hasn't been filled in this lap
+            return false;
+        } else {
+            position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+
+    *value = slot->data;
+
+    // Free the slot for the push one lap later
+    atomic_store_explicit(&slot->sequence, position + queue->mask + 1, memory_order_release);
+    wake_waiters(&queue->pops, &queue->push_waiters);
+
+    return true;
+}
+
+/**
+ * Pushes a value onto the back of the MPMC queue, sleeping while it is full.
+ * @param queue A pointer to the MPMC queue.
+ * @param value The value to push.
+ */
+void mpmc_queue_push(mpmc_queue *queue, int value) {
+    if (!mpmc_queue_try_push(queue, value)) {
+        wait_on(queue, &queue->pops, &queue->push_waiters, attempt_push, &value);
+    }
+}
+
+/**
+ * Removes the value at the front of the MPMC queue, sleeping while it is empty.
+ * @param queue A pointer to the MPMC queue.
+ * @return The value removed from the queue.
+ */
+int mpmc_queue_pop(mpmc_queue *queue) {
+    int value;
+
+    if (!mpmc_queue_try_pop(queue, &value)) {
+        wait_on(queue, &queue->pushes, &queue->pop_waiters, attempt_pop, &value);
+    }
+
+    return value;
+}
+
+/**
+ * Pushes as many values of an array as there is room for with one claim on the tail.
+ * Safe to call from any thread. The values stay in order and contiguous in the queue.
+ * Like mpmc_queue_try_push it never waits, slots still being popped by other threads end the batch.
+ * @param queue A pointer to the MPMC queue.
+ * @param values The values to push.
+ * @param count The number of values.
+ * @return The number of values pushed, from the start of the array.
+ */
+size_t mpmc_queue_try_push_all(mpmc_queue *queue, const int *values, size_t count) {
+    size_t position;
+    size_t claimed = slots_claim(queue, &queue->tail, false, count, &position);
+
+    if (claimed == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < claimed; i++) {
+        mpmc_queue_slot *slot = &queue->slots[(position + i) & queue->mask];
+        slot->data = values[i];
+        atomic_store_explicit(&slot->sequence, position + i + 1, memory_order_release);
+    }
+
+    wake_waiters(&queue->pushes, &queue->pop_waiters);
+
+    return claimed;
+}
+
+/**
+ * Pops up to a number of values with one claim on the head. Safe to call from any thread.
+ * Like mpmc_queue_try_pop it never waits, slots still being pushed by other threads end the batch.
+ * @param queue A pointer to the MPMC queue.
+ * @param values Filled with the removed values, in queue order.
+ * @param count The most values to remove.
+ * @return The number of values removed.
+ */
+size_t mpmc_queue_try_pop_all(mpmc_queue *queue, int *values, size_t count) {
+    size_t position;
+    size_t claimed = slots_claim(queue, &queue->head, true, count, &position);
+
+    if (claimed == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < claimed; i++) {
+        mpmc_queue_slot *slot = &queue->slots[(position + i) & queue->mask];
+        values[i] = slot->data;
+        atomic_store_explicit(&slot->sequence, position + i + queue->mask + 1, memory_order_release);
+    }
+
+    wake_waiters(&queue->pops, &queue->push_waiters);
+
+    return claimed;
+}
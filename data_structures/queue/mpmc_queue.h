@@ -0,0 +1,69 @@
+//
+// Created by Christopher Szatmary on 2018-12-30.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_MPMC_QUEUE_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_MPMC_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../../utils/allocator.h"
+
+// Keeps the ends of the queue and the wait words on separate cache lines
+#define MPMC_QUEUE_LINE 64
+
+typedef struct {
+    _Atomic size_t sequence;
+    int data;
+} mpmc_queue_slot;
+
+/**
+ * A bounded queue any number of threads can push to and pop from, in the style of Vyukov.
+ * The values live in a ring of slots allocated once. Each slot has a sequence number telling
+ * whether it is free for the push of a given lap or holds the value for the pop of that lap,
+ * so threads claim positions with a single compare and swap and never touch each other's slots.
+ * The blocking operations sleep on a futex while the queue is full or empty. Threads that
+ * don't block pay for them with a fence and a read of the waiter count.
+ */
+typedef struct {
+    mpmc_queue_slot *slots;
+    size_t mask;
+    const allocator *allocator;
+    char slots_padding[MPMC_QUEUE_LINE - sizeof(void *) - sizeof(size_t) - sizeof(void *)];
+    _Atomic size_t tail;
+    char tail_padding[MPMC_QUEUE_LINE - sizeof(size_t)];
+    _Atomic size_t head;
+    char head_padding[MPMC_QUEUE_LINE - sizeof(size_t)];
+    _Atomic uint32_t pushes;
+    _Atomic uint32_t pop_waiters;
+    char pushes_padding[MPMC_QUEUE_LINE - 2 * sizeof(uint32_t)];
+    _Atomic uint32_t pops;
+    _Atomic uint32_t push_waiters;
+} mpmc_queue;
+
+// Construction
+mpmc_queue *mpmc_queue_alloc();
+mpmc_queue *mpmc_queue_alloc_with(const allocator *allocator);
+int mpmc_queue_init(mpmc_queue *queue, size_t capacity);
+mpmc_queue *mpmc_queue_new(size_t capacity);
+
+// Deletion
+void mpmc_queue_deinit(mpmc_queue *queue);
+void mpmc_queue_dealloc(mpmc_queue **queue);
+void mpmc_queue_delete(mpmc_queue **queue);
+
+// Accessing
+size_t mpmc_queue_length(mpmc_queue *queue);
+size_t mpmc_queue_capacity(mpmc_queue *queue);
+
+// Mutation
+bool mpmc_queue_try_push(mpmc_queue *queue, int value);
+bool mpmc_queue_try_pop(mpmc_queue *queue, int *value);
+void mpmc_queue_push(mpmc_queue *queue, int value);
+int mpmc_queue_pop(mpmc_queue *queue);
+size_t mpmc_queue_try_push_all(mpmc_queue *queue, const int *values, size_t count);
+size_t mpmc_queue_try_pop_all(mpmc_queue *queue, int *values, size_t count);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_MPMC_QUEUE_H
@@ -0,0 +1,437 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#include <stdlib.h>
+#include <errno.h>
+#include "rcu_list.h"
+#include "../../utils/error.h"
+
+/* Helpers */
+
+/**
+ * Allocates a node that isn't visible to readers yet.
+ * @param list A pointer to the RCU list.
+ * @param value The value of the node.
+ * @param next A pointer to the node to follow it.
+ * @return A pointer to the node, or NULL if it couldn't be allocated.
+ */
+static rcu_list_node *node_alloc(rcu_list *list, int value, rcu_list_node *next) {
+    rcu_list_node *node = allocator_alloc(list->allocator, sizeof(rcu_list_node));
+
+    if (node != NULL) {
+        node->data = value;
+        atomic_init(&node->next, next);
+    }
+
+    return node;
+}
+
+/**
+ * Finds the node before an index. Only called by writers holding the write lock.
+ * @param list A pointer to the RCU list.
+ * @param index The index, which must be within the list or just past its end.
+ * @return A pointer to the node before the index, or NULL for index 0.
+ */
+static rcu_list_node *node_before(rcu_list *list, size_t index) {
+    if (index == 0) {
+        return NULL;
+    }
+    if (index == atomic_load_explicit(&list->length, memory_order_relaxed)) {
+        return list->tail;
+    }
+
+    rcu_list_node *node = atomic_load_explicit(&list->head, memory_order_relaxed);
+    for (size_t i = 1; i < index; i++) {
+        node = atomic_load_explicit(&node->next, memory_order_relaxed);
+    }
+
+    return node;
+}
+
+/**
+ * Gets the link that points to the node after another one.
+ * @param list A pointer to the RCU list.
+ * @param previous A pointer to a node, or NULL for the head of the list.
+ * @return A pointer to the link.
+ */
+static _Atomic(rcu_list_node *) *link_after(rcu_list *list, rcu_list_node *previous) {
+    return previous == NULL ? &list->head : &previous->next;
+}
+
+/**
+ * Converts an index that may count from the end of the list and checks it.
+ * @param list A pointer to the RCU list.
+ * @param index The index, negative indexes count from the end.
+ * @param allow_end Whether the index just past the last node is valid.
+ * @return The index counted from the head.
+ */
+static size_t real_index(rcu_list *list, int index, bool allow_end) {
+    int list_length = (int)atomic_load_explicit(&list->length, memory_order_relaxed);
+    int real = index < 0 ? list_length + index : index;
+
+    // Ensure that a valid index was given.
+    if (real < 0 || real > list_length - (allow_end ? 0 : 1)) {
+        pthread_mutex_unlock(&list->write_lock);
+        fatal_error_print(INVALID_INDEX, "Index out of range\n");
+    }
+
+    return (size_t)real;
+}
+
+/**
+ * Links a new node in at a position. Only called by writers holding the write lock.
+ * The node is complete before the release store that makes it reachable.
+ * @param list A pointer to the RCU list.
+ * @param value The value of the new node.
+ * @param position The position of the new node, at most the length of the list.
+ * @return An integer indicating the status.
+ */
+static int node_insert(rcu_list *list, int value, size_t position) {
+    rcu_list_node *previous = node_before(list, position);
+    _Atomic(rcu_list_node *) *link = link_after(list, previous);
+
+    rcu_list_node *node = node_alloc(list, value, atomic_load_explicit(link, memory_order_relaxed));
+    if (node == NULL) {
+        return ENOMEM;
+    }
+
+    atomic_store_explicit(link, node, memory_order_release);
+    if (previous == list->tail) {
+        list->tail = node;
+    }
+    atomic_fetch_add_explicit(&list->length, 1, memory_order_relaxed);
+
+    return EXIT_SUCCESS;
+}
+
+/* Construction */
+
+/**
+ * Allocates an RCU list.
+ * @return A pointer to the allocated RCU list.
+ */
+rcu_list *rcu_list_alloc() {
+    return rcu_list_alloc_with(NULL);
+}
+
+/**
+ * Allocates an RCU list whose memory comes from the given allocator.
+ * Writers allocate and free nodes one at a time under the write lock.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated RCU list.
+ */
+rcu_list *rcu_list_alloc_with(const allocator *allocator) {
+    rcu_list *list = allocator_alloc(allocator, sizeof(rcu_list));
+
+    if (list != NULL) {
+        atomic_init(&list->head, NULL);
+        list->tail = NULL;
+        atomic_init(&list->length, 0);
+        pthread_mutex_init(&list->write_lock, NULL);
+        epoch_init(&list->epoch, allocator);
+        list->allocator = allocator;
+    }
+
+    return list;
+}
+
+/**
+ * Initializes an RCU list using an array.
+ * @param list A pointer to the list to initialize.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return An integer indicating the status.
+ */
+int rcu_list_init(rcu_list *list, int *values, size_t length) {
+    // Just return if no elements in the array
+    if (length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // Abort if the list isn't empty
+    if (atomic_load(&list->head) != NULL) {
+        return LIST_NOT_EMPTY;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (rcu_list_append(list, values[i]) == ENOMEM) {
+            return ENOMEM;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Allocates and initializes an RCU list using an array.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return A pointer to the newly created RCU list.
+ */
+rcu_list *rcu_list_new(int *values, size_t length) {
+    rcu_list *list = rcu_list_alloc();
+    rcu_list_init(list, values, length);
+    return list;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes an RCU list and deallocates every node, including retired ones.
+ * Must not run while other threads use the list.
+ * @param list A pointer to the list to deinitialize.
+ */
+void rcu_list_deinit(rcu_list *list) {
+    rcu_list_node *node = atomic_load(&list->head);
+
+    while (node != NULL) {
+        rcu_list_node *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+        allocator_free(list->allocator, node, sizeof(rcu_list_node));
+        node = next;
+    }
+
+    epoch_release(&list->epoch);
+    atomic_store(&list->head, NULL);
+    list->tail = NULL;
+    atomic_store(&list->length, 0);
+}
+
+/**
+ * Deallocates the given RCU list pointer.
+ * @param list A pointer to an RCU list pointer.
+ */
+void rcu_list_dealloc(rcu_list **list) {
+    pthread_mutex_destroy(&(*list)->write_lock);
+    allocator_free((*list)->allocator, *list, sizeof(rcu_list));
+    *list = NULL;
+}
+
+/**
+ * Deinitializes an RCU list and then deallocates it.
+ * @param list A pointer to an RCU list pointer.
+ */
+void rcu_list_delete(rcu_list **list) {
+    rcu_list_deinit(*list);
+    rcu_list_dealloc(list);
+}
+
+/* Reading */
+
+/**
+ * Registers the calling thread as a reader of an RCU list.
+ * @param list A pointer to the RCU list.
+ * @return A pointer to the reader, or NULL if EPOCH_MAX_READERS threads are already registered.
+ */
+epoch_reader *rcu_list_reader_register(rcu_list *list) {
+    return epoch_register(&list->epoch);
+}
+
+/**
+ * Gives up a reader of an RCU list.
+ * @param reader A pointer to the reader.
+ */
+void rcu_list_reader_unregister(epoch_reader *reader) {
+    epoch_unregister(reader);
+}
+
+/**
+ * Starts a read section. Nodes read until rcu_list_read_unlock stay valid,
+ * even if writers remove them in the meantime.
+ * @param list A pointer to the RCU list.
+ * @param reader A pointer to the calling thread's reader.
+ */
+void rcu_list_read_lock(rcu_list *list, epoch_reader *reader) {
+    epoch_enter(&list->epoch, reader);
+}
+
+/**
+ * Ends a read section.
+ * @param reader A pointer to the calling thread's reader.
+ */
+void rcu_list_read_unlock(epoch_reader *reader) {
+    epoch_exit(reader);
+}
+
+/* Accessing */
+
+/**
+ * Returns the number of nodes in an RCU list.
+ * While writers change the list this is only a snapshot.
+ * @param list A pointer to the RCU list.
+ * @return The number of nodes.
+ */
+size_t rcu_list_length(rcu_list *list) {
+    return atomic_load_explicit(&list->length, memory_order_relaxed);
+}
+
+/**
+ * Retrieves the first element in the RCU list. Must be called in a read section.
+ * @param list A pointer to the RCU list.
+ * @return The first element in the list.
+ */
+int rcu_list_first(rcu_list *list) {
+    rcu_list_node *head = rcu_list_head(list);
+
+    if (head == NULL) {
+        fatal_error_print(LIST_EMPTY, "Can't get first element from empty list");
+    }
+
+    return head->data;
+}
+
+/**
+ * Retrieves the element at an index in the RCU list. Must be called in a read section.
+ * @param list A pointer to the RCU list.
+ * @param index The index of the element, counted from the head.
+ * @return The element at that index.
+ */
+int rcu_list_element(rcu_list *list, int index) {
+    rcu_list_node *node = rcu_list_head(list);
+
+    for (int i = 0; i < index && node != NULL; i++) {
+        node = rcu_list_next(node);
+    }
+
+    // Ensure that a valid index was given.
+    if (index < 0 || node == NULL) {
+        fatal_error_print(INVALID_INDEX, "Index out of range\n");
+    }
+
+    return node->data;
+}
+
+/**
+ * Checks whether an RCU list contains a value. Must be called in a read section.
+ * @param list A pointer to the RCU list.
+ * @param value The value to search for.
+ * @return true if a node holds the value.
+ */
+bool rcu_list_contains(rcu_list *list, int value) {
+    for (rcu_list_node *node = rcu_list_head(list); node != NULL; node = rcu_list_next(node)) {
+        if (node->data == value) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Mutation */
+
+/**
+ * Adds a value to the end of an RCU list. Safe to call from any thread.
+ * @param list A pointer to the RCU list.
+ * @param value The value to add.
+ * @return An integer indicating the status.
+ */
+int rcu_list_append(rcu_list *list, int value) {
+    pthread_mutex_lock(&list->write_lock);
+    int status = node_insert(list, value, atomic_load_explicit(&list->length, memory_order_relaxed));
+    pthread_mutex_unlock(&list->write_lock);
+
+    return status;
+}
+
+/**
+ * Adds a value to the front of an RCU list. Safe to call from any thread.
+ * @param list A pointer to the RCU list.
+ * @param value The value to add.
+ * @return An integer indicating the status.
+ */
+int rcu_list_prepend(rcu_list *list, int value) {
+    pthread_mutex_lock(&list->write_lock);
+    int status = node_insert(list, value, 0);
+    pthread_mutex_unlock(&list->write_lock);
+
+    return status;
+}
+
+/**
+ * Inserts a value at an index of an RCU list. Safe to call from any thread.
+ * @param list A pointer to the RCU list.
+ * @param value The value to insert.
+ * @param index The index of the new node, negative indexes count from the end.
+ * @return An integer indicating the status.
+ */
+int rcu_list_insert(rcu_list *list, int value, int index) {
+    pthread_mutex_lock(&list->write_lock);
+    int status = node_insert(list, value, real_index(list, index, true));
+    pthread_mutex_unlock(&list->write_lock);
+
+    return status;
+}
+
+/**
+ * Replaces the element at an index of an RCU list. Safe to call from any thread.
+ * The node is replaced by an updated copy, so readers on the old node still see its old value.
+ * @param list A pointer to the RCU list.
+ * @param index The index of the element, negative indexes count from the end.
+ * @param value The new value.
+ * @return An integer indicating the status.
+ */
+int rcu_list_set(rcu_list *list, int index, int value) {
+    pthread_mutex_lock(&list->write_lock);
+
+    size_t position = real_index(list, index, false);
+    rcu_list_node *previous = node_before(list, position);
+    _Atomic(rcu_list_node *) *link = link_after(list, previous);
+    rcu_list_node *old = atomic_load_explicit(link, memory_order_relaxed);
+
+    rcu_list_node *copy = node_alloc(list, value, atomic_load_explicit(&old->next, memory_order_relaxed));
+    if (copy == NULL) {
+        pthread_mutex_unlock(&list->write_lock);
+        return ENOMEM;
+    }
+
+    atomic_store_explicit(link, copy, memory_order_release);
+    if (list->tail == old) {
+        list->tail = copy;
+    }
+    epoch_retire(&list->epoch, old, sizeof(rcu_list_node));
+
+    pthread_mutex_unlock(&list->write_lock);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Removes the node at an index of an RCU list and returns its value. Safe to call from any thread.
+ * The node is freed once no reader can still be on it.
+ * @param list A pointer to the RCU list.
+ * @param index The index of the node, negative indexes count from the end.
+ * @return The value removed from the list.
+ */
+int rcu_list_remove(rcu_list *list, int index) {
+    pthread_mutex_lock(&list->write_lock);
+
+    size_t position = real_index(list, index, false);
+    rcu_list_node *previous = node_before(list, position);
+    _Atomic(rcu_list_node *) *link = link_after(list, previous);
+    rcu_list_node *old = atomic_load_explicit(link, memory_order_relaxed);
+
+    // Readers already on the old node can still follow it back into the list
+    atomic_store_explicit(link, atomic_load_explicit(&old->next, memory_order_relaxed), memory_order_release);
+    if (list->tail == old) {
+        list->tail = previous;
+    }
+    atomic_fetch_sub_explicit(&list->length, 1, memory_order_relaxed);
+
+    int value = old->data;
+    epoch_retire(&list->epoch, old, sizeof(rcu_list_node));
+
+    pthread_mutex_unlock(&list->write_lock);
+
+    return value;
+}
+
+/**
+ * Waits until every read section that started before the call has ended and frees
+ * every removed node. Must not be called from inside a read section.
+ * @param list A pointer to the RCU list.
+ */
+void rcu_list_synchronize(rcu_list *list) {
+    pthread_mutex_lock(&list->write_lock);
+    epoch_synchronize(&list->epoch);
+    pthread_mutex_unlock(&list->write_lock);
+}
@@ -0,0 +1,86 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_RCU_LIST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_RCU_LIST_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "../../utils/allocator.h"
+#include "../../utils/epoch.h"
+
+typedef struct rcu_list_node {
+    int data;
+    _Atomic(struct rcu_list_node *) next;
+} rcu_list_node;
+
+/**
+ * A singly linked list for read mostly workloads, in the style of read-copy-update.
+ * Readers walk the list inside a read section without taking locks or writing shared memory.
+ * Writers take a mutex, build new nodes off to the side and publish them with a release store,
+ * so readers see either the old or the new list. A node is never modified once published,
+ * rcu_list_set replaces it with a copy. Unlinked nodes are retired to an epoch domain
+ * and freed once every reader that could still see them has left its read section.
+ */
+typedef struct {
+    _Atomic(rcu_list_node *) head;
+    rcu_list_node *tail;
+    _Atomic size_t length;
+    pthread_mutex_t write_lock;
+    epoch_domain epoch;
+    const allocator *allocator;
+} rcu_list;
+
+// Construction
+rcu_list *rcu_list_alloc();
+rcu_list *rcu_list_alloc_with(const allocator *allocator);
+int rcu_list_init(rcu_list *list, int *values, size_t length);
+rcu_list *rcu_list_new(int *values, size_t length);
+
+// Deletion
+void rcu_list_deinit(rcu_list *list);
+void rcu_list_dealloc(rcu_list **list);
+void rcu_list_delete(rcu_list **list);
+
+// Reading
+epoch_reader *rcu_list_reader_register(rcu_list *list);
+void rcu_list_reader_unregister(epoch_reader *reader);
+void rcu_list_read_lock(rcu_list *list, epoch_reader *reader);
+void rcu_list_read_unlock(epoch_reader *reader);
+
+// Accessing
+size_t rcu_list_length(rcu_list *list);
+int rcu_list_first(rcu_list *list);
+int rcu_list_element(rcu_list *list, int index);
+bool rcu_list_contains(rcu_list *list, int value);
+
+// Mutation
+int rcu_list_append(rcu_list *list, int value);
+int rcu_list_prepend(rcu_list *list, int value);
+int rcu_list_insert(rcu_list *list, int value, int index);
+int rcu_list_set(rcu_list *list, int index, int value);
+int rcu_list_remove(rcu_list *list, int index);
+void rcu_list_synchronize(rcu_list *list);
+
+/**
+ * Returns the first node of an RCU list. Must be called in a read section.
+ * Inline since readers call it for every node they visit.
+ * @param list A pointer to the RCU list.
+ * @return A pointer to the first node, or NULL if the list is empty.
+ */
+static inline rcu_list_node *rcu_list_head(rcu_list *list) {
+    return atomic_load_explicit(&list->head, memory_order_acquire);
+}
+
+/**
+ * Returns the node after another one. Must be called in a read section.
+ * @param node A pointer to a node.
+ * @return A pointer to the next node, or NULL at the end of the list.
+ */
+static inline rcu_list_node *rcu_list_next(rcu_list_node *node) {
+    return atomic_load_explicit(&node->next, memory_order_acquire);
+}
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_RCU_LIST_H
@@ -3,14 +3,29 @@
 //
 
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
+#include <unistd.h>
 #include "array_stack.h"
 #include "../../utils/error.h"
+#include "../../utils/instrument.h"
+#include "../../utils/int_reader.h"
 
 #define AUTOMATIC 0
 
 /* Helpers */
 
+/**
+ * Pushes a batch of integers parsed by the int reader onto an array stack.
+ * @param context A pointer to the array stack.
+ * @param values The integers to push.
+ * @param count The number of integers.
+ * @return An integer indicating the status.
+ */
+static int push_all_sink(void *context, const int *values, size_t count) {
+    return array_stack_push_all(context, values, count);
+}
+
 /**
  * Re-sizes the given array stack to the desired capacity.
  * @param stack A pointer to the array stack.
@@ -18,12 +33,42 @@
  * @return An integer indicating the status.
  */
 static int resize_stack(array_stack *stack, size_t capacity) {
-    int *new_data = realloc(stack->data, capacity * sizeof(int));
+    // Data loaded from a snapshot lives in a file mapping, so move it to the allocator
+    if (stack->mapping.address != NULL) {
+        int *copy = allocator_alloc(stack->allocator, capacity * sizeof(int));
+
+        if (copy == NULL) {
+            return ENOMEM;
+        }
+
+        size_t kept = stack->length < capacity ? stack->length : capacity;
+        memcpy(copy, stack->data, kept * sizeof(int));
+        snapshot_unmap(&stack->mapping);
+        INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_ALLOCS, 1);
+        INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_BYTES_MOVED, kept * sizeof(int));
+        INSTRUMENT_MEMORY(INSTRUMENT_ARRAY_STACK, (int64_t)(capacity * sizeof(int)));
+        stack->data = copy;
+        stack->capacity = capacity;
+
+        return EXIT_SUCCESS;
+    }
+
+    int *new_data = allocator_realloc(stack->allocator, stack->data, stack->capacity * sizeof(int), capacity * sizeof(int));
 
     if (new_data == NULL) {
         return ENOMEM;
     }
 
+    // Count the bytes realloc has to copy if it can't resize in place
+    if (stack->data == NULL) {
+        INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_ALLOCS, 1);
+    } else {
+        INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_REALLOCS, 1);
+        INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_BYTES_MOVED,
+                       (stack->length < capacity ? stack->length : capacity) * sizeof(int));
+    }
+    INSTRUMENT_MEMORY(INSTRUMENT_ARRAY_STACK, ((int64_t)capacity - (int64_t)stack->capacity) * (int64_t)sizeof(int));
+
     stack->data = new_data;
     stack->capacity = capacity;
 
@@ -33,8 +78,8 @@ static int resize_stack(array_stack *stack, size_t capacity) {
 /**
  * Increases the capacity of the given array stack.
  * @param stack A pointer to the array stack.
- * @param capacity The new size of the stack.
- * If AUTOMATIC the new capacity will be double to current capacity.
+ * @param capacity The new size of the stack, rounded up to the granularity of the stack's growth policy.
+ * If AUTOMATIC the stack's growth policy picks the new capacity.
  * @return An integer indicating the status.
  */
 static int increase_stack_capacity(array_stack *stack, size_t capacity) {
@@ -44,9 +89,9 @@ static int increase_stack_capacity(array_stack *stack, size_t capacity) {
 
     size_t actual_capacity;
     if (capacity == AUTOMATIC) {
-        actual_capacity = stack->capacity == 0 ? 2 : stack->capacity * 2;
+        actual_capacity = stack->growth.grow(&stack->growth, stack->capacity, stack->capacity + 1);
     } else {
-        actual_capacity = capacity % 2 == 0 ? capacity : capacity + 1;
+        actual_capacity = growth_policy_round(&stack->growth, capacity);
     }
 
     return resize_stack(stack, actual_capacity);
@@ -59,12 +104,34 @@ static int increase_stack_capacity(array_stack *stack, size_t capacity) {
  * @return A pointer to the allocated list stack.
  */
 array_stack *array_stack_alloc() {
-    array_stack *stack = malloc(sizeof(array_stack));
+    return array_stack_alloc_with(NULL);
+}
+
+/**
+ * Allocates an array stack whose memory comes from the given allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated array stack.
+ */
+array_stack *array_stack_alloc_with(const allocator *allocator) {
+    return array_stack_alloc_with_policy(allocator, NULL);
+}
+
+/**
+ * Allocates an array stack that grows according to the given policy.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @param policy A pointer to the growth policy, which is copied, or NULL to double the capacity.
+ * @return A pointer to the allocated array stack.
+ */
+array_stack *array_stack_alloc_with_policy(const allocator *allocator, const growth_policy *policy) {
+    array_stack *stack = allocator_alloc(allocator, sizeof(array_stack));
 
     if (stack != NULL) {
         stack->data = NULL;
         stack->length = 0;
         stack->capacity = 0;
+        stack->allocator = allocator;
+        stack->growth = policy != NULL ? *policy : growth_policy_doubling();
+        stack->mapping.address = NULL;
     }
 
     return stack;
@@ -88,13 +155,16 @@ int array_stack_init(array_stack *stack, int *values, size_t length) {
         return LIST_NOT_EMPTY;
     }
 
-    int *data = malloc(length * sizeof(int));
+    int *data = allocator_alloc(stack->allocator, length * sizeof(int));
 
     // Ensure that the array was allocated
     if (data == NULL) {
         return ENOMEM;
     }
 
+    INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_ALLOCS, 1);
+    INSTRUMENT_MEMORY(INSTRUMENT_ARRAY_STACK, (int64_t)(length * sizeof(int)));
+
     for (size_t i = 0; i < length; i++) {
         data[i] = values[i];
     }
@@ -118,6 +188,53 @@ array_stack *array_stack_new(int *values, size_t length) {
     return stack;
 }
 
+/* Snapshots */
+
+/**
+ * Saves the contents of an array stack to a snapshot file.
+ * @param stack A pointer to the array stack.
+ * @param path The path of the file, which is replaced if it exists.
+ * @return An integer indicating the status.
+ */
+int array_stack_save(array_stack *stack, const char *path) {
+    return snapshot_save(path, stack->data, stack->length);
+}
+
+/**
+ * Initializes an empty array stack from a snapshot file without copying it.
+ * The file is mapped copy-on-write and used as the data array, so loading is O(1)
+ * unless verify is set. The spare room in the last page of the mapping is used as capacity,
+ * the data moves to the allocator the first time the stack grows past it.
+ * @param stack A pointer to the array stack to initialize.
+ * @param path The path of a file written by array_stack_save.
+ * @param verify Whether to check the contents against the checksum, which reads all of them.
+ * @return An integer indicating the status, INVALID_SNAPSHOT if the file isn't a valid snapshot.
+ */
+int array_stack_load(array_stack *stack, const char *path, bool verify) {
+    // Abort if the stack isn't empty
+    if (stack->length > 0) {
+        return LIST_NOT_EMPTY;
+    }
+
+    snapshot_mapping mapping;
+    int status = snapshot_map(&mapping, path, verify);
+    if (status != EXIT_SUCCESS) {
+        return status;
+    }
+
+    array_stack_deinit(stack);
+
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapped_size = (mapping.size + page_size - 1) / page_size * page_size;
+
+    stack->mapping = mapping;
+    stack->data = mapping.data;
+    stack->length = mapping.length;
+    stack->capacity = (mapped_size - sizeof(snapshot_header)) / sizeof(int);
+
+    return EXIT_SUCCESS;
+}
+
 /* Deletion */
 
 /**
@@ -125,7 +242,13 @@ array_stack *array_stack_new(int *values, size_t length) {
  * @param stack A pointer to the stack to deinitialize.
  */
 void array_stack_deinit(array_stack *stack) {
-    free(stack->data);
+    if (stack->mapping.address != NULL) {
+        snapshot_unmap(&stack->mapping);
+    } else if (stack->data != NULL) {
+        allocator_free(stack->allocator, stack->data, stack->capacity * sizeof(int));
+        INSTRUMENT_ADD(INSTRUMENT_ARRAY_STACK, INSTRUMENT_FREES, 1);
+        INSTRUMENT_MEMORY(INSTRUMENT_ARRAY_STACK, -(int64_t)(stack->capacity * sizeof(int)));
+    }
     stack->data = NULL;
     stack->length = 0;
     stack->capacity = 0;
@@ -136,7 +259,7 @@ void array_stack_deinit(array_stack *stack) {
  * @param stack A pointer to an array stack pointer.
  */
 void array_stack_dealloc(array_stack **stack) {
-    free(*stack);
+    allocator_free((*stack)->allocator, *stack, sizeof(array_stack));
     *stack = NULL;
 }
 
@@ -190,6 +313,75 @@ int array_stack_peak(array_stack *stack) {
     return stack->data[stack->length - 1];
 }
 
+/**
+ * Reports how the memory held by an array stack is spent.
+ * Capacity beyond the length counts as slack.
+ * @param stack A pointer to the array stack.
+ * @return The memory usage of the stack.
+ */
+memory_usage array_stack_memory_usage(array_stack *stack) {
+    memory_usage usage = {
+        stack->length * sizeof(int),
+        sizeof(array_stack),
+        (stack->capacity - stack->length) * sizeof(int)
+    };
+
+    // Data loaded from a snapshot is file backed rather than allocated
+    if (stack->data != NULL && stack->mapping.address == NULL) {
+        usage.slack += allocator_slack(stack->allocator, stack->data, stack->capacity * sizeof(int));
+    }
+
+    return usage;
+}
+
+/**
+ * Writes the contents of an array stack to an output buffer, from the bottom to the top,
+ * in the form [1, 2, 3].
+ * @param stack A pointer to the array stack.
+ * @param out A pointer to an output buffer writing to a stream, file descriptor or memory.
+ */
+void array_stack_format(array_stack *stack, output_buffer *out) {
+    output_buffer_write(out, "[", 1);
+
+    for (size_t i = 0; i < stack->length; i++) {
+        if (i > 0) {
+            output_buffer_write(out, ", ", 2);
+        }
+        output_buffer_write_int(out, stack->data[i]);
+    }
+
+    output_buffer_write(out, "]", 1);
+}
+
+/**
+ * Prints the contents of an array stack to a stream, from the bottom to the top.
+ * The text is formatted into a buffer and written in large chunks.
+ * @param stack A pointer to the array stack.
+ * @param file The stream to print to.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ * @return An integer indicating the status.
+ */
+int array_stack_fprint(array_stack *stack, FILE *file, bool new_line) {
+    output_buffer out;
+    output_buffer_init_file(&out, file);
+    array_stack_format(stack, &out);
+
+    if (new_line) {
+        output_buffer_write(&out, "\n", 1);
+    }
+
+    return output_buffer_flush(&out);
+}
+
+/**
+ * Prints the contents of an array stack, from the bottom to the top.
+ * @param stack A pointer to the array stack.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ */
+void array_stack_print(array_stack *stack, bool new_line) {
+    array_stack_fprint(stack, stdout, new_line);
+}
+
 /* Mutation */
 
 /**
@@ -227,3 +419,36 @@ int array_stack_pop(array_stack *stack) {
     return data;
 }
 
+/**
+ * Pushes every value of an array onto the array stack, the last value ending up on top.
+ * The capacity is grown as far as needed up front, so the data is moved at most once.
+ * @param stack A pointer to the array stack.
+ * @param values The values to push.
+ * @param count The number of values.
+ * @return An integer indicating the status.
+ */
+int array_stack_push_all(array_stack *stack, const int *values, size_t count) {
+    if (stack->length + count > stack->capacity) {
+        size_t capacity = stack->growth.grow(&stack->growth, stack->capacity, stack->length + count);
+
+        if (resize_stack(stack, capacity) == ENOMEM) {
+            return ENOMEM;
+        }
+    }
+
+    memcpy(stack->data + stack->length, values, count * sizeof(int));
+    stack->length += count;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Pushes every integer in a text file onto the array stack, in the order they appear.
+ * The file is streamed in chunks, see int_reader_read_path for the format.
+ * @param stack A pointer to the array stack.
+ * @param path The path of the file.
+ * @return An integer indicating the status. Integers read before an error stay on the stack.
+ */
+int array_stack_read(array_stack *stack, const char *path) {
+    return int_reader_read_path(path, push_all_sink, stack);
+}
@@ -5,17 +5,32 @@
 #ifndef DATA_STRUCTURES_AND_ALGORITHMS_ARRAY_STACK_H
 #define DATA_STRUCTURES_AND_ALGORITHMS_ARRAY_STACK_H
 
+#include <stdbool.h>
+#include "../../utils/allocator.h"
+#include "../../utils/growth_policy.h"
+#include "../../utils/output_buffer.h"
+#include "../../utils/snapshot.h"
+
 typedef struct {
     int *data;
     size_t length;
     size_t capacity;
+    const allocator *allocator;
+    growth_policy growth;
+    snapshot_mapping mapping;
 } array_stack;
 
 // Construction
 array_stack *array_stack_alloc();
+array_stack *array_stack_alloc_with(const allocator *allocator);
+array_stack *array_stack_alloc_with_policy(const allocator *allocator, const growth_policy *policy);
 int array_stack_init(array_stack *stack, int *values, size_t length);
 array_stack *array_stack_new(int *values, size_t length);
 
+// Snapshots
+int array_stack_save(array_stack *stack, const char *path);
+int array_stack_load(array_stack *stack, const char *path, bool verify);
+
 // Deletion
 void array_stack_deinit(array_stack *stack);
 void array_stack_dealloc(array_stack **stack);
@@ -27,9 +42,15 @@ int array_stack_clean_up(array_stack *stack);
 
 // Accessing
 int array_stack_peak(array_stack *stack);
+memory_usage array_stack_memory_usage(array_stack *stack);
+void array_stack_format(array_stack *stack, output_buffer *out);
+int array_stack_fprint(array_stack *stack, FILE *file, bool new_line);
+void array_stack_print(array_stack *stack, bool new_line);
 
 // Mutation
 int array_stack_push(array_stack *stack, int value);
 int array_stack_pop(array_stack *stack);
+int array_stack_push_all(array_stack *stack, const int *values, size_t count);
+int array_stack_read(array_stack *stack, const char *path);
 
 #endif //DATA_STRUCTURES_AND_ALGORITHMS_ARRAY_STACK_H
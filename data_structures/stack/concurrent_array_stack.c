@@ -0,0 +1,288 @@
+//
+// Created by Christopher Szatmary on 2018-12-26.
+//
+
+#include <stdlib.h>
+#include "concurrent_array_stack.h"
+#include "../../utils/error.h"
+
+// States of an elimination slot, kept above the value in the same word
+#define SLOT_EMPTY 0
+#define SLOT_OFFERED 1
+#define SLOT_TAKEN 2
+
+// How long a thread waits in a slot for a partner
+#define ELIMINATION_SPINS 64
+
+// Rounds of trying the mutex and the elimination array before waiting for the mutex
+#define LOCK_ATTEMPTS 8
+
+static _Thread_local uint32_t slot_seed;
+
+/* Helpers */
+
+static uint64_t slot_word(uint32_t state, int value) {
+    return (uint64_t)state << 32 | (uint32_t)value;
+}
+
+static uint32_t slot_state(uint64_t word) {
+    return (uint32_t)(word >> 32);
+}
+
+/**
+ * Picks an elimination slot at random, so threads spread out over the array.
+ * @param stack A pointer to the concurrent array stack.
+ * @return A pointer to the slot.
+ */
+static elimination_slot *slot_pick(concurrent_array_stack *stack) {
+    // Seed each thread differently, from the address of its own seed
+    if (slot_seed == 0) {
+        slot_seed = (uint32_t)(uintptr_t)&slot_seed | 1;
+    }
+
+    slot_seed ^= slot_seed << 13;
+    slot_seed ^= slot_seed >> 17;
+    slot_seed ^= slot_seed << 5;
+
+    return &stack->slots[slot_seed & (ELIMINATION_SLOTS - 1)];
+}
+
+/**
+ * Offers a value in an elimination slot and waits for a pop to take it.
+ * Only the pushing thread empties a slot it offered in, so a pop can't take a value twice.
+ * @param stack A pointer to the concurrent array stack.
+ * @param value The value to push.
+ * @return true if a pop took the value, false if it has to be pushed onto the array.
+ */
+static bool eliminate_push(concurrent_array_stack *stack, int value) {
+    elimination_slot *slot = slot_pick(stack);
+    uint64_t offer = slot_word(SLOT_OFFERED, value);
+    uint64_t expected = slot_word(SLOT_EMPTY, 0);
+
+    if (!atomic_compare_exchange_strong_explicit(&slot->exchange, &expected, offer,
+                                                 memory_order_acq_rel, memory_order_relaxed)) {
+        return false;
+    }
+
+    for (int i = 0; i < ELIMINATION_SPINS; i++) {
+        if (slot_state(atomic_load_explicit(&slot->exchange, memory_order_acquire)) == SLOT_TAKEN) {
+            atomic_store_explicit(&slot->exchange, slot_word(SLOT_EMPTY, 0), memory_order_release);
+            return true;
+        }
+    }
+
+    // Withdraw the offer, unless a pop took it in the meantime
+    if (atomic_compare_exchange_strong_explicit(&slot->exchange, &offer, slot_word(SLOT_EMPTY, 0),
+                                                memory_order_acq_rel, memory_order_acquire)) {
+        return false;
+    }
+
+    atomic_store_explicit(&slot->exchange, slot_word(SLOT_EMPTY, 0), memory_order_release);
+    return true;
+}
+
+/**
+ * Waits in an elimination slot for a push to offer a value and takes it.
+ * @param stack A pointer to the concurrent array stack.
+ * @param value Set to the value taken.
+ * @return true if a value was taken.
+ */
+static bool eliminate_pop(concurrent_array_stack *stack, int *value) {
+    elimination_slot *slot = slot_pick(stack);
+
+    for (int i = 0; i < ELIMINATION_SPINS; i++) {
+        uint64_t word = atomic_load_explicit(&slot->exchange, memory_order_acquire);
+
+        if (slot_state(word) == SLOT_OFFERED
+            && atomic_compare_exchange_strong_explicit(&slot->exchange, &word, slot_word(SLOT_TAKEN, 0),
+                                                       memory_order_acq_rel, memory_order_relaxed)) {
+            *value = (int)(uint32_t)word;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Takes the mutex of a concurrent array stack if it is free, or waits for it after enough attempts.
+ * @param stack A pointer to the concurrent array stack.
+ * @param attempt The number of times the calling operation has tried already.
+ * @return true if the mutex is now held.
+ */
+static bool lock_attempt(concurrent_array_stack *stack, int attempt) {
+    if (attempt >= LOCK_ATTEMPTS) {
+        return pthread_mutex_lock(&stack->lock) == 0;
+    }
+
+    return pthread_mutex_trylock(&stack->lock) == 0;
+}
+
+/* Construction */
+
+/**
+ * Allocates a concurrent array stack.
+ * @return A pointer to the allocated concurrent array stack.
+ */
+concurrent_array_stack *concurrent_array_stack_alloc() {
+    return concurrent_array_stack_alloc_with(NULL);
+}
+
+/**
+ * Allocates a concurrent array stack whose memory comes from the given allocator.
+ * The array is only grown while holding the mutex, so the allocator doesn't have to be thread safe.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated concurrent array stack.
+ */
+concurrent_array_stack *concurrent_array_stack_alloc_with(const allocator *allocator) {
+    concurrent_array_stack *stack = allocator_alloc(allocator, sizeof(concurrent_array_stack));
+
+    if (stack == NULL) {
+        return NULL;
+    }
+
+    stack->stack = array_stack_alloc_with(allocator);
+    if (stack->stack == NULL) {
+        allocator_free(allocator, stack, sizeof(concurrent_array_stack));
+        return NULL;
+    }
+
+    for (size_t i = 0; i < ELIMINATION_SLOTS; i++) {
+        atomic_init(&stack->slots[i].exchange, slot_word(SLOT_EMPTY, 0));
+    }
+    pthread_mutex_init(&stack->lock, NULL);
+    stack->allocator = allocator;
+
+    return stack;
+}
+
+/**
+ * Initializes a concurrent array stack using an array.
+ * Must not run while other threads use the stack.
+ * @param stack A pointer to the stack to initialize.
+ * @param values An array of values to populate the stack.
+ * @param length The length of the values array.
+ * @return An integer indicating the status.
+ */
+int concurrent_array_stack_init(concurrent_array_stack *stack, int *values, size_t length) {
+    return array_stack_init(stack->stack, values, length);
+}
+
+/**
+ * Allocates and initializes a concurrent array stack using an array.
+ * @param values An array of values to populate the stack.
+ * @param length The length of the values array.
+ * @return A pointer to the newly created concurrent array stack.
+ */
+concurrent_array_stack *concurrent_array_stack_new(int *values, size_t length) {
+    concurrent_array_stack *stack = concurrent_array_stack_alloc();
+    concurrent_array_stack_init(stack, values, length);
+    return stack;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes a concurrent array stack and deallocates the data array inside it.
+ * Must not run while other threads use the stack.
+ * @param stack A pointer to the stack to deinitialize.
+ */
+void concurrent_array_stack_deinit(concurrent_array_stack *stack) {
+    array_stack_deinit(stack->stack);
+}
+
+/**
+ * Deallocates the given concurrent array stack pointer.
+ * @param stack A pointer to a concurrent array stack pointer.
+ */
+void concurrent_array_stack_dealloc(concurrent_array_stack **stack) {
+    array_stack_dealloc(&(*stack)->stack);
+    pthread_mutex_destroy(&(*stack)->lock);
+    allocator_free((*stack)->allocator, *stack, sizeof(concurrent_array_stack));
+    *stack = NULL;
+}
+
+/**
+ * Deinitializes a concurrent array stack and then deallocates it.
+ * @param stack A pointer to a concurrent array stack pointer.
+ */
+void concurrent_array_stack_delete(concurrent_array_stack **stack) {
+    concurrent_array_stack_deinit(*stack);
+    concurrent_array_stack_dealloc(stack);
+}
+
+/* Accessing */
+
+/**
+ * Returns the number of items in a concurrent array stack.
+ * Values being handed over in the elimination array aren't counted.
+ * @param stack A pointer to the concurrent array stack.
+ * @return The number of items.
+ */
+size_t concurrent_array_stack_length(concurrent_array_stack *stack) {
+    pthread_mutex_lock(&stack->lock);
+    size_t length = stack->stack->length;
+    pthread_mutex_unlock(&stack->lock);
+
+    return length;
+}
+
+/* Mutation */
+
+/**
+ * Pushes an item onto the top of the concurrent array stack. Safe to call from any thread.
+ * @param stack A pointer to the concurrent array stack.
+ * @param value The value to push onto the stack.
+ * @return An integer indicating the status.
+ */
+int concurrent_array_stack_push(concurrent_array_stack *stack, int value) {
+    for (int attempt = 0; ; attempt++) {
+        if (lock_attempt(stack, attempt)) {
+            int status = array_stack_push(stack->stack, value);
+            pthread_mutex_unlock(&stack->lock);
+            return status;
+        }
+
+        if (eliminate_push(stack, value)) {
+            return EXIT_SUCCESS;
+        }
+    }
+}
+
+/**
+ * Removes the item at the top of the concurrent array stack if there is one. Safe to call from any thread.
+ * @param stack A pointer to the concurrent array stack.
+ * @param value Set to the removed value.
+ * @return false if the stack was empty.
+ */
+bool concurrent_array_stack_try_pop(concurrent_array_stack *stack, int *value) {
+    for (int attempt = 0; ; attempt++) {
+        if (lock_attempt(stack, attempt)) {
+            bool found = stack->stack->length > 0;
+            if (found) {
+                *value = array_stack_pop(stack->stack);
+            }
+            pthread_mutex_unlock(&stack->lock);
+            return found;
+        }
+
+        if (eliminate_pop(stack, value)) {
+            return true;
+        }
+    }
+}
+
+/**
+ * Removes an item from the top of the concurrent array stack and returns it.
+ * @param stack A pointer to the concurrent array stack.
+ * @return The value removed from the stack.
+ */
+int concurrent_array_stack_pop(concurrent_array_stack *stack) {
+    int value;
+
+    if (!concurrent_array_stack_try_pop(stack, &value)) {
+        fatal_error_print(LIST_EMPTY, "Can't pop the top of empty stack");
+    }
+
+    return value;
+}
@@ -0,0 +1,58 @@
+//
+// Created by Christopher Szatmary on 2018-12-26.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_ARRAY_STACK_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_ARRAY_STACK_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "array_stack.h"
+
+// Number of slots where pushes and pops can meet, a power of two
+#define ELIMINATION_SLOTS 8
+
+// Keeps each slot on its own cache line
+#define ELIMINATION_LINE 64
+
+typedef struct {
+    _Atomic uint64_t exchange;
+    char padding[ELIMINATION_LINE - sizeof(uint64_t)];
+} elimination_slot;
+
+/**
+ * An array stack that can be pushed to and popped from by any number of threads.
+ * The array is guarded by a mutex. A thread that finds the mutex taken goes to an elimination array
+ * instead, where a push waiting in a slot hands its value straight to a pop without either of them
+ * touching the array. Under symmetric load most pairs cancel out this way.
+ * The array grows the same way an array stack does, always while holding the mutex.
+ */
+typedef struct {
+    elimination_slot slots[ELIMINATION_SLOTS];
+    pthread_mutex_t lock;
+    array_stack *stack;
+    const allocator *allocator;
+} concurrent_array_stack;
+
+// Construction
+concurrent_array_stack *concurrent_array_stack_alloc();
+concurrent_array_stack *concurrent_array_stack_alloc_with(const allocator *allocator);
+int concurrent_array_stack_init(concurrent_array_stack *stack, int *values, size_t length);
+concurrent_array_stack *concurrent_array_stack_new(int *values, size_t length);
+
+// Deletion
+void concurrent_array_stack_deinit(concurrent_array_stack *stack);
+void concurrent_array_stack_dealloc(concurrent_array_stack **stack);
+void concurrent_array_stack_delete(concurrent_array_stack **stack);
+
+// Accessing
+size_t concurrent_array_stack_length(concurrent_array_stack *stack);
+
+// Mutation
+int concurrent_array_stack_push(concurrent_array_stack *stack, int value);
+bool concurrent_array_stack_try_pop(concurrent_array_stack *stack, int *value);
+int concurrent_array_stack_pop(concurrent_array_stack *stack);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_ARRAY_STACK_H
@@ -0,0 +1,385 @@
+//
+// Created by Christopher Szatmary on 2018-12-25.
+//
+
+#include <stdlib.h>
+#include <errno.h>
+#include "concurrent_list_stack.h"
+#include "../../utils/error.h"
+
+// Index marking the bottom of the stack or the end of the free list
+#define NIL UINT32_MAX
+
+// Number of nodes in the first chunk, a power of two
+#define FIRST_CHUNK_BITS 6
+
+/* Helpers */
+
+/**
+ * Packs a node index and a tag into the word stored in top or the free list.
+ */
+static uint64_t tagged(uint32_t tag, uint32_t index) {
+    return (uint64_t)tag << 32 | index;
+}
+
+static uint32_t tagged_index(uint64_t word) {
+    return (uint32_t)word;
+}
+
+static uint32_t tagged_tag(uint64_t word) {
+    return (uint32_t)(word >> 32);
+}
+
+/**
+ * Finds the chunk holding a node and the node's offset in it.
+ * Chunk c holds 2^(FIRST_CHUNK_BITS + c) nodes.
+ * @param index The index of the node.
+ * @param offset Set to the offset of the node in its chunk.
+ * @return The number of the chunk.
+ */
+static unsigned int chunk_of(uint32_t index, uint64_t *offset) {
+    uint64_t biased = (uint64_t)index + (1u << FIRST_CHUNK_BITS);
+    unsigned int bit = 63 - (unsigned int)__builtin_clzll(biased);
+    *offset = biased - ((uint64_t)1 << bit);
+    return bit - FIRST_CHUNK_BITS;
+}
+
+/**
+ * Gets the node with the given index, whose chunk must already exist.
+ * @param stack A pointer to the concurrent list stack.
+ * @param index The index of the node.
+ * @return A pointer to the node.
+ */
+static concurrent_stack_node *node_at(concurrent_list_stack *stack, uint32_t index) {
+    uint64_t offset;
+    unsigned int chunk = chunk_of(index, &offset);
+    return atomic_load_explicit(&stack->chunks[chunk], memory_order_acquire) + offset;
+}
+
+/**
+ * Makes sure the chunk holding a node exists, allocating it if needed.
+ * Threads racing to allocate the same chunk agree on one through a compare and swap.
+ * @param stack A pointer to the concurrent list stack.
+ * @param index The index of the node.
+ * @return false if the chunk couldn't be allocated.
+ */
+static bool chunk_ensure(concurrent_list_stack *stack, uint32_t index) {
+    uint64_t offset;
+    unsigned int chunk = chunk_of(index, &offset);
+
+    if (atomic_load_explicit(&stack->chunks[chunk], memory_order_acquire) != NULL) {
+        return true;
+    }
+
+    size_t size = ((size_t)1 << (FIRST_CHUNK_BITS + chunk)) * sizeof(concurrent_stack_node);
+    concurrent_stack_node *nodes = allocator_alloc(stack->allocator, size);
+    if (nodes == NULL) {
+        return false;
+    }
+
+    concurrent_stack_node *expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&stack->chunks[chunk], &expected, nodes,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        allocator_free(stack->allocator, nodes, size);
+    }
+
+    return true;
+}
+
+/**
+ * Takes a node off the free list, or a never used node if the free list is empty.
+ * @param stack A pointer to the concurrent list stack.
+ * @return The index of the node, or NIL if no memory is left.
+ */
+static uint32_t node_take(concurrent_list_stack *stack) {
+    uint64_t head = atomic_load_explicit(&stack->free_list, memory_order_acquire);
+
+    while (tagged_index(head) != NIL) {
+        concurrent_stack_node *node = node_at(stack, tagged_index(head));
+        uint32_t next = atomic_load_explicit(&node->previous, memory_order_relaxed);
+        uint64_t new_head = tagged(tagged_tag(head) + 1, next);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->free_list, &head, new_head,
+                                                  memory_order_acquire, memory_order_acquire)) {
+            return tagged_index(head);
+        }
+    }
+
+    uint32_t index = atomic_fetch_add_explicit(&stack->unused, 1, memory_order_relaxed);
+
+    // Ensure the index is in range and its chunk exists, the index is wasted if not
+    if (index >= NIL || !chunk_ensure(stack, index)) {
+        return NIL;
+    }
+
+    return index;
+}
+
+/**
+ * Returns a node to the free list. The memory stays valid for threads still reading it.
+ * @param stack A pointer to the concurrent list stack.
+ * @param index The index of the node.
+ */
+static void node_give(concurrent_list_stack *stack, uint32_t index) {
+    concurrent_stack_node *node = node_at(stack, index);
+    uint64_t head = atomic_load_explicit(&stack->free_list, memory_order_relaxed);
+    uint64_t new_head;
+
+    do {
+        atomic_store_explicit(&node->previous, tagged_index(head), memory_order_relaxed);
+        new_head = tagged(tagged_tag(head) + 1, index);
+    } while (!atomic_compare_exchange_weak_explicit(&stack->free_list, &head, new_head,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+/* Construction */
+
+/**
+ * Allocates a concurrent list stack.
+ * @return A pointer to the allocated concurrent list stack.
+ */
+concurrent_list_stack *concurrent_list_stack_alloc() {
+    return concurrent_list_stack_alloc_with(NULL);
+}
+
+/**
+ * Allocates a concurrent list stack whose memory comes from the given allocator.
+ * Node chunks are allocated while threads push, so the allocator must be thread safe.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated concurrent list stack.
+ */
+concurrent_list_stack *concurrent_list_stack_alloc_with(const allocator *allocator) {
+    concurrent_list_stack *stack = allocator_alloc(allocator, sizeof(concurrent_list_stack));
+
+    if (stack != NULL) {
+        atomic_init(&stack->top, tagged(0, NIL));
+        atomic_init(&stack->length, 0);
+        atomic_init(&stack->free_list, tagged(0, NIL));
+        atomic_init(&stack->unused, 0);
+        for (size_t i = 0; i < CONCURRENT_STACK_CHUNKS; i++) {
+            atomic_init(&stack->chunks[i], NULL);
+        }
+        stack->allocator = allocator;
+    }
+
+    return stack;
+}
+
+/**
+ * Initializes a concurrent list stack using an array.
+ * Must not run while other threads use the stack.
+ * @param stack A pointer to the stack to initialize.
+ * @param values An array of values to populate the stack.
+ * @param length The length of the values array.
+ * @return An integer indicating the status.
+ */
+int concurrent_list_stack_init(concurrent_list_stack *stack, int *values, size_t length) {
+    // Just return if no elements in the array
+    if (length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // Abort if the stack isn't empty
+    if (tagged_index(atomic_load(&stack->top)) != NIL) {
+        return LIST_NOT_EMPTY;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (concurrent_list_stack_push(stack, values[i]) == ENOMEM) {
+            return ENOMEM;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Allocates and initializes a concurrent list stack using an array.
+ * @param values An array of values to populate the stack.
+ * @param length The length of the values array.
+ * @return A pointer to the newly created concurrent list stack.
+ */
+concurrent_list_stack *concurrent_list_stack_new(int *values, size_t length) {
+    concurrent_list_stack *stack = concurrent_list_stack_alloc();
+    concurrent_list_stack_init(stack, values, length);
+    return stack;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes a concurrent list stack and deallocates every node chunk.
+ * Must not run while other threads use the stack.
+ * @param stack A pointer to the stack to deinitialize.
+ */
+void concurrent_list_stack_deinit(concurrent_list_stack *stack) {
+    for (unsigned int i = 0; i < CONCURRENT_STACK_CHUNKS; i++) {
+        concurrent_stack_node *nodes = atomic_load(&stack->chunks[i]);
+        if (nodes != NULL) {
+            allocator_free(stack->allocator, nodes, ((size_t)1 << (FIRST_CHUNK_BITS + i)) * sizeof(concurrent_stack_node));
+            atomic_store(&stack->chunks[i], NULL);
+        }
+    }
+
+    atomic_store(&stack->top, tagged(0, NIL));
+    atomic_store(&stack->length, 0);
+    atomic_store(&stack->free_list, tagged(0, NIL));
+    atomic_store(&stack->unused, 0);
+}
+
+/**
+ * Moves the items of a concurrent list stack into the lowest nodes and deallocates
+ * every node chunk no longer needed, giving back the memory of an earlier burst of pushes.
+ * Must not run while other threads use the stack.
+ * @param stack A pointer to the stack to shrink.
+ * @return An integer indicating the status. The stack is left untouched on ENOMEM.
+ */
+int concurrent_list_stack_shrink(concurrent_list_stack *stack) {
+    size_t length = atomic_load(&stack->length);
+    int *values = NULL;
+
+    if (length > 0) {
+        // Scratch space is heap allocated, since an arena would never get it back
+        values = malloc(length * sizeof(int));
+        if (values == NULL) {
+            return ENOMEM;
+        }
+    }
+
+    // Collect the items from the top down, then lay them out again from node 0 at the bottom
+    uint64_t top = atomic_load(&stack->top);
+    uint32_t index = tagged_index(top);
+    for (size_t i = length; i > 0; i--) {
+        concurrent_stack_node *node = node_at(stack, index);
+        values[i - 1] = node->data;
+        index = atomic_load_explicit(&node->previous, memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        concurrent_stack_node *node = node_at(stack, (uint32_t)i);
+        node->data = values[i];
+        atomic_store_explicit(&node->previous, i == 0 ? NIL : (uint32_t)(i - 1), memory_order_relaxed);
+    }
+
+    free(values);
+
+    atomic_store(&stack->top, tagged(tagged_tag(top) + 1, length == 0 ? NIL : (uint32_t)(length - 1)));
+    atomic_store(&stack->free_list, tagged(tagged_tag(atomic_load(&stack->free_list)) + 1, NIL));
+    atomic_store(&stack->unused, (uint32_t)length);
+
+    // Chunk i starts at node 2^(FIRST_CHUNK_BITS + i) - 2^FIRST_CHUNK_BITS
+    for (unsigned int i = 0; i < CONCURRENT_STACK_CHUNKS; i++) {
+        size_t first = ((size_t)1 << (FIRST_CHUNK_BITS + i)) - ((size_t)1 << FIRST_CHUNK_BITS);
+        concurrent_stack_node *nodes = atomic_load(&stack->chunks[i]);
+        if (nodes != NULL && first >= length) {
+            allocator_free(stack->allocator, nodes, ((size_t)1 << (FIRST_CHUNK_BITS + i)) * sizeof(concurrent_stack_node));
+            atomic_store(&stack->chunks[i], NULL);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Deallocates the given concurrent list stack pointer.
+ * @param stack A pointer to a concurrent list stack pointer.
+ */
+void concurrent_list_stack_dealloc(concurrent_list_stack **stack) {
+    allocator_free((*stack)->allocator, *stack, sizeof(concurrent_list_stack));
+    *stack = NULL;
+}
+
+/**
+ * Deinitializes a concurrent list stack and then deallocates it.
+ * @param stack A pointer to a concurrent list stack pointer.
+ */
+void concurrent_list_stack_delete(concurrent_list_stack **stack) {
+    concurrent_list_stack_deinit(*stack);
+    concurrent_list_stack_dealloc(stack);
+}
+
+/* Accessing */
+
+/**
+ * Returns the number of items in a concurrent list stack.
+ * While other threads push or pop this is only a snapshot.
+ * @param stack A pointer to the concurrent list stack.
+ * @return The number of items.
+ */
+size_t concurrent_list_stack_length(concurrent_list_stack *stack) {
+    return atomic_load_explicit(&stack->length, memory_order_relaxed);
+}
+
+/* Mutation */
+
+/**
+ * Pushes an item onto the top of the concurrent list stack. Safe to call from any thread.
+ * @param stack A pointer to the concurrent list stack.
+ * @param value The value to push onto the stack.
+ * @return An integer indicating the status.
+ */
+int concurrent_list_stack_push(concurrent_list_stack *stack, int value) {
+    uint32_t index = node_take(stack);
+
+    if (index == NIL) {
+        return ENOMEM;
+    }
+
+    concurrent_stack_node *node = node_at(stack, index);
+    node->data = value;
+
+    // Publish the node, release ordering makes its data visible to the thread that pops it
+    uint64_t top = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    uint64_t new_top;
+    do {
+        atomic_store_explicit(&node->previous, tagged_index(top), memory_order_relaxed);
+        new_top = tagged(tagged_tag(top) + 1, index);
+    } while (!atomic_compare_exchange_weak_explicit(&stack->top, &top, new_top,
+                                                    memory_order_release, memory_order_relaxed));
+
+    atomic_fetch_add_explicit(&stack->length, 1, memory_order_relaxed);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Removes the item at the top of the concurrent list stack if there is one. Safe to call from any thread.
+ * @param stack A pointer to the concurrent list stack.
+ * @param value Set to the removed value.
+ * @return false if the stack was empty.
+ */
+bool concurrent_list_stack_try_pop(concurrent_list_stack *stack, int *value) {
+    uint64_t top = atomic_load_explicit(&stack->top, memory_order_acquire);
+
+    while (tagged_index(top) != NIL) {
+        // The node may be popped and reused meanwhile, then the tag has changed and the swap fails
+        concurrent_stack_node *node = node_at(stack, tagged_index(top));
+        uint32_t below = atomic_load_explicit(&node->previous, memory_order_relaxed);
+        uint64_t new_top = tagged(tagged_tag(top) + 1, below);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->top, &top, new_top,
+                                                  memory_order_acquire, memory_order_acquire)) {
+            *value = node->data;
+            node_give(stack, tagged_index(top));
+            atomic_fetch_sub_explicit(&stack->length, 1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Removes an item from the top of the concurrent list stack and returns it.
+ * @param stack A pointer to the concurrent list stack.
+ * @return The value removed from the stack.
+ */
+int concurrent_list_stack_pop(concurrent_list_stack *stack) {
+    int value;
+
+    if (!concurrent_list_stack_try_pop(stack, &value)) {
+        fatal_error_print(LIST_EMPTY, "Can't pop the top of empty stack");
+    }
+
+    return value;
+}
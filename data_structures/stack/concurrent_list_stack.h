@@ -0,0 +1,65 @@
+//
+// Created by Christopher Szatmary on 2018-12-25.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_STACK_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_STACK_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../utils/allocator.h"
+
+// Nodes live in chunks that double in size, enough of them to hold 2^32 - 1 nodes
+#define CONCURRENT_STACK_CHUNKS 27
+
+// Keeps fields written by different operations on separate cache lines
+#define CONCURRENT_STACK_LINE 64
+
+typedef struct {
+    int data;
+    _Atomic uint32_t previous;
+} concurrent_stack_node;
+
+/**
+ * A lock-free Treiber stack that can be pushed to and popped from by any number of threads.
+ * Nodes are referred to by 32 bit indexes, and top and the free list pair the index with a tag
+ * in one 64 bit word that changes on every update, so a compare and swap can't succeed on a
+ * word that was popped and pushed back in between (the ABA problem).
+ * Popped nodes go to a lock-free free list and are reused by later pushes. Their memory stays
+ * valid while other threads may still be reading them, so node chunks are never freed while the
+ * stack is in use: the memory stays at the most nodes the stack ever held, until it is
+ * deinitialized or concurrent_list_stack_shrink is called while no other thread uses it.
+ */
+typedef struct {
+    _Atomic uint64_t top;
+    _Atomic size_t length;
+    char top_padding[CONCURRENT_STACK_LINE - sizeof(uint64_t) - sizeof(size_t)];
+    _Atomic uint64_t free_list;
+    _Atomic uint32_t unused;
+    char free_padding[CONCURRENT_STACK_LINE - sizeof(uint64_t) - sizeof(uint32_t)];
+    _Atomic(concurrent_stack_node *) chunks[CONCURRENT_STACK_CHUNKS];
+    const allocator *allocator;
+} concurrent_list_stack;
+
+// Construction
+concurrent_list_stack *concurrent_list_stack_alloc();
+concurrent_list_stack *concurrent_list_stack_alloc_with(const allocator *allocator);
+int concurrent_list_stack_init(concurrent_list_stack *stack, int *values, size_t length);
+concurrent_list_stack *concurrent_list_stack_new(int *values, size_t length);
+
+// Deletion
+void concurrent_list_stack_deinit(concurrent_list_stack *stack);
+int concurrent_list_stack_shrink(concurrent_list_stack *stack);
+void concurrent_list_stack_dealloc(concurrent_list_stack **stack);
+void concurrent_list_stack_delete(concurrent_list_stack **stack);
+
+// Accessing
+size_t concurrent_list_stack_length(concurrent_list_stack *stack);
+
+// Mutation
+int concurrent_list_stack_push(concurrent_list_stack *stack, int value);
+bool concurrent_list_stack_try_pop(concurrent_list_stack *stack, int *value);
+int concurrent_list_stack_pop(concurrent_list_stack *stack);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_STACK_H
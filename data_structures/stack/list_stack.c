@@ -6,22 +6,26 @@
 #include <errno.h>
 #include "list_stack.h"
 #include "../../utils/error.h"
+#include "../../utils/instrument.h"
 
 /* Helpers */
 
 /**
  * Allocates and initializes a new stack_node.
+ * @param stack A pointer to the list stack the node belongs to.
  * @param value The data value the node should have.
  * @param previous A pointer to the previous node.
  * @return A pointer to the newly created node.
  */
-static stack_node *node_new(int value, stack_node *previous) {
-    stack_node *node = malloc(sizeof(stack_node));
+static stack_node *node_new(list_stack *stack, int value, stack_node *previous) {
+    stack_node *node = allocator_alloc(stack->allocator, sizeof(stack_node));
 
     // Ensure the allocation succeeded, then initialize the node
     if (node != NULL) {
         node->data = value;
         node->previous = previous;
+        INSTRUMENT_ADD(INSTRUMENT_LIST_STACK, INSTRUMENT_ALLOCS, 1);
+        INSTRUMENT_MEMORY(INSTRUMENT_LIST_STACK, (int64_t)sizeof(stack_node));
     }
 
     return node;
@@ -34,11 +38,21 @@ static stack_node *node_new(int value, stack_node *previous) {
  * @return A pointer to the allocated list stack.
  */
 list_stack *list_stack_alloc() {
-    list_stack *stack = malloc(sizeof(list_stack));
+    return list_stack_alloc_with(NULL);
+}
+
+/**
+ * Allocates a list stack whose memory comes from the given allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated list stack.
+ */
+list_stack *list_stack_alloc_with(const allocator *allocator) {
+    list_stack *stack = allocator_alloc(allocator, sizeof(list_stack));
 
     if (stack != NULL) {
         stack->top = NULL;
         stack->length = 0;
+        stack->allocator = allocator;
     }
 
     return stack;
@@ -63,7 +77,7 @@ int list_stack_init(list_stack *stack, int *values, size_t length) {
     }
 
     // Loop through each element in the array and create a node to add to the list
-    stack_node *current = node_new(values[0], NULL);
+    stack_node *current = node_new(stack, values[0], NULL);
 
     // Ensure that the node was allocated
     if (current == NULL) {
@@ -71,7 +85,7 @@ int list_stack_init(list_stack *stack, int *values, size_t length) {
     }
 
     for (size_t i = 1; i < length; i++) {
-        stack_node *next = node_new(values[i], current);
+        stack_node *next = node_new(stack, values[i], current);
         current = next;
     }
 
@@ -97,14 +111,17 @@ list_stack *list_stack_new(int *values, size_t length) {
 
 /**
  * Deinitializes a list stack and deallocates each node inside it.
+ * Nodes from an allocator that only releases in bulk are left for it to reclaim.
  * @param stack A pointer to the stack to deinitialize.
  */
 void list_stack_deinit(list_stack *stack) {
     // Loop through each node and deallocate it
-    stack_node *current = stack->top;
+    stack_node *current = allocator_frees(stack->allocator) ? stack->top : NULL;
     while (current != NULL) {
         stack_node *previous = current->previous;
-        free(current);
+        allocator_free(stack->allocator, current, sizeof(stack_node));
+        INSTRUMENT_ADD(INSTRUMENT_LIST_STACK, INSTRUMENT_FREES, 1);
+        INSTRUMENT_MEMORY(INSTRUMENT_LIST_STACK, -(int64_t)sizeof(stack_node));
         current = previous;
     }
 
@@ -117,7 +134,7 @@ void list_stack_deinit(list_stack *stack) {
  * @param stack A pointer to a list stack pointer.
  */
 void list_stack_dealloc(list_stack **stack) {
-    free(*stack);
+    allocator_free((*stack)->allocator, *stack, sizeof(list_stack));
     *stack = NULL;
 }
 
@@ -145,6 +162,26 @@ int list_stack_peak(list_stack *stack) {
     return stack->top->data;
 }
 
+/**
+ * Reports how the memory held by a list stack is spent.
+ * @param stack A pointer to the list stack.
+ * @return The memory usage of the stack.
+ */
+memory_usage list_stack_memory_usage(list_stack *stack) {
+    memory_usage usage = {
+        stack->length * sizeof(int),
+        sizeof(list_stack) + stack->length * (sizeof(stack_node) - sizeof(int)),
+        0
+    };
+
+    // Every node is allocated with the same size, so each one wastes the same amount
+    if (stack->top != NULL) {
+        usage.slack = stack->length * allocator_slack(stack->allocator, stack->top, sizeof(stack_node));
+    }
+
+    return usage;
+}
+
 /* Mutation */
 
 /**
@@ -153,7 +190,7 @@ int list_stack_peak(list_stack *stack) {
  * @param value The value to push onto the stack.
  */
 int list_stack_push(list_stack *stack, int value) {
-    stack_node *new_node = node_new(value, stack->top);
+    stack_node *new_node = node_new(stack, value, stack->top);
 
     if (new_node == NULL) {
         return ENOMEM;
@@ -179,7 +216,9 @@ int list_stack_pop(list_stack *stack) {
     stack->top = node_to_remove->previous;
 
     int data = node_to_remove->data;
-    free(node_to_remove);
+    allocator_free(stack->allocator, node_to_remove, sizeof(stack_node));
+    INSTRUMENT_ADD(INSTRUMENT_LIST_STACK, INSTRUMENT_FREES, 1);
+    INSTRUMENT_MEMORY(INSTRUMENT_LIST_STACK, -(int64_t)sizeof(stack_node));
     stack->length--;
 
     return data;
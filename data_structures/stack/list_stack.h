@@ -5,6 +5,8 @@
 #ifndef DATA_STRUCTURES_AND_ALGORITHMS_STACK_H
 #define DATA_STRUCTURES_AND_ALGORITHMS_STACK_H
 
+#include "../../utils/allocator.h"
+
 typedef struct node {
     int data;
     struct node *previous;
@@ -13,10 +15,12 @@ typedef struct node {
 typedef struct {
     stack_node *top;
     size_t length;
+    const allocator *allocator;
 } list_stack;
 
 // Construction
 list_stack *list_stack_alloc();
+list_stack *list_stack_alloc_with(const allocator *allocator);
 int list_stack_init(list_stack *stack, int *values, size_t length);
 list_stack *list_stack_new(int *values, size_t length);
 
@@ -27,6 +31,7 @@ void list_stack_delete(list_stack **stack);
 
 // Accessing
 int list_stack_peak(list_stack *stack);
+memory_usage list_stack_memory_usage(list_stack *stack);
 
 // Mutation
 int list_stack_push(list_stack *stack, int value);
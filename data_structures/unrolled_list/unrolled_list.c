@@ -0,0 +1,487 @@
+//
+// Created by Christopher Szatmary on 2018-12-18.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "unrolled_list.h"
+#include "../../utils/error.h"
+
+#define HALF_CAPACITY (UNROLLED_NODE_CAPACITY / 2)
+
+/* Helpers */
+
+/**
+ * Allocates a new, empty unrolled_node and links it between two nodes.
+ * @param list A pointer to the unrolled list the node belongs to.
+ * @param next A pointer to the node that should follow the new node.
+ * @param previous A pointer to the node that should precede the new node.
+ * @return A pointer to the newly created node.
+ */
+static unrolled_node *node_new(unrolled_list *list, unrolled_node *next, unrolled_node *previous) {
+    unrolled_node *node = allocator_alloc(list->allocator, sizeof(unrolled_node));
+
+    // Ensure the allocation succeeded, then link the node into the list
+    if (node != NULL) {
+        node->next = next;
+        node->previous = previous;
+        node->count = 0;
+
+        if (next == NULL) {
+            list->tail = node;
+        } else {
+            next->previous = node;
+        }
+
+        if (previous == NULL) {
+            list->head = node;
+        } else {
+            previous->next = node;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * Unlinks a node from an unrolled list and deallocates it.
+ * @param list A pointer to the unrolled list.
+ * @param node A pointer to the node to remove.
+ */
+static void node_remove(unrolled_list *list, unrolled_node *node) {
+    if (node->previous == NULL) {
+        list->head = node->next;
+    } else {
+        node->previous->next = node->next;
+    }
+
+    if (node->next == NULL) {
+        list->tail = node->previous;
+    } else {
+        node->next->previous = node->previous;
+    }
+
+    allocator_free(list->allocator, node, sizeof(unrolled_node));
+}
+
+/**
+ * Merges a node with the one after it if the node is less than half full and both fit in one node.
+ * Removes the node if it is empty.
+ * @param list A pointer to the unrolled list.
+ * @param node A pointer to the node that shrank.
+ */
+static void node_rebalance(unrolled_list *list, unrolled_node *node) {
+    if (node->count == 0) {
+        node_remove(list, node);
+        return;
+    }
+
+    unrolled_node *next = node->next;
+    if (node->count < HALF_CAPACITY && next != NULL && node->count + next->count <= UNROLLED_NODE_CAPACITY) {
+        memcpy(node->data + node->count, next->data, next->count * sizeof(int));
+        node->count += next->count;
+        node_remove(list, next);
+    }
+}
+
+/**
+ * Finds the node holding the element at the given index in an unrolled list.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the unrolled list.
+ * @param index The index of the element.
+ * @param offset Set to the position of the element inside the returned node.
+ * @return A pointer to the node holding the element.
+ */
+static unrolled_node *unrolled_list_node(unrolled_list *list, int index, size_t *offset) {
+    int list_length = (int)list->length;
+    int max_index = list_length - 1;
+    int min_index = list_length * -1;
+
+    // Ensure that a valid index was given.
+    if (index < min_index || index > max_index) {
+        fatal_error_print(INVALID_INDEX, "Index out of range\n");
+    }
+
+    size_t real_index = (size_t)(index < 0 ? list_length + index : index);
+
+    unrolled_node *current;
+    if (real_index <= (size_t)max_index / 2) {
+        current = list->head;
+        while (real_index >= current->count) {
+            real_index -= current->count;
+            current = current->next;
+        }
+    } else {
+        // Count the elements after the index and skip whole nodes from the tail
+        size_t remaining = list->length - 1 - real_index;
+        current = list->tail;
+        while (remaining >= current->count) {
+            remaining -= current->count;
+            current = current->previous;
+        }
+        real_index = current->count - 1 - remaining;
+    }
+
+    *offset = real_index;
+    return current;
+}
+
+/* Construction */
+
+/**
+ * Allocates an unrolled list.
+ * @return A pointer to the allocated unrolled list.
+ */
+unrolled_list *unrolled_list_alloc() {
+    return unrolled_list_alloc_with(NULL);
+}
+
+/**
+ * Allocates an unrolled list whose memory comes from the given allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated unrolled list.
+ */
+unrolled_list *unrolled_list_alloc_with(const allocator *allocator) {
+    unrolled_list *list = allocator_alloc(allocator, sizeof(unrolled_list));
+
+    // Ensure the allocation succeeded, then set the default values
+    if (list != NULL) {
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
+        list->allocator = allocator;
+    }
+
+    return list;
+}
+
+/**
+ * Initializes an unrolled list using an array.
+ * Every node except the last is filled completely.
+ * @param list A pointer to the list to initialize.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return An integer indicating the status.
+ */
+int unrolled_list_init(unrolled_list *list, int *values, size_t length) {
+    // Just return if no elements in the array
+    if (length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    // Abort if the list isn't empty
+    if (list->head != NULL) {
+        return LIST_NOT_EMPTY;
+    }
+
+    // Copy the array into the list one node at a time
+    for (size_t i = 0; i < length; i += UNROLLED_NODE_CAPACITY) {
+        unrolled_node *node = node_new(list, NULL, list->tail);
+
+        // Ensure that the node was allocated
+        if (node == NULL) {
+            return ENOMEM;
+        }
+
+        size_t count = length - i < UNROLLED_NODE_CAPACITY ? length - i : UNROLLED_NODE_CAPACITY;
+        memcpy(node->data, values + i, count * sizeof(int));
+        node->count = count;
+        list->length += count;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Allocates and initializes an unrolled list using an array.
+ * @param values An array of values to populate the list.
+ * @param length The length of the values array.
+ * @return A pointer to the newly created unrolled list.
+ */
+unrolled_list *unrolled_list_new(int *values, size_t length) {
+    unrolled_list *list = unrolled_list_alloc();
+    unrolled_list_init(list, values, length);
+    return list;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes an unrolled list and deallocates each node inside it.
+ * Nodes from an allocator that only releases in bulk are left for it to reclaim.
+ * @param list The unrolled list to deinitialize.
+ */
+void unrolled_list_deinit(unrolled_list *list) {
+    // Loop through each node and deallocate it
+    unrolled_node *current = allocator_frees(list->allocator) ? list->head : NULL;
+    while (current != NULL) {
+        unrolled_node *next = current->next;
+        allocator_free(list->allocator, current, sizeof(unrolled_node));
+        current = next;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+}
+
+/**
+ * Deallocates the given unrolled list pointer.
+ * @param list A pointer to an unrolled list pointer.
+ */
+void unrolled_list_dealloc(unrolled_list **list) {
+    allocator_free((*list)->allocator, *list, sizeof(unrolled_list));
+    *list = NULL;
+}
+
+/**
+ * Deinitializes an unrolled list and then deallocates it.
+ * @param list A pointer to an unrolled list pointer.
+ */
+void unrolled_list_delete(unrolled_list **list) {
+    unrolled_list_deinit(*list);
+    unrolled_list_dealloc(list);
+}
+
+/* Accessing */
+
+/**
+ * Retrieves the first element in the unrolled list.
+ * @param list A pointer to the unrolled list.
+ * @return The first element in the list.
+ */
+int unrolled_list_first(unrolled_list *list) {
+    if (list->head == NULL) {
+        fatal_error_print(LIST_EMPTY, "Can't get first element from empty list");
+    }
+
+    return list->head->data[0];
+}
+
+/**
+ * Retrieves the last element in the unrolled list.
+ * @param list A pointer to the unrolled list.
+ * @return The last element in the list.
+ */
+int unrolled_list_last(unrolled_list *list) {
+    if (list->tail == NULL) {
+        fatal_error_print(LIST_EMPTY, "Can't get last element from empty list");
+    }
+
+    return list->tail->data[list->tail->count - 1];
+}
+
+/**
+ * Retrieves the element at the given index in the unrolled list.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the unrolled list.
+ * @param index The index of the element to retrieve.
+ * @return The element at the given index.
+ */
+int unrolled_list_element(unrolled_list *list, int index) {
+    size_t offset;
+    unrolled_node *node = unrolled_list_node(list, index, &offset);
+    return node->data[offset];
+}
+
+/**
+ * Prints an unrolled list in order.
+ * @param list A pointer to the unrolled list.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ */
+void unrolled_list_print(unrolled_list *list, bool new_line) {
+    for (unrolled_node *current = list->head; current != NULL; current = current->next) {
+        for (size_t i = 0; i < current->count; i++) {
+            printf("%d -> ", current->data[i]);
+        }
+    }
+
+    printf("NULL");
+
+    if (new_line) {
+        printf("\n");
+    }
+}
+
+/**
+ * Prints an unrolled list in reverse order.
+ * @param list A pointer to the unrolled list.
+ * @param new_line A boolean indicating whether or not to add a newline character.
+ */
+void unrolled_list_print_rev(unrolled_list *list, bool new_line) {
+    for (unrolled_node *current = list->tail; current != NULL; current = current->previous) {
+        for (size_t i = current->count; i > 0; i--) {
+            printf("%d <- ", current->data[i - 1]);
+        }
+    }
+
+    printf("NULL");
+
+    if (new_line) {
+        printf("\n");
+    }
+}
+
+/* Mutation */
+
+/**
+ * Ensures the unrolled list has the correct length stored.
+ * If the length stored is incorrect it will be corrected.
+ * @param list A pointer to the unrolled list.
+ * @return An integer indicating whether or not there was an difference found.
+ */
+int unrolled_list_ensure_len(unrolled_list *list) {
+    size_t count = 0;
+    for (unrolled_node *current = list->head; current != NULL; current = current->next) {
+        count += current->count;
+    }
+
+    if (count != list->length) {
+        list->length = count;
+        return LENGTHS_DIFFERENT;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Adds a value to the end of an unrolled list.
+ * @param list A pointer to the unrolled list.
+ * @param value The value to add to the list.
+ */
+void unrolled_list_append(unrolled_list *list, int value) {
+    if (list->tail == NULL || list->tail->count == UNROLLED_NODE_CAPACITY) {
+        if (node_new(list, NULL, list->tail) == NULL) {
+            fatal_error_print(ENOMEM, "Can't allocate a node for an unrolled list\n");
+        }
+    }
+
+    unrolled_node *tail = list->tail;
+    tail->data[tail->count] = value;
+    tail->count++;
+    list->length++;
+}
+
+/**
+ * Adds a value to the beginning of an unrolled list.
+ * @param list A pointer to the unrolled list.
+ * @param value The value to add to the list.
+ */
+void unrolled_list_prepend(unrolled_list *list, int value) {
+    if (list->head == NULL || list->head->count == UNROLLED_NODE_CAPACITY) {
+        if (node_new(list, list->head, NULL) == NULL) {
+            fatal_error_print(ENOMEM, "Can't allocate a node for an unrolled list\n");
+        }
+    }
+
+    unrolled_node *head = list->head;
+    memmove(head->data + 1, head->data, head->count * sizeof(int));
+    head->data[0] = value;
+    head->count++;
+    list->length++;
+}
+
+/**
+ * Inserts a value into an unrolled list.
+ * A full node is split in half to make room.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the unrolled list.
+ * @param value The value to insert into the list.
+ * @param index The index at which to insert the value.
+ */
+void unrolled_list_insert(unrolled_list *list, int value, int index) {
+    int list_length = (int)list->length;
+    int real_index = index < 0 ? list_length + index : index;
+
+    if (real_index == 0) {
+        unrolled_list_prepend(list, value);
+        return;
+    } else if (real_index == list_length) {
+        unrolled_list_append(list, value);
+        return;
+    }
+
+    size_t offset;
+    unrolled_node *node = unrolled_list_node(list, real_index, &offset);
+
+    if (node->count == UNROLLED_NODE_CAPACITY) {
+        // Move the upper half of the node into a new node after it
+        unrolled_node *split = node_new(list, node->next, node);
+
+        if (split == NULL) {
+            fatal_error_print(ENOMEM, "Can't allocate a node for an unrolled list\n");
+        }
+
+        memcpy(split->data, node->data + HALF_CAPACITY, (UNROLLED_NODE_CAPACITY - HALF_CAPACITY) * sizeof(int));
+        split->count = UNROLLED_NODE_CAPACITY - HALF_CAPACITY;
+        node->count = HALF_CAPACITY;
+
+        if (offset > HALF_CAPACITY) {
+            node = split;
+            offset -= HALF_CAPACITY;
+        }
+    }
+
+    memmove(node->data + offset + 1, node->data + offset, (node->count - offset) * sizeof(int));
+    node->data[offset] = value;
+    node->count++;
+    list->length++;
+}
+
+/**
+ * Removes the last element in an unrolled list.
+ * @param list A pointer to the unrolled list.
+ * @return The element that was removed.
+ */
+int unrolled_list_remove_last(unrolled_list *list) {
+    if (list->tail == NULL) {
+        fatal_error_print(LIST_EMPTY, "Can't remove last element from an empty list");
+    }
+
+    unrolled_node *tail = list->tail;
+    tail->count--;
+    int data = tail->data[tail->count];
+    list->length--;
+
+    if (tail->count == 0) {
+        node_remove(list, tail);
+    }
+
+    return data;
+}
+
+/**
+ * Removes the first element in an unrolled list.
+ * @param list A pointer to the unrolled list.
+ * @return The element that was removed.
+ */
+int unrolled_list_remove_first(unrolled_list *list) {
+    if (list->head == NULL) {
+        fatal_error_print(LIST_EMPTY, "Can't remove first element from an empty list");
+    }
+
+    return unrolled_list_remove(list, 0);
+}
+
+/**
+ * Removes the element at the given index in an unrolled list.
+ * Nodes left less than half full are merged with their successor when possible.
+ * Supports reverse indexing through negative numbers.
+ * @param list A pointer to the unrolled list.
+ * @return The element that was removed.
+ */
+int unrolled_list_remove(unrolled_list *list, int index) {
+    size_t offset;
+    unrolled_node *node = unrolled_list_node(list, index, &offset);
+
+    int data = node->data[offset];
+    memmove(node->data + offset, node->data + offset + 1, (node->count - offset - 1) * sizeof(int));
+    node->count--;
+    list->length--;
+
+    node_rebalance(list, node);
+
+    return data;
+}
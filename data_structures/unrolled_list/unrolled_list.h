@@ -0,0 +1,55 @@
+//
+// Created by Christopher Szatmary on 2018-12-18.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_UNROLLED_LIST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_UNROLLED_LIST_H
+
+#include <stdbool.h>
+#include "../../utils/allocator.h"
+
+// Each node stores one cache line worth of values
+#define UNROLLED_NODE_CAPACITY (64 / sizeof(int))
+
+typedef struct unrolled_node {
+    struct unrolled_node *next;
+    struct unrolled_node *previous;
+    size_t count;
+    int data[UNROLLED_NODE_CAPACITY];
+} unrolled_node;
+
+typedef struct {
+    unrolled_node *head;
+    unrolled_node *tail;
+    size_t length;
+    const allocator *allocator;
+} unrolled_list;
+
+// Construction
+unrolled_list *unrolled_list_alloc();
+unrolled_list *unrolled_list_alloc_with(const allocator *allocator);
+int unrolled_list_init(unrolled_list *list, int *values, size_t length);
+unrolled_list *unrolled_list_new(int *values, size_t length);
+
+// Deletion
+void unrolled_list_deinit(unrolled_list *list);
+void unrolled_list_dealloc(unrolled_list **list);
+void unrolled_list_delete(unrolled_list **list);
+
+// Accessing
+int unrolled_list_first(unrolled_list *list);
+int unrolled_list_last(unrolled_list *list);
+int unrolled_list_element(unrolled_list *list, int index);
+void unrolled_list_print(unrolled_list *list, bool new_line);
+void unrolled_list_print_rev(unrolled_list *list, bool new_line);
+
+// Mutation
+int unrolled_list_ensure_len(unrolled_list *list);
+void unrolled_list_append(unrolled_list *list, int value);
+void unrolled_list_prepend(unrolled_list *list, int value);
+void unrolled_list_insert(unrolled_list *list, int value, int index);
+int unrolled_list_remove_last(unrolled_list *list);
+int unrolled_list_remove_first(unrolled_list *list);
+int unrolled_list_remove(unrolled_list *list, int index);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_UNROLLED_LIST_H
@@ -0,0 +1,280 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#include <stdlib.h>
+#include <errno.h>
+#include "work_deque.h"
+#include "../../utils/error.h"
+
+#define AUTOMATIC 0
+
+struct work_deque_buffer {
+    size_t capacity;
+    work_deque_buffer *retired;
+    _Atomic(void *) items[];
+};
+
+/* Helpers */
+
+static size_t buffer_size(size_t capacity) {
+    return sizeof(work_deque_buffer) + capacity * sizeof(_Atomic(void *));
+}
+
+static _Atomic(void *) *buffer_slot(work_deque_buffer *buffer, int64_t index) {
+    return &buffer->items[(size_t)index & (buffer->capacity - 1)];
+}
+
+/**
+ * Moves the items of a work deque to a new buffer of the given capacity. Only called by the owner.
+ * The old buffer can't be freed or reallocated in place, since thieves may still be reading it,
+ * so it is linked to the new one and freed on deinit.
+ * @param deque A pointer to the work deque.
+ * @param capacity The new capacity, a power of two at least the number of items.
+ * @return An integer indicating the status.
+ */
+static int resize_deque(work_deque *deque, size_t capacity) {
+    work_deque_buffer *old = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    work_deque_buffer *new_buffer = allocator_alloc(deque->allocator, buffer_size(capacity));
+
+    if (new_buffer == NULL) {
+        return ENOMEM;
+    }
+
+    new_buffer->capacity = capacity;
+    new_buffer->retired = old;
+
+    // Items outside top and bottom are garbage, copying the live ones is enough
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    for (int64_t i = top; i < bottom; i++) {
+        void *item = atomic_load_explicit(buffer_slot(old, i), memory_order_relaxed);
+        atomic_store_explicit(buffer_slot(new_buffer, i), item, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&deque->buffer, new_buffer, memory_order_release);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Increases the capacity of the given work deque.
+ * @param deque A pointer to the work deque.
+ * @param capacity The new capacity of the deque, rounded up to a power of two.
+ * If AUTOMATIC the new capacity will be double to current capacity.
+ * @return An integer indicating the status.
+ */
+static int increase_deque_capacity(work_deque *deque, size_t capacity) {
+    size_t current = work_deque_capacity(deque);
+
+    if (capacity != AUTOMATIC && capacity <= current) {
+        return SPACE_ALREADY_ALLOCATED;
+    }
+
+    size_t actual_capacity;
+    if (capacity == AUTOMATIC) {
+        actual_capacity = current == 0 ? 2 : current * 2;
+    } else {
+        actual_capacity = 2;
+        while (actual_capacity < capacity) {
+            actual_capacity *= 2;
+        }
+    }
+
+    return resize_deque(deque, actual_capacity);
+}
+
+/* Construction */
+
+/**
+ * Allocates a work deque.
+ * @return A pointer to the allocated work deque.
+ */
+work_deque *work_deque_alloc() {
+    return work_deque_alloc_with(NULL);
+}
+
+/**
+ * Allocates a work deque whose memory comes from the given allocator.
+ * Only the owner grows the deque, so the allocator doesn't have to be thread safe
+ * as long as the owner is the only thread allocating from it.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @return A pointer to the allocated work deque.
+ */
+work_deque *work_deque_alloc_with(const allocator *allocator) {
+    work_deque *deque = allocator_alloc(allocator, sizeof(work_deque));
+
+    if (deque != NULL) {
+        atomic_init(&deque->top, 0);
+        atomic_init(&deque->bottom, 0);
+        atomic_init(&deque->buffer, NULL);
+        deque->allocator = allocator;
+    }
+
+    return deque;
+}
+
+/* Deletion */
+
+/**
+ * Deinitializes a work deque and deallocates its current and replaced buffers.
+ * Must not run while other threads use the deque.
+ * @param deque A pointer to the deque to deinitialize.
+ */
+void work_deque_deinit(work_deque *deque) {
+    work_deque_buffer *buffer = atomic_load(&deque->buffer);
+
+    while (buffer != NULL) {
+        work_deque_buffer *retired = buffer->retired;
+        allocator_free(deque->allocator, buffer, buffer_size(buffer->capacity));
+        buffer = retired;
+    }
+
+    atomic_store(&deque->buffer, NULL);
+    atomic_store(&deque->top, 0);
+    atomic_store(&deque->bottom, 0);
+}
+
+/**
+ * Deallocates the given work deque pointer.
+ * @param deque A pointer to a work deque pointer.
+ */
+void work_deque_dealloc(work_deque **deque) {
+    allocator_free((*deque)->allocator, *deque, sizeof(work_deque));
+    *deque = NULL;
+}
+
+/**
+ * Deinitializes a work deque and then deallocates it.
+ * @param deque A pointer to a work deque pointer.
+ */
+void work_deque_delete(work_deque **deque) {
+    work_deque_deinit(*deque);
+    work_deque_dealloc(deque);
+}
+
+/* Resizing */
+
+/**
+ * Reserves enough space to store the specified number of items. Only the owner may call this.
+ * @param deque A pointer to the work deque.
+ * @param capacity The desired capacity of the deque.
+ * @return An integer indicating the status.
+ */
+int work_deque_reserve_capacity(work_deque *deque, size_t capacity) {
+    return increase_deque_capacity(deque, capacity);
+}
+
+/* Accessing */
+
+/**
+ * Returns the number of items in a work deque.
+ * While other threads steal from it this is only a snapshot.
+ * @param deque A pointer to the work deque.
+ * @return The number of items.
+ */
+size_t work_deque_length(work_deque *deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+/**
+ * Returns the number of items a work deque can hold before it grows.
+ * @param deque A pointer to the work deque.
+ * @return The capacity.
+ */
+size_t work_deque_capacity(work_deque *deque) {
+    work_deque_buffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    return buffer == NULL ? 0 : buffer->capacity;
+}
+
+/* Mutation */
+
+/**
+ * Pushes an item onto the bottom of a work deque. Only the owner may call this.
+ * @param deque A pointer to the work deque.
+ * @param item The item to push.
+ * @return An integer indicating the status.
+ */
+int work_deque_push(work_deque *deque, void *item) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+    // Check if the buffer is full and double it if it is
+    if ((size_t)(bottom - top) >= work_deque_capacity(deque)) {
+        if (increase_deque_capacity(deque, AUTOMATIC) == ENOMEM) {
+            return ENOMEM;
+        }
+    }
+
+    work_deque_buffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    atomic_store_explicit(buffer_slot(buffer, bottom), item, memory_order_relaxed);
+
+    // Publish the item to thieves
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Takes the newest item from the bottom of a work deque. Only the owner may call this.
+ * @param deque A pointer to the work deque.
+ * @param item Set to the item taken.
+ * @return false if the deque was empty or a thief stole the last item first.
+ */
+bool work_deque_take(work_deque *deque, void **item) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    work_deque_buffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    // Claim the bottom item before looking at top, thieves see the claim before they steal
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    *item = atomic_load_explicit(buffer_slot(buffer, bottom), memory_order_relaxed);
+    if (top < bottom) {
+        return true;
+    }
+
+    // The last item, race thieves for it by moving top past it
+    bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                       memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return won;
+}
+
+/**
+ * Steals the oldest item from the top of a work deque. Any thread may call this.
+ * @param deque A pointer to the work deque.
+ * @param item Set to the item stolen.
+ * @return false if the deque was empty or another thread got the item first.
+ */
+bool work_deque_steal(work_deque *deque, void **item) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return false;
+    }
+
+    work_deque_buffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    void *stolen = atomic_load_explicit(buffer_slot(buffer, top), memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return false;
+    }
+
+    *item = stolen;
+    return true;
+}
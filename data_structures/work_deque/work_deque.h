@@ -0,0 +1,55 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_WORK_DEQUE_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_WORK_DEQUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../../utils/allocator.h"
+
+// Keeps the ends of the deque on separate cache lines
+#define WORK_DEQUE_LINE 64
+
+typedef struct work_deque_buffer work_deque_buffer;
+
+/**
+ * A Chase-Lev work stealing deque of pointers.
+ * One thread, the owner, pushes and takes items at the bottom like a stack.
+ * Any other thread can steal the oldest item from the top at the same time.
+ * The items are kept in a circular buffer that doubles when it fills up. Replaced buffers
+ * may still be read by thieves, so they are kept until the deque is deinitialized.
+ */
+typedef struct {
+    _Atomic int64_t top;
+    char top_padding[WORK_DEQUE_LINE - sizeof(int64_t)];
+    _Atomic int64_t bottom;
+    _Atomic(work_deque_buffer *) buffer;
+    char bottom_padding[WORK_DEQUE_LINE - sizeof(int64_t) - sizeof(work_deque_buffer *)];
+    const allocator *allocator;
+} work_deque;
+
+// Construction
+work_deque *work_deque_alloc();
+work_deque *work_deque_alloc_with(const allocator *allocator);
+
+// Deletion
+void work_deque_deinit(work_deque *deque);
+void work_deque_dealloc(work_deque **deque);
+void work_deque_delete(work_deque **deque);
+
+// Resizing
+int work_deque_reserve_capacity(work_deque *deque, size_t capacity);
+
+// Accessing
+size_t work_deque_length(work_deque *deque);
+size_t work_deque_capacity(work_deque *deque);
+
+// Mutation
+int work_deque_push(work_deque *deque, void *item);
+bool work_deque_take(work_deque *deque, void **item);
+bool work_deque_steal(work_deque *deque, void **item);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_WORK_DEQUE_H
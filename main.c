@@ -2,11 +2,41 @@
 #include "tests/linked_list_test.h"
 #include "tests/list_stack_test.h"
 #include "tests/array_stack_test.h"
+#include "tests/arena_test.h"
+#include "tests/unrolled_list_test.h"
+#include "tests/compact_list_test.h"
+#include "tests/output_buffer_test.h"
+#include "tests/snapshot_test.h"
+#include "tests/int_reader_test.h"
+#include "tests/concurrent_list_stack_test.h"
+#include "tests/concurrent_array_stack_test.h"
+#include "tests/work_deque_test.h"
+#include "tests/concurrent_list_test.h"
+#include "tests/rcu_list_test.h"
+#include "tests/mpmc_queue_test.h"
+#include "tests/instrument_test.h"
+#include "tests/growth_policy_test.h"
+#include "tests/perf_counters_test.h"
 
 int main() {
     run_linked_list_tests();
     run_list_stack_tests();
     run_array_stack_tests();
+    run_arena_tests();
+    run_unrolled_list_tests();
+    run_compact_list_tests();
+    run_output_buffer_tests();
+    run_snapshot_tests();
+    run_int_reader_tests();
+    run_concurrent_list_stack_tests();
+    run_concurrent_array_stack_tests();
+    run_work_deque_tests();
+    run_concurrent_list_tests();
+    run_rcu_list_tests();
+    run_mpmc_queue_tests();
+    run_instrument_tests();
+    run_growth_policy_tests();
+    run_perf_counters_tests();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#include "../utils/minunit.h"
+#include "../utils/arena.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "../data_structures/stack/array_stack.h"
+#include "arena_test.h"
+
+static arena region;
+static int arr[] = { 1, 2, 3, 4, 5 };
+
+static void test_setup() {
+    arena_init(&region, 256);
+}
+
+static void test_teardown() {
+    arena_release(&region);
+}
+
+MU_TEST(test_alloc_aligned) {
+    char *first = arena_alloc(&region, 3);
+    char *second = arena_alloc(&region, 8);
+    mu_assert(first != NULL && second != NULL, "allocations should succeed");
+    mu_assert((size_t)(second - first) % sizeof(max_align_t) == 0, "allocations should be aligned");
+}
+
+MU_TEST(test_alloc_larger_than_block) {
+    int *values = arena_alloc(&region, 1000 * sizeof(int));
+    values[999] = 7;
+    mu_assert(values[999] == 7, "large allocation should be usable");
+}
+
+MU_TEST(test_realloc_in_place) {
+    int *values = arena_alloc(&region, 4 * sizeof(int));
+    values[3] = 4;
+    int *grown = arena_realloc(&region, values, 4 * sizeof(int), 8 * sizeof(int));
+    mu_assert(grown == values, "last allocation should grow in place");
+    mu_assert(grown[3] == 4, "data should be kept");
+}
+
+MU_TEST(test_realloc_copies) {
+    int *values = arena_alloc(&region, 4 * sizeof(int));
+    values[3] = 4;
+    arena_alloc(&region, 8);
+    int *grown = arena_realloc(&region, values, 4 * sizeof(int), 8 * sizeof(int));
+    mu_assert(grown != values, "earlier allocation should be moved");
+    mu_assert(grown[3] == 4, "data should be copied");
+}
+
+MU_TEST(test_reset_reuses_block) {
+    void *first = arena_alloc(&region, 16);
+    arena_reset(&region);
+    mu_assert(arena_alloc(&region, 16) == first, "memory should be reused after a reset");
+}
+
+MU_TEST(test_containers) {
+    const allocator *allocator = arena_allocator(&region);
+    linked_list *list = linked_list_alloc_with(allocator);
+    array_stack *stack = array_stack_alloc_with(allocator);
+
+    linked_list_init(list, arr, 5);
+    for (int i = 0; i < 100; i++) {
+        linked_list_append(list, i);
+        array_stack_push(stack, i);
+    }
+
+    mu_assert(list->length == 105, "list length should be 105");
+    mu_assert(linked_list_element(list, -1) == 99, "last element should be 99");
+    mu_assert(array_stack_peak(stack) == 99, "top element should be 99");
+
+    // Deleting is optional, but must not hand arena memory to free
+    linked_list_delete(&list);
+    array_stack_delete(&stack);
+    arena_reset(&region);
+}
+
+MU_TEST_SUITE(arena_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_alloc_aligned);
+    MU_RUN_TEST(test_alloc_larger_than_block);
+    MU_RUN_TEST(test_realloc_in_place);
+    MU_RUN_TEST(test_realloc_copies);
+    MU_RUN_TEST(test_reset_reuses_block);
+    MU_RUN_TEST(test_containers);
+}
+
+void run_arena_tests() {
+    MU_RUN_SUITE(arena_tests);
+    MU_REPORT();
+}
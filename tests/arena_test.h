@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_ARENA_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_ARENA_TEST_H
+
+void run_arena_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_ARENA_TEST_H
@@ -59,6 +59,23 @@ MU_TEST(test_pop) {
     mu_assert(array_stack_peak(stack) == 4, "top element should now be 4");
 }
 
+MU_TEST(test_format) {
+    char text[32];
+    output_buffer out;
+    output_buffer_init_memory(&out, text, sizeof(text));
+    array_stack_format(stack, &out);
+    mu_assert_int_eq(0, output_buffer_flush(&out));
+    mu_assert_string_eq("[1, 2, 3, 4, 5]", text);
+}
+
+MU_TEST(test_memory_usage) {
+    array_stack_push(stack, 6);
+    memory_usage usage = array_stack_memory_usage(stack);
+    mu_assert(usage.payload == 6 * sizeof(int), "payload should be the bytes of the values");
+    mu_assert(usage.overhead == sizeof(array_stack), "overhead should be the stack itself");
+    mu_assert(usage.slack >= 4 * sizeof(int), "unused capacity should count as slack");
+}
+
 MU_TEST_SUITE(array_stack_tests) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -70,6 +87,8 @@ MU_TEST_SUITE(array_stack_tests) {
     MU_RUN_TEST(test_peak);
     MU_RUN_TEST(test_push);
     MU_RUN_TEST(test_pop);
+    MU_RUN_TEST(test_format);
+    MU_RUN_TEST(test_memory_usage);
 }
 
 void run_array_stack_tests() {
@@ -0,0 +1,144 @@
+//
+// Created by Christopher Szatmary on 2018-12-21.
+//
+
+#include <stdlib.h>
+#include "../utils/minunit.h"
+#include "../data_structures/compact_list/compact_list.h"
+#include "compact_list_test.h"
+
+static compact_list *list = NULL;
+static int arr[] = { 1, 2, 3, 4, 5 };
+
+static void test_setup() {
+    list = compact_list_new(arr, sizeof(arr) / sizeof(int));
+}
+
+static void test_teardown() {
+    compact_list_delete(&list);
+}
+
+MU_TEST(test_length) {
+    mu_assert(list->length == 5, "list length should be 5");
+}
+
+MU_TEST(test_first) {
+    mu_assert(compact_list_first(list) == 1, "first element should be 1");
+}
+
+MU_TEST(test_last) {
+    mu_assert(compact_list_last(list) == 5, "last element should be 5");
+}
+
+MU_TEST(test_element) {
+    mu_assert(compact_list_element(list, 2) == 3, "element at index 2 should be 3");
+}
+
+MU_TEST(test_element_negative_index) {
+    mu_assert(compact_list_element(list, -2) == 4, "element at index -2 should be 4");
+}
+
+MU_TEST(test_append) {
+    compact_list_append(list, 10);
+    mu_assert(compact_list_last(list) == 10, "last element should now be 10");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_prepend) {
+    compact_list_prepend(list, -20);
+    mu_assert(compact_list_first(list) == -20, "first element should now be -20");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_insert) {
+    compact_list_insert(list, 77, 2);
+    mu_assert(compact_list_element(list, 2) == 77, "element at index 2 should now be 77");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_insert_negative) {
+    compact_list_insert(list, 15, -3);
+    mu_assert(compact_list_element(list, 2) == 15, "element at index -3 should now be 15");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_remove_last) {
+    mu_assert(compact_list_remove_last(list) == 5, "removed value should be 5");
+    mu_assert(list->length == 4, "list length should now be 4");
+    mu_assert(compact_list_last(list) == 4, "last element should now be 4");
+}
+
+MU_TEST(test_remove_first) {
+    mu_assert(compact_list_remove_first(list) == 1, "removed value should be 1");
+    mu_assert(list->length == 4, "list length should now be 4");
+    mu_assert(compact_list_first(list) == 2, "first element should now be 2");
+}
+
+MU_TEST(test_remove) {
+    mu_assert(compact_list_remove(list, 2) == 3, "removed value should be 3");
+    mu_assert(list->length == 4, "list length should now be 4");
+    mu_assert(compact_list_element(list, 2) == 4, "the element at index 2 should now be 4");
+}
+
+MU_TEST(test_node_size) {
+    mu_assert(sizeof(compact_node) == 12, "nodes should take 12 bytes");
+}
+
+MU_TEST(test_slot_reuse) {
+    size_t used = list->used;
+    compact_list_remove(list, 2);
+    compact_list_insert(list, 9, 1);
+    mu_assert(list->used == used, "removed slot should be reused");
+    mu_assert(compact_list_element(list, 1) == 9, "element at index 1 should now be 9");
+    mu_assert(compact_list_element(list, 3) == 4, "element at index 3 should now be 4");
+}
+
+MU_TEST(test_relocate) {
+    for (int i = 0; i < 50; i++) {
+        compact_list_insert(list, i, i % 3 == 0 ? 0 : -1);
+    }
+
+    // Copying the node array moves the whole list
+    compact_node *copy = malloc(list->capacity * sizeof(compact_node));
+    memcpy(copy, list->nodes, list->used * sizeof(compact_node));
+    free(list->nodes);
+    list->nodes = copy;
+
+    mu_assert(list->length == 55, "list length should now be 55");
+    mu_assert(compact_list_first(list) == 48, "first element should be 48");
+    mu_assert(compact_list_element(list, -2) == 49, "element at index -2 should be 49");
+    mu_assert(compact_list_ensure_len(list) == 0, "stored length should be correct");
+
+    while (list->length > 0) {
+        compact_list_remove_first(list);
+    }
+    mu_assert(list->head == COMPACT_LIST_NIL && list->tail == COMPACT_LIST_NIL, "list should now be empty");
+}
+
+MU_TEST_SUITE(compact_list_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_length);
+    MU_RUN_TEST(test_first);
+    MU_RUN_TEST(test_last);
+    MU_RUN_TEST(test_element);
+    MU_RUN_TEST(test_element_negative_index);
+
+    MU_RUN_TEST(test_append);
+    MU_RUN_TEST(test_prepend);
+    MU_RUN_TEST(test_insert);
+    MU_RUN_TEST(test_insert_negative);
+
+    MU_RUN_TEST(test_remove_last);
+    MU_RUN_TEST(test_remove_first);
+    MU_RUN_TEST(test_remove);
+
+    MU_RUN_TEST(test_node_size);
+    MU_RUN_TEST(test_slot_reuse);
+    MU_RUN_TEST(test_relocate);
+}
+
+void run_compact_list_tests() {
+    MU_RUN_SUITE(compact_list_tests);
+    MU_REPORT();
+}
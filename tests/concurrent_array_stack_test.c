@@ -0,0 +1,138 @@
+//
+// Created by Christopher Szatmary on 2018-12-26.
+//
+
+#include <pthread.h>
+#include "../utils/minunit.h"
+#include "../data_structures/stack/concurrent_array_stack.h"
+#include "concurrent_array_stack_test.h"
+
+#define THREAD_COUNT 4
+#define THREAD_OPS 20000
+
+static concurrent_array_stack *stack = NULL;
+static int arr[] = { 1, 2, 3, 4, 5};
+
+typedef struct {
+    int first;
+    bool pairs;
+    long long pushed;
+    long long popped;
+} worker_totals;
+
+static void test_setup() {
+    stack = concurrent_array_stack_new(arr, sizeof(arr) / sizeof(int));
+}
+
+static void test_teardown() {
+    concurrent_array_stack_delete(&stack);
+}
+
+/**
+ * Pushes a range of values unique to the thread, popping after every push
+ * or after every other push.
+ */
+static void *worker(void *context) {
+    worker_totals *totals = context;
+
+    for (int i = 0; i < THREAD_OPS; i++) {
+        int value = totals->first + i;
+        concurrent_array_stack_push(stack, value);
+        totals->pushed += value;
+
+        int popped;
+        if ((totals->pairs || i % 2 == 1) && concurrent_array_stack_try_pop(stack, &popped)) {
+            totals->popped += popped;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Runs THREAD_COUNT workers on the test stack and drains it.
+ * @param pairs Whether the workers pop after every push.
+ * @param remaining Set to the number of values left on the stack after the workers finish.
+ * @return Whether every value pushed was popped exactly once, judging by their sums.
+ */
+static bool run_workers(bool pairs, size_t *remaining) {
+    pthread_t threads[THREAD_COUNT];
+    worker_totals totals[THREAD_COUNT] = {{0}};
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        totals[i].first = (i + 1) * THREAD_OPS;
+        totals[i].pairs = pairs;
+        pthread_create(&threads[i], NULL, worker, &totals[i]);
+    }
+
+    long long pushed = 1 + 2 + 3 + 4 + 5;
+    long long popped = 0;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        pushed += totals[i].pushed;
+        popped += totals[i].popped;
+    }
+
+    *remaining = 0;
+    int value;
+    while (concurrent_array_stack_try_pop(stack, &value)) {
+        popped += value;
+        (*remaining)++;
+    }
+
+    return pushed == popped;
+}
+
+MU_TEST(test_length) {
+    mu_assert(concurrent_array_stack_length(stack) == 5, "stack length should be 5");
+}
+
+MU_TEST(test_push) {
+    concurrent_array_stack_push(stack, 10);
+    mu_assert(concurrent_array_stack_length(stack) == 6, "stack length should now be 6");
+    mu_assert(stack->stack->capacity == 10, "stack capacity should have doubled to 10");
+    mu_assert(concurrent_array_stack_pop(stack) == 10, "top element should be 10");
+}
+
+MU_TEST(test_pop) {
+    mu_assert(concurrent_array_stack_pop(stack) == 5, "removed value should be 5");
+    mu_assert(concurrent_array_stack_length(stack) == 4, "stack length should now be 4");
+    mu_assert(concurrent_array_stack_pop(stack) == 4, "removed value should now be 4");
+}
+
+MU_TEST(test_try_pop_empty) {
+    int value;
+    for (int i = 5; i > 0; i--) {
+        mu_assert(concurrent_array_stack_try_pop(stack, &value) && value == i, "values should come off in reverse order");
+    }
+    mu_assert(!concurrent_array_stack_try_pop(stack, &value), "an empty stack should have nothing to pop");
+    mu_assert(concurrent_array_stack_length(stack) == 0, "stack length should now be 0");
+}
+
+MU_TEST(test_concurrent) {
+    size_t remaining;
+    mu_assert(run_workers(false, &remaining), "every pushed value should be popped exactly once");
+    mu_assert(remaining == 5 + THREAD_COUNT * THREAD_OPS / 2, "half of the pushed values should be left");
+}
+
+MU_TEST(test_concurrent_pairs) {
+    size_t remaining;
+    mu_assert(run_workers(true, &remaining), "every pushed value should be popped exactly once");
+    mu_assert(remaining == 5, "only the initial values should be left");
+}
+
+MU_TEST_SUITE(concurrent_array_stack_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_length);
+    MU_RUN_TEST(test_push);
+    MU_RUN_TEST(test_pop);
+    MU_RUN_TEST(test_try_pop_empty);
+    MU_RUN_TEST(test_concurrent);
+    MU_RUN_TEST(test_concurrent_pairs);
+}
+
+void run_concurrent_array_stack_tests() {
+    MU_RUN_SUITE(concurrent_array_stack_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-26.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_ARRAY_STACK_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_ARRAY_STACK_TEST_H
+
+void run_concurrent_array_stack_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_ARRAY_STACK_TEST_H
@@ -0,0 +1,157 @@
+//
+// Created by Christopher Szatmary on 2018-12-25.
+//
+
+#include <pthread.h>
+#include "../utils/minunit.h"
+#include "../data_structures/stack/concurrent_list_stack.h"
+#include "concurrent_list_stack_test.h"
+
+#define THREAD_COUNT 4
+#define THREAD_OPS 20000
+
+static concurrent_list_stack *stack = NULL;
+static int arr[] = { 1, 2, 3, 4, 5};
+
+typedef struct {
+    int first;
+    long long pushed;
+    long long popped;
+} worker_totals;
+
+static void test_setup() {
+    stack = concurrent_list_stack_new(arr, sizeof(arr) / sizeof(int));
+}
+
+static void test_teardown() {
+    concurrent_list_stack_delete(&stack);
+}
+
+/**
+ * Pushes a range of values unique to the thread, popping after every other push.
+ */
+static void *worker(void *context) {
+    worker_totals *totals = context;
+
+    for (int i = 0; i < THREAD_OPS; i++) {
+        int value = totals->first + i;
+        concurrent_list_stack_push(stack, value);
+        totals->pushed += value;
+
+        int popped;
+        if (i % 2 == 1 && concurrent_list_stack_try_pop(stack, &popped)) {
+            totals->popped += popped;
+        }
+    }
+
+    return NULL;
+}
+
+MU_TEST(test_length) {
+    mu_assert(concurrent_list_stack_length(stack) == 5, "stack length should be 5");
+}
+
+MU_TEST(test_push) {
+    concurrent_list_stack_push(stack, 10);
+    mu_assert(concurrent_list_stack_length(stack) == 6, "stack length should now be 6");
+    mu_assert(concurrent_list_stack_pop(stack) == 10, "top element should be 10");
+}
+
+MU_TEST(test_pop) {
+    mu_assert(concurrent_list_stack_pop(stack) == 5, "removed value should be 5");
+    mu_assert(concurrent_list_stack_length(stack) == 4, "stack length should now be 4");
+    mu_assert(concurrent_list_stack_pop(stack) == 4, "removed value should now be 4");
+}
+
+MU_TEST(test_try_pop_empty) {
+    int value;
+    for (int i = 5; i > 0; i--) {
+        mu_assert(concurrent_list_stack_try_pop(stack, &value) && value == i, "values should come off in reverse order");
+    }
+    mu_assert(!concurrent_list_stack_try_pop(stack, &value), "an empty stack should have nothing to pop");
+    mu_assert(concurrent_list_stack_length(stack) == 0, "stack length should now be 0");
+}
+
+MU_TEST(test_reuse) {
+    // Popped nodes are recycled, so cycling through them shouldn't grow the stack's storage
+    for (int i = 0; i < 1000; i++) {
+        concurrent_list_stack_push(stack, i);
+        mu_assert(concurrent_list_stack_pop(stack) == i, "popped value should be the one just pushed");
+    }
+    mu_assert(atomic_load(&stack->unused) == 6, "only one node beyond the initial ones should have been used");
+
+    for (int i = 0; i < 1000; i++) {
+        concurrent_list_stack_push(stack, i);
+    }
+    for (int i = 999; i >= 0; i--) {
+        mu_assert(concurrent_list_stack_pop(stack) == i, "values should come off in reverse order across chunks");
+    }
+    mu_assert(concurrent_list_stack_pop(stack) == 5, "the initial values should still be below");
+}
+
+MU_TEST(test_shrink) {
+    for (int i = 0; i < 1000; i++) {
+        concurrent_list_stack_push(stack, i);
+    }
+    for (int i = 999; i >= 10; i--) {
+        concurrent_list_stack_pop(stack);
+    }
+
+    mu_assert(atomic_load(&stack->chunks[3]) != NULL, "the burst should have allocated more chunks");
+    mu_assert_int_eq(0, concurrent_list_stack_shrink(stack));
+    mu_assert(atomic_load(&stack->chunks[1]) == NULL, "chunks past the items should be freed");
+    mu_assert(concurrent_list_stack_length(stack) == 15, "stack length should still be 15");
+
+    concurrent_list_stack_push(stack, 42);
+    mu_assert(concurrent_list_stack_pop(stack) == 42, "pushing should work after shrinking");
+    for (int i = 9; i >= 0; i--) {
+        mu_assert(concurrent_list_stack_pop(stack) == i, "values should keep their order");
+    }
+    mu_assert(concurrent_list_stack_pop(stack) == 5, "the initial values should still be below");
+}
+
+MU_TEST(test_concurrent) {
+    pthread_t threads[THREAD_COUNT];
+    worker_totals totals[THREAD_COUNT] = {{0}};
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        totals[i].first = (i + 1) * THREAD_OPS;
+        pthread_create(&threads[i], NULL, worker, &totals[i]);
+    }
+
+    long long pushed = 1 + 2 + 3 + 4 + 5;
+    long long popped = 0;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        pushed += totals[i].pushed;
+        popped += totals[i].popped;
+    }
+
+    size_t remaining = 0;
+    int value;
+    while (concurrent_list_stack_try_pop(stack, &value)) {
+        popped += value;
+        remaining++;
+    }
+
+    mu_assert(pushed == popped, "every pushed value should be popped exactly once");
+    mu_assert(remaining == 5 + THREAD_COUNT * THREAD_OPS / 2, "half of the pushed values should be left");
+    mu_assert(concurrent_list_stack_length(stack) == 0, "stack length should now be 0");
+}
+
+MU_TEST_SUITE(concurrent_list_stack_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_length);
+    MU_RUN_TEST(test_push);
+    MU_RUN_TEST(test_pop);
+    MU_RUN_TEST(test_try_pop_empty);
+    MU_RUN_TEST(test_reuse);
+    MU_RUN_TEST(test_shrink);
+    MU_RUN_TEST(test_concurrent);
+}
+
+void run_concurrent_list_stack_tests() {
+    MU_RUN_SUITE(concurrent_list_stack_tests);
+    MU_REPORT();
+}
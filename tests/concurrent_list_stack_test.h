@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-25.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_STACK_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_STACK_TEST_H
+
+void run_concurrent_list_stack_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_CONCURRENT_LIST_STACK_TEST_H
@@ -0,0 +1,120 @@
+//
+// Created by Christopher Szatmary on 2018-12-28.
+//
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "../utils/minunit.h"
+#include "../utils/error.h"
+#include "../data_structures/concurrent_list/concurrent_list.h"
+#include "concurrent_list_test.h"
+
+#define THREAD_COUNT 4
+#define THREAD_VALUES 500
+
+static concurrent_list *list = NULL;
+static int arr[] = { 1, 2, 3, 4, 5};
+
+static void test_setup() {
+    list = concurrent_list_new(arr, sizeof(arr) / sizeof(int));
+}
+
+static void test_teardown() {
+    concurrent_list_delete(&list);
+}
+
+/**
+ * Inserts a range of values unique to the thread, each after a value shared by all threads,
+ * then removes the odd ones while the other threads are still busy.
+ */
+static void *worker(void *context) {
+    int first = *(int *)context;
+
+    for (int i = 0; i < THREAD_VALUES; i++) {
+        concurrent_list_insert_after(list, 1 + i % 5, first + i);
+    }
+    for (int i = 1; i < THREAD_VALUES; i += 2) {
+        concurrent_list_remove(list, first + i);
+    }
+
+    return NULL;
+}
+
+MU_TEST(test_length) {
+    mu_assert(concurrent_list_length(list) == 5, "list length should be 5");
+}
+
+MU_TEST(test_contains) {
+    mu_assert(concurrent_list_contains(list, 1), "list should contain 1");
+    mu_assert(concurrent_list_contains(list, 5), "list should contain 5");
+    mu_assert(!concurrent_list_contains(list, 6), "list shouldn't contain 6");
+}
+
+MU_TEST(test_prepend) {
+    concurrent_list_prepend(list, 10);
+    mu_assert(list->head.next->data == 10, "first value should now be 10");
+    mu_assert(concurrent_list_length(list) == 6, "list length should now be 6");
+}
+
+MU_TEST(test_insert_after) {
+    mu_assert(concurrent_list_insert_after(list, 3, 10) == EXIT_SUCCESS, "inserting after 3 should succeed");
+    mu_assert(list->head.next->next->next->next->data == 10, "10 should be after 3");
+    mu_assert(concurrent_list_insert_after(list, 5, 11) == EXIT_SUCCESS, "inserting after the last value should succeed");
+    mu_assert(concurrent_list_insert_after(list, 42, 12) == DOES_NOT_EXIST, "inserting after a missing value should fail");
+    mu_assert(concurrent_list_length(list) == 7, "list length should now be 7");
+}
+
+MU_TEST(test_remove) {
+    concurrent_list_prepend(list, 3);
+    mu_assert(concurrent_list_remove(list, 3), "removing 3 should succeed");
+    mu_assert(concurrent_list_contains(list, 3), "only the first 3 should have been removed");
+    mu_assert(concurrent_list_remove(list, 3), "removing the second 3 should succeed");
+    mu_assert(!concurrent_list_contains(list, 3), "no 3 should be left");
+    mu_assert(!concurrent_list_remove(list, 3), "removing a missing value should fail");
+    mu_assert(concurrent_list_remove(list, 5), "removing the last value should succeed");
+    mu_assert(concurrent_list_length(list) == 3, "list length should now be 3");
+}
+
+MU_TEST(test_concurrent) {
+    pthread_t threads[THREAD_COUNT];
+    int firsts[THREAD_COUNT];
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        firsts[i] = (i + 1) * 1000;
+        pthread_create(&threads[i], NULL, worker, &firsts[i]);
+    }
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    bool correct = true;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        for (int i = 0; i < THREAD_VALUES; i++) {
+            correct = correct && concurrent_list_contains(list, firsts[t] + i) == (i % 2 == 0);
+        }
+    }
+    mu_assert(correct, "exactly the even values of every thread should be left");
+    mu_assert(concurrent_list_length(list) == 5 + THREAD_COUNT * THREAD_VALUES / 2, "list length should match");
+
+    size_t walked = 0;
+    for (concurrent_list_node *node = list->head.next; node != NULL; node = node->next) {
+        walked++;
+    }
+    mu_assert(walked == concurrent_list_length(list), "the nodes should still form one chain");
+}
+
+MU_TEST_SUITE(concurrent_list_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_length);
+    MU_RUN_TEST(test_contains);
+    MU_RUN_TEST(test_prepend);
+    MU_RUN_TEST(test_insert_after);
+    MU_RUN_TEST(test_remove);
+    MU_RUN_TEST(test_concurrent);
+}
+
+void run_concurrent_list_tests() {
+    MU_RUN_SUITE(concurrent_list_tests);
+    MU_REPORT();
+}
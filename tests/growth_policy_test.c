@@ -0,0 +1,116 @@
+//
+// Created by Christopher Szatmary on 2019-01-03.
+//
+
+#include "../utils/minunit.h"
+#include "../utils/growth_policy.h"
+#include "../data_structures/stack/array_stack.h"
+#include "growth_policy_test.h"
+
+static array_stack *stack = NULL;
+static int arr[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+static void test_setup() {
+}
+
+static void test_teardown() {
+    if (stack != NULL) {
+        array_stack_delete(&stack);
+    }
+}
+
+/**
+ * Always grows to exactly the capacity needed.
+ */
+static size_t grow_exact(const growth_policy *policy, size_t capacity, size_t needed) {
+    (void)policy;
+    (void)capacity;
+    return needed;
+}
+
+MU_TEST(test_doubling) {
+    growth_policy policy = growth_policy_doubling();
+    mu_assert(policy.grow(&policy, 0, 1) == 2, "capacity should start at 2");
+    mu_assert(policy.grow(&policy, 5, 6) == 10, "capacity should double");
+    mu_assert(policy.grow(&policy, 5, 25) == 40, "capacity should double until it is enough");
+    mu_assert(growth_policy_round(&policy, 15) == 16, "reserved capacity should be rounded to an even number");
+}
+
+MU_TEST(test_geometric) {
+    growth_policy policy = growth_policy_geometric(1.5);
+    size_t capacity = 0;
+    size_t expected[] = { 2, 3, 4, 6, 9, 13, 19 };
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(size_t); i++) {
+        capacity = policy.grow(&policy, capacity, capacity + 1);
+        mu_assert(capacity == expected[i], "capacity should grow by half each time");
+    }
+    mu_assert(growth_policy_round(&policy, 15) == 15, "reserved capacity shouldn't be rounded");
+}
+
+MU_TEST(test_paged) {
+    growth_policy policy = growth_policy_paged(1.5);
+    size_t page = policy.granularity;
+
+    mu_assert(page > 0, "a page should hold some elements");
+    mu_assert(policy.grow(&policy, 0, 1) == page, "capacity should start at one page");
+    mu_assert(policy.grow(&policy, page, page + 1) == 2 * page, "capacity should be rounded up to whole pages");
+    mu_assert(policy.grow(&policy, 10 * page, 10 * page + 1) == 15 * page, "capacity should grow by half");
+    mu_assert(growth_policy_round(&policy, 1) == page, "reserved capacity should be rounded to a page");
+}
+
+MU_TEST(test_capped) {
+    growth_policy policy = growth_policy_capped(2.0, 1000);
+    mu_assert(policy.grow(&policy, 100, 101) == 200, "small capacities should double");
+    mu_assert(policy.grow(&policy, 5000, 5001) == 6000, "large capacities should grow by the limit");
+    mu_assert(policy.grow(&policy, 5000, 7500) == 8000, "capacity should grow in steps of the limit");
+}
+
+MU_TEST(test_stack_policy) {
+    growth_policy policy = growth_policy_geometric(1.5);
+    stack = array_stack_alloc_with_policy(NULL, &policy);
+    mu_assert(array_stack_init(stack, arr, 4) == 0, "init should succeed");
+
+    array_stack_push(stack, 5);
+    mu_assert(stack->capacity == 6, "stack capacity should now be 6");
+    array_stack_push_all(stack, arr, 10);
+    mu_assert(stack->capacity == 19, "stack capacity should now be 19");
+    mu_assert(stack->length == 15, "stack length should now be 15");
+    mu_assert(array_stack_peak(stack) == 10, "top element should be 10");
+
+    array_stack_reserve_capacity(stack, 25);
+    mu_assert(stack->capacity == 25, "reserved capacity shouldn't be rounded");
+}
+
+MU_TEST(test_stack_custom_policy) {
+    growth_policy policy = { grow_exact, 0, 0, 0, 0 };
+    stack = array_stack_alloc_with_policy(NULL, &policy);
+
+    for (int i = 0; i < 5; i++) {
+        array_stack_push(stack, i);
+        mu_assert(stack->capacity == stack->length, "a custom policy should pick the capacity");
+    }
+}
+
+MU_TEST(test_stack_default_policy) {
+    stack = array_stack_alloc();
+    array_stack_push_all(stack, arr, 5);
+    mu_assert(stack->capacity == 8, "the default policy should double from 2");
+}
+
+MU_TEST_SUITE(growth_policy_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_doubling);
+    MU_RUN_TEST(test_geometric);
+    MU_RUN_TEST(test_paged);
+    MU_RUN_TEST(test_capped);
+    MU_RUN_TEST(test_stack_policy);
+    MU_RUN_TEST(test_stack_custom_policy);
+    MU_RUN_TEST(test_stack_default_policy);
+}
+
+void run_growth_policy_tests() {
+    MU_RUN_SUITE(growth_policy_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2019-01-03.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_GROWTH_POLICY_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_GROWTH_POLICY_TEST_H
+
+void run_growth_policy_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_GROWTH_POLICY_TEST_H
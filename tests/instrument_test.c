@@ -0,0 +1,189 @@
+//
+// Created by Christopher Szatmary on 2019-01-02.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../utils/minunit.h"
+#include "../utils/error.h"
+#include "../utils/instrument.h"
+#include "../data_structures/stack/array_stack.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "instrument_test.h"
+
+#define THREAD_VALUES 50
+
+static instrument_counts counts;
+static linked_list *empty_list = NULL;
+
+static void test_setup() {
+    instrument_reset();
+}
+
+static void test_teardown() {
+}
+
+/**
+ * Returns the count a test expects, which is 0 unless the library is built with DSA_INSTRUMENT.
+ */
+static uint64_t expected(uint64_t count) {
+    return instrument_enabled() ? count : 0;
+}
+
+/**
+ * Appends values to a linked list of its own and deletes it.
+ */
+static void *worker(void *context) {
+    (void)context;
+    linked_list *list = linked_list_alloc();
+    for (int i = 0; i < THREAD_VALUES; i++) {
+        linked_list_append(list, i);
+    }
+    linked_list_delete(&list);
+
+    return NULL;
+}
+
+MU_TEST(test_reset) {
+    array_stack *stack = array_stack_alloc();
+    array_stack_push(stack, 1);
+    array_stack_delete(&stack);
+
+    instrument_reset();
+    instrument_snapshot(&counts);
+    mu_assert(counts.counts[INSTRUMENT_ARRAY_STACK][INSTRUMENT_ALLOCS] == 0, "counts should start from 0 after a reset");
+    mu_assert(counts.counts[INSTRUMENT_ARRAY_STACK][INSTRUMENT_FREES] == 0, "counts should start from 0 after a reset");
+}
+
+MU_TEST(test_array_stack_growth) {
+    array_stack *stack = array_stack_alloc();
+    for (int i = 0; i < 100; i++) {
+        array_stack_push(stack, i);
+    }
+    array_stack_delete(&stack);
+
+    // The capacity goes 2, 4, ..., 128 and every resize after the first moves the values so far
+    instrument_snapshot(&counts);
+    mu_assert(counts.counts[INSTRUMENT_ARRAY_STACK][INSTRUMENT_ALLOCS] == expected(1), "the array should be allocated once");
+    mu_assert(counts.counts[INSTRUMENT_ARRAY_STACK][INSTRUMENT_REALLOCS] == expected(6), "the array should be resized 6 times");
+    mu_assert(counts.counts[INSTRUMENT_ARRAY_STACK][INSTRUMENT_BYTES_MOVED] == expected((2 + 4 + 8 + 16 + 32 + 64) * sizeof(int)),
+              "every resize should move the values pushed so far");
+    mu_assert(counts.counts[INSTRUMENT_ARRAY_STACK][INSTRUMENT_FREES] == expected(1), "the array should be freed once");
+}
+
+MU_TEST(test_linked_list_steps) {
+    linked_list *list = linked_list_new((int[]){ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, 10);
+    instrument_reset();
+
+    mu_assert(linked_list_element(list, 3) == 4, "element 3 should be 4");
+    mu_assert(linked_list_element(list, 8) == 9, "element 8 should be 9");
+    instrument_snapshot(&counts);
+    mu_assert(counts.counts[INSTRUMENT_LINKED_LIST][INSTRUMENT_STEPS] == expected(3 + 1), "lookups should walk from the closest end");
+
+    linked_list_delete(&list);
+    instrument_snapshot(&counts);
+    mu_assert(counts.counts[INSTRUMENT_LINKED_LIST][INSTRUMENT_FREES] == expected(10), "every node should be freed");
+}
+
+MU_TEST(test_threads) {
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, worker, NULL);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    instrument_snapshot(&counts);
+    mu_assert(counts.counts[INSTRUMENT_LINKED_LIST][INSTRUMENT_ALLOCS] == expected(4 * THREAD_VALUES),
+              "counts of exited threads should be kept");
+}
+
+MU_TEST(test_memory_tracking) {
+    int64_t live = instrument_live_bytes(INSTRUMENT_ARRAY_STACK);
+    array_stack *stack = array_stack_alloc();
+    for (int i = 0; i < 100; i++) {
+        array_stack_push(stack, i);
+    }
+
+    mu_assert(instrument_live_bytes(INSTRUMENT_ARRAY_STACK) - live == (int64_t)expected(128 * sizeof(int)),
+              "live bytes should follow the capacity");
+    array_stack_delete(&stack);
+    mu_assert(instrument_live_bytes(INSTRUMENT_ARRAY_STACK) == live, "deleting should give back every byte");
+    mu_assert(instrument_peak_bytes(INSTRUMENT_ARRAY_STACK) - live == (int64_t)expected(128 * sizeof(int)),
+              "the peak should be kept after deleting");
+
+    live = instrument_live_bytes(INSTRUMENT_LINKED_LIST);
+    linked_list *list = linked_list_new((int[]){ 1, 2, 3 }, 3);
+    linked_list_append(list, 4);
+    linked_list_remove_first(list);
+    mu_assert(instrument_live_bytes(INSTRUMENT_LINKED_LIST) - live == (int64_t)expected(3 * sizeof(list_node)),
+              "live bytes should follow the nodes");
+    linked_list_delete(&list);
+    mu_assert(instrument_live_bytes(INSTRUMENT_LINKED_LIST) == live, "deleting should give back every byte");
+}
+
+MU_TEST(test_fatal_error) {
+    FILE *output = tmpfile();
+    char text[4096];
+    empty_list = linked_list_alloc();
+
+    // The fatal error exits, so raise it in a child process and read what it wrote to stderr
+    fflush(stdout);
+    fflush(stderr);
+    pid_t child = fork();
+    if (child == 0) {
+        dup2(fileno(output), STDERR_FILENO);
+        linked_list_first(empty_list);
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status;
+    waitpid(child, &status, 0);
+    rewind(output);
+    size_t length = fread(text, 1, sizeof(text) - 1, output);
+    text[length] = '\0';
+    fclose(output);
+    linked_list_delete(&empty_list);
+
+    mu_assert(WIFEXITED(status) && WEXITSTATUS(status) == (LIST_EMPTY & 0xFF), "the child should exit with the error code");
+    mu_assert(strstr(text, "FATAL ERROR") != NULL, "the error should be printed");
+    if (instrument_enabled()) {
+        mu_assert(strstr(text, "\nall,fatal_errors,1\n") != NULL, "the fatal error should be counted in the dump");
+    } else {
+        mu_assert(strstr(text, "fatal_errors") == NULL, "nothing should be dumped without DSA_INSTRUMENT");
+    }
+}
+
+MU_TEST(test_dump) {
+    FILE *file = tmpfile();
+    char line[64];
+
+    mu_assert(instrument_dump(file) == EXIT_SUCCESS, "dumping should succeed");
+    rewind(file);
+    mu_assert(fgets(line, sizeof(line), file) != NULL && strcmp(line, "container,event,count\n") == 0,
+              "the dump should start with a header");
+    mu_assert(fgets(line, sizeof(line), file) != NULL && strcmp(line, "linked_list,allocs,0\n") == 0,
+              "the dump should list every counter");
+    fclose(file);
+}
+
+MU_TEST_SUITE(instrument_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_reset);
+    MU_RUN_TEST(test_array_stack_growth);
+    MU_RUN_TEST(test_linked_list_steps);
+    MU_RUN_TEST(test_threads);
+    MU_RUN_TEST(test_memory_tracking);
+    MU_RUN_TEST(test_fatal_error);
+    MU_RUN_TEST(test_dump);
+}
+
+void run_instrument_tests() {
+    MU_RUN_SUITE(instrument_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2019-01-02.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_INSTRUMENT_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_INSTRUMENT_TEST_H
+
+void run_instrument_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_INSTRUMENT_TEST_H
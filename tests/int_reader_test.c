@@ -0,0 +1,121 @@
+//
+// Created by Christopher Szatmary on 2018-12-24.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include "../utils/minunit.h"
+#include "../utils/error.h"
+#include "../utils/int_reader.h"
+#include "../data_structures/stack/array_stack.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "int_reader_test.h"
+
+static array_stack *stack = NULL;
+static char path[] = "/tmp/dsa_ints_XXXXXX";
+
+static void test_setup() {
+    stack = array_stack_alloc();
+    int fd = mkstemp(path);
+    close(fd);
+}
+
+static void test_teardown() {
+    array_stack_delete(&stack);
+    unlink(path);
+    snprintf(path, sizeof(path), "/tmp/dsa_ints_XXXXXX");
+}
+
+static int stack_sink(void *context, const int *values, size_t count) {
+    return array_stack_push_all(context, values, count);
+}
+
+/**
+ * Parses text into the test stack.
+ * @param text The NUL terminated text to parse.
+ * @return The status of the parse.
+ */
+static int parse(const char *text) {
+    return int_reader_parse(text, strlen(text), stack_sink, stack);
+}
+
+MU_TEST(test_parse_separators) {
+    mu_assert_int_eq(0, parse("1,2\n-3 , 4\r\n\n5\t6"));
+    mu_assert(stack->length == 6, "6 integers should be parsed");
+    int expected[] = { 1, 2, -3, 4, 5, 6 };
+    for (int i = 0; i < 6; i++) {
+        mu_assert_int_eq(expected[i], stack->data[i]);
+    }
+}
+
+MU_TEST(test_parse_long_numbers) {
+    mu_assert_int_eq(0, parse("2147483647,-2147483648,00000000000012345678,123456789,-98765432,\n"));
+    int expected[] = { INT_MAX, INT_MIN, 12345678, 123456789, -98765432 };
+    mu_assert(stack->length == 5, "5 integers should be parsed");
+    for (int i = 0; i < 5; i++) {
+        mu_assert_int_eq(expected[i], stack->data[i]);
+    }
+}
+
+MU_TEST(test_parse_invalid) {
+    mu_assert_int_eq(ERANGE, parse("2147483648"));
+    mu_assert_int_eq(ERANGE, parse("-2147483649,1"));
+    mu_assert_int_eq(ERANGE, parse("99999999999999999999999999"));
+    mu_assert_int_eq(INVALID_NUMBER, parse("12a"));
+    mu_assert_int_eq(INVALID_NUMBER, parse("1,-,2"));
+    mu_assert_int_eq(INVALID_NUMBER, parse("4;5"));
+    mu_assert(stack->length == 0, "nothing should be parsed before an error in the same batch");
+}
+
+MU_TEST(test_read_file) {
+    // Enough text for several reads, so numbers are split across read boundaries
+    FILE *file = fopen(path, "w");
+    long long expected_sum = 0;
+    for (int i = 0; i < 400000; i++) {
+        int value = (i % 7 == 0 ? -1 : 1) * (int)((long long)i * 7919 % 1000003);
+        expected_sum += value;
+        fprintf(file, i % 3 == 0 ? "%d,\n" : "%d\n", value);
+    }
+    fclose(file);
+
+    mu_assert_int_eq(0, array_stack_read(stack, path));
+    mu_assert(stack->length == 400000, "400000 integers should be read");
+    long long sum = 0;
+    for (size_t i = 0; i < stack->length; i++) {
+        sum += stack->data[i];
+    }
+    mu_assert(sum == expected_sum, "integers should match the file");
+
+    linked_list *list = linked_list_alloc();
+    linked_list_append(list, 1);
+    linked_list_reverse(list);
+    mu_assert_int_eq(0, linked_list_read(list, path));
+    mu_assert(list->length == 400001, "400000 integers should be appended");
+    mu_assert_int_eq(1, linked_list_first(list));
+    mu_assert_int_eq(stack->data[399999], linked_list_last(list));
+    mu_assert_int_eq(stack->data[1234], linked_list_element(list, 1235));
+    linked_list_delete(&list);
+}
+
+MU_TEST(test_read_missing_file) {
+    mu_assert_int_eq(ENOENT, array_stack_read(stack, "/tmp/dsa_ints_missing/none"));
+}
+
+MU_TEST_SUITE(int_reader_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_parse_separators);
+    MU_RUN_TEST(test_parse_long_numbers);
+    MU_RUN_TEST(test_parse_invalid);
+    MU_RUN_TEST(test_read_file);
+    MU_RUN_TEST(test_read_missing_file);
+}
+
+void run_int_reader_tests() {
+    MU_RUN_SUITE(int_reader_tests);
+    MU_REPORT();
+}
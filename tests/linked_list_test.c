@@ -2,6 +2,7 @@
 // Created by Christopher Szatmary on 2018-12-09.
 //
 
+#include <stdlib.h>
 #include "../utils/minunit.h"
 #include "../data_structures/linked_list/linked_list.h"
 #include "linked_list_test.h"
@@ -81,6 +82,520 @@ MU_TEST(test_remove) {
     mu_assert(linked_list_element(list, 2) == 4, "the element at index 2 should now be 4");
 }
 
+MU_TEST(test_remove_only_element) {
+    linked_list *single = linked_list_new(arr, 1);
+    mu_assert(linked_list_remove_last(single) == 1, "removed value should be 1");
+    mu_assert(single->head == NULL && single->tail == NULL, "list should now be empty");
+    linked_list_append(single, 7);
+    mu_assert(linked_list_first(single) == 7, "first element should now be 7");
+    linked_list_delete(&single);
+}
+
+MU_TEST(test_node_reuse) {
+    list_node *removed = list->head;
+    linked_list_remove_first(list);
+    linked_list_append(list, 6);
+    mu_assert(list->tail == removed, "removed node should be reused for the next append");
+}
+
+MU_TEST(test_shared_pool) {
+    node_pool pool;
+    linked_list_pool_init(&pool, NULL);
+    linked_list *first = linked_list_alloc_pooled(&pool);
+    linked_list *second = linked_list_alloc_pooled(&pool);
+
+    linked_list_init(first, arr, 5);
+    linked_list_init(second, arr, 3);
+    list_node *removed = first->tail;
+    linked_list_remove_last(first);
+    linked_list_prepend(second, 9);
+    mu_assert(second->head == removed, "node removed from one list should be reused by the other");
+
+    linked_list_delete(&first);
+    linked_list_append(second, 4);
+    mu_assert(second->length == 5, "second list length should now be 5");
+    mu_assert(linked_list_last(second) == 4, "last element should now be 4");
+
+    linked_list_delete(&second);
+    node_pool_release(&pool);
+}
+
+MU_TEST(test_index_random_operations) {
+    int model[600];
+    int model_length = 5;
+    for (int i = 0; i < model_length; i++) {
+        model[i] = arr[i];
+    }
+
+    mu_assert_int_eq(0, linked_list_index_enable(list));
+    srand(42);
+
+    for (int step = 0; step < 4000; step++) {
+        int operation = rand() % 6;
+        int value = rand();
+
+        if (model_length < 2 || (operation < 3 && model_length < 600)) {
+            // Insert at the front, the back or anywhere in between
+            int position = operation == 0 ? 0 : operation == 1 ? model_length : rand() % (model_length + 1);
+            for (int i = model_length; i > position; i--) {
+                model[i] = model[i - 1];
+            }
+            model[position] = value;
+            model_length++;
+
+            if (position == 0) {
+                linked_list_prepend(list, value);
+            } else if (position == model_length - 1) {
+                linked_list_append(list, value);
+            } else {
+                linked_list_insert(list, value, position);
+            }
+        } else {
+            int position = operation == 3 ? 0 : operation == 4 ? model_length - 1 : rand() % model_length;
+            int expected = model[position];
+            for (int i = position; i < model_length - 1; i++) {
+                model[i] = model[i + 1];
+            }
+            model_length--;
+
+            int removed;
+            if (position == 0) {
+                removed = linked_list_remove_first(list);
+            } else if (position == model_length) {
+                removed = linked_list_remove_last(list);
+            } else {
+                removed = linked_list_remove(list, position);
+            }
+            mu_assert_int_eq(expected, removed);
+        }
+
+        int probe = rand() % model_length;
+        mu_assert_int_eq(model[probe], linked_list_element(list, probe));
+    }
+
+    for (int i = 0; i < model_length; i++) {
+        mu_assert_int_eq(model[i], linked_list_element(list, i));
+        mu_assert_int_eq(model[i], linked_list_element(list, i - model_length));
+    }
+}
+
+MU_TEST(test_index_enable_existing) {
+    linked_list_index_enable(list);
+    mu_assert(linked_list_element(list, 3) == 4, "element at index 3 should be 4");
+    linked_list_index_disable(list);
+    mu_assert(list->index == NULL, "index should now be removed");
+    mu_assert(linked_list_element(list, 3) == 4, "element at index 3 should still be 4");
+}
+
+MU_TEST(test_cursor_traversal) {
+    int sum = 0;
+    for (linked_list_cursor cursor = linked_list_cursor_at(list, 0);
+         linked_list_cursor_valid(&cursor); linked_list_cursor_next(&cursor)) {
+        sum += linked_list_cursor_get(&cursor);
+    }
+    mu_assert(sum == 15, "sum of the elements should be 15");
+
+    linked_list_cursor cursor = linked_list_cursor_at(list, -2);
+    mu_assert(linked_list_cursor_get(&cursor) == 4, "cursor at index -2 should be on 4");
+    mu_assert(cursor.position == 3, "cursor at index -2 should be at position 3");
+    linked_list_cursor_prev(&cursor);
+    mu_assert(linked_list_cursor_get(&cursor) == 3, "cursor should now be on 3");
+
+    cursor = linked_list_cursor_at(list, 5);
+    mu_assert(!linked_list_cursor_valid(&cursor), "cursor at the length should be past the end");
+    linked_list_cursor_prev(&cursor);
+    mu_assert(linked_list_cursor_get(&cursor) == 5, "cursor should now be on the last element");
+}
+
+MU_TEST(test_cursor_mutation) {
+    linked_list_cursor cursor = linked_list_cursor_at(list, 2);
+    linked_list_cursor_set(&cursor, 30);
+    linked_list_cursor_insert_before(&cursor, 25);
+    linked_list_cursor_insert_after(&cursor, 35);
+    mu_assert(cursor.position == 3, "cursor should now be at position 3");
+    mu_assert(linked_list_cursor_get(&cursor) == 30, "cursor should still be on 30");
+    mu_assert(linked_list_element(list, 2) == 25, "element at index 2 should now be 25");
+    mu_assert(linked_list_element(list, 4) == 35, "element at index 4 should now be 35");
+
+    mu_assert(linked_list_cursor_remove(&cursor) == 30, "removed value should be 30");
+    mu_assert(linked_list_cursor_get(&cursor) == 35, "cursor should now be on 35");
+    mu_assert(list->length == 6, "list length should now be 6");
+
+    cursor = linked_list_cursor_at(list, -1);
+    linked_list_cursor_remove(&cursor);
+    mu_assert(!linked_list_cursor_valid(&cursor), "cursor should now be past the end");
+    linked_list_cursor_insert_before(&cursor, 9);
+    mu_assert(linked_list_last(list) == 9, "last element should now be 9");
+
+    cursor = linked_list_cursor_at(list, 0);
+    linked_list_cursor_insert_before(&cursor, 0);
+    linked_list_cursor_remove(&cursor);
+    mu_assert(linked_list_first(list) == 0, "first element should now be 0");
+    mu_assert(linked_list_cursor_get(&cursor) == 2, "cursor should now be on 2");
+    mu_assert(linked_list_ensure_len(list) == 0, "stored length should be correct");
+}
+
+MU_TEST(test_cursor_indexed) {
+    linked_list_index_enable(list);
+    for (int i = 0; i < 200; i++) {
+        linked_list_append(list, 6 + i);
+    }
+
+    // Insert a copy after every element, then remove the originals
+    linked_list_cursor cursor = linked_list_cursor_at(list, 0);
+    while (linked_list_cursor_valid(&cursor)) {
+        linked_list_cursor_insert_after(&cursor, -linked_list_cursor_get(&cursor));
+        linked_list_cursor_remove(&cursor);
+        linked_list_cursor_next(&cursor);
+    }
+
+    mu_assert(list->length == 205, "list length should still be 205");
+    for (int i = 0; i < 205; i++) {
+        mu_assert_int_eq(-(i + 1), linked_list_element(list, i));
+    }
+}
+
+MU_TEST(test_init_contiguous) {
+    for (list_node *current = list->head; current->next != NULL; current = current->next) {
+        mu_assert(current->next == current + 1, "nodes should be laid out in list order");
+    }
+
+    // Nodes from the block are recycled like any other node
+    list_node *removed = linked_list_node(list, 2);
+    linked_list_remove(list, 2);
+    linked_list_insert(list, 8, 1);
+    mu_assert(linked_list_node(list, 1) == removed, "removed node should be reused for the next insert");
+
+    for (int i = 0; i < 100; i++) {
+        linked_list_append(list, i);
+        linked_list_remove_first(list);
+    }
+    mu_assert(list->length == 5, "list length should still be 5");
+    mu_assert(linked_list_last(list) == 99, "last element should now be 99");
+}
+
+MU_TEST(test_compact) {
+    linked_list_index_enable(list);
+    for (int i = 0; i < 50; i++) {
+        linked_list_insert(list, 100 + i, 1 + i % 5);
+        linked_list_prepend(list, 200 + i);
+        linked_list_remove(list, 3);
+    }
+    mu_assert(linked_list_fragmentation(list) > 0, "list should be fragmented");
+
+    int expected[55];
+    for (int i = 0; i < 55; i++) {
+        expected[i] = linked_list_element(list, i);
+    }
+
+    mu_assert_int_eq(0, linked_list_compact(list));
+    mu_assert(linked_list_fragmentation(list) == 0, "list should no longer be fragmented");
+    mu_assert(list->length == 55, "list length should still be 55");
+    mu_assert(list->head->previous == NULL && list->tail->next == NULL, "ends should be unlinked");
+    for (int i = 0; i < 55; i++) {
+        mu_assert_int_eq(expected[i], linked_list_element(list, i));
+        mu_assert_int_eq(expected[54 - i], linked_list_element(list, -1 - i));
+    }
+
+    linked_list_remove_last(list);
+    linked_list_append(list, 7);
+    mu_assert(linked_list_last(list) == 7, "last element should now be 7");
+}
+
+MU_TEST(test_search) {
+    linked_list_append(list, 3);
+    linked_list_append(list, 1);
+    mu_assert(linked_list_find(list, 3) == linked_list_node(list, 2), "should find the first 3");
+    mu_assert(linked_list_index_of(list, 1) == 0, "index of 1 should be 0");
+    mu_assert(linked_list_index_of(list, 5) == 4, "index of 5 should be 4");
+    mu_assert(linked_list_index_of(list, 8) == -1, "index of a missing value should be -1");
+    mu_assert(linked_list_find(list, 8) == NULL, "should not find a missing value");
+    mu_assert(linked_list_count(list, 3) == 2, "3 should occur twice");
+    mu_assert(linked_list_contains(list, 5), "list should contain 5");
+    mu_assert(!linked_list_contains(list, 8), "list should not contain 8");
+}
+
+MU_TEST(test_search_indexed) {
+    linked_list_index_enable(list);
+    for (int i = 0; i < 5000; i++) {
+        linked_list_append(list, i % 1000);
+    }
+
+    mu_assert(linked_list_index_of(list, 3) == 2, "index of 3 should be 2");
+    mu_assert(linked_list_index_of(list, 999) == 1004, "index of 999 should be 1004");
+    mu_assert(linked_list_index_of(list, -7) == -1, "index of a missing value should be -1");
+    mu_assert(linked_list_count(list, 3) == 6, "3 should occur 6 times");
+    mu_assert(linked_list_count(list, 999) == 5, "999 should occur 5 times");
+    mu_assert(linked_list_contains(list, 500), "list should contain 500");
+
+    size_t total = 0;
+    for (int value = 0; value < 1000; value++) {
+        total += linked_list_count(list, value);
+    }
+    mu_assert(total == 5005, "every node should be counted once");
+}
+
+MU_TEST(test_sort) {
+    int values[] = { 4, 1, 3, 1, 5, 2, 9, 0, 3 };
+    int sorted[] = { 0, 1, 1, 2, 3, 3, 4, 5, 9 };
+    linked_list *unsorted = linked_list_new(values, 9);
+    list_node *first_one = linked_list_node(unsorted, 1);
+    list_node *second_one = linked_list_node(unsorted, 3);
+
+    linked_list_index_enable(unsorted);
+    linked_list_sort(unsorted);
+    mu_assert(unsorted->length == 9, "list length should still be 9");
+    mu_assert(unsorted->head->previous == NULL && unsorted->tail->next == NULL, "ends should be unlinked");
+    mu_assert(linked_list_node(unsorted, 1) == first_one, "equal elements should keep their order");
+    mu_assert(linked_list_node(unsorted, 2) == second_one, "equal elements should keep their order");
+    for (int i = 0; i < 9; i++) {
+        mu_assert_int_eq(sorted[i], linked_list_element(unsorted, i));
+        mu_assert_int_eq(sorted[8 - i], linked_list_element(unsorted, -1 - i));
+    }
+
+    linked_list_delete(&unsorted);
+}
+
+MU_TEST(test_sort_random) {
+    srand(7);
+    linked_list_index_disable(list);
+    for (int i = 0; i < 1000; i++) {
+        linked_list_append(list, rand() % 100);
+    }
+
+    linked_list_sort(list);
+    mu_assert(list->length == 1005, "list length should still be 1005");
+
+    size_t count = 0;
+    for (list_node *node = list->head; node != NULL; node = node->next) {
+        if (node->next != NULL) {
+            mu_assert(node->data <= node->next->data, "elements should be in ascending order");
+            mu_assert(node->next->previous == node, "previous links should match next links");
+        }
+        count++;
+    }
+    mu_assert(count == 1005, "every node should still be linked");
+}
+
+MU_TEST(test_merge_sorted) {
+    int values[] = { 0, 2, 3, 6 };
+    int merged[] = { 0, 1, 2, 2, 3, 3, 4, 5, 6 };
+    linked_list *other = linked_list_new(values, 4);
+    list_node *other_two = linked_list_node(other, 1);
+
+    mu_assert_int_eq(0, linked_list_merge_sorted(list, other));
+    mu_assert(list->length == 9, "list length should now be 9");
+    mu_assert(other->length == 0 && other->head == NULL && other->tail == NULL, "other list should be empty");
+    mu_assert(linked_list_node(list, 3) == other_two, "nodes should be moved, not copied");
+    for (int i = 0; i < 9; i++) {
+        mu_assert_int_eq(merged[i], linked_list_element(list, i));
+        mu_assert_int_eq(merged[8 - i], linked_list_element(list, -1 - i));
+    }
+
+    // The moved nodes must outlive the list they came from
+    linked_list_delete(&other);
+    linked_list_remove(list, 3);
+    linked_list_append(list, 7);
+    mu_assert(list->length == 9, "list length should still be 9");
+    mu_assert(linked_list_last(list) == 7, "last element should now be 7");
+}
+
+MU_TEST(test_merge_sorted_shared_pool) {
+    node_pool pool;
+    linked_list_pool_init(&pool, NULL);
+    linked_list *first = linked_list_alloc_pooled(&pool);
+    linked_list *second = linked_list_alloc_pooled(&pool);
+    linked_list_init(first, arr, 5);
+    linked_list_init(second, arr, 5);
+
+    // Both lists are indexed, the merged one is rebuilt and the emptied one cleared
+    linked_list_index_enable(first);
+    linked_list_index_enable(second);
+    mu_assert_int_eq(0, linked_list_merge_sorted(first, second));
+    mu_assert(first->length == 10, "first list length should now be 10");
+    for (int i = 0; i < 10; i++) {
+        mu_assert_int_eq(i / 2 + 1, linked_list_element(first, i));
+    }
+
+    // The other list is only left empty and can be used again
+    linked_list_append(second, 8);
+    mu_assert(linked_list_first(second) == 8, "first element of second list should be 8");
+
+    // Merging into a list sharing its pool with others takes over the other list's own pool
+    linked_list *own = linked_list_new(arr, 2);
+    mu_assert_int_eq(0, linked_list_merge_sorted(first, own));
+    mu_assert(first->length == 12, "first list length should now be 12");
+    linked_list_delete(&own);
+    mu_assert_int_eq(1, linked_list_first(first));
+    mu_assert_int_eq(5, linked_list_last(first));
+    mu_assert_int_eq(2, linked_list_element(first, 3));
+
+    linked_list_delete(&first);
+    linked_list_delete(&second);
+    node_pool_release(&pool);
+}
+
+MU_TEST(test_reverse) {
+    linked_list_reverse(list);
+    mu_assert(list->length == 5, "list length should still be 5");
+    mu_assert(linked_list_first(list) == 5, "first element should now be 5");
+    mu_assert(linked_list_last(list) == 1, "last element should now be 1");
+    for (int i = 0; i < 5; i++) {
+        mu_assert_int_eq(5 - i, linked_list_element(list, i));
+    }
+
+    linked_list_append(list, 0);
+    linked_list_prepend(list, 6);
+    linked_list_insert(list, 9, 2);
+    mu_assert_int_eq(9, linked_list_remove(list, 2));
+    mu_assert(linked_list_index_of(list, 6) == 0, "index of 6 should be 0");
+    mu_assert(linked_list_index_of(list, 0) == 6, "index of 0 should be 6");
+
+    linked_list_cursor cursor = linked_list_cursor_at(list, 1);
+    linked_list_cursor_next(&cursor);
+    mu_assert_int_eq(4, linked_list_cursor_get(&cursor));
+
+    linked_list_reverse(list);
+    for (int i = 0; i < 7; i++) {
+        mu_assert_int_eq(i, linked_list_element(list, i));
+    }
+}
+
+MU_TEST(test_concat) {
+    int values[] = { 6, 7, 8 };
+    linked_list *other = linked_list_new(values, 3);
+    list_node *moved = other->head;
+
+    mu_assert_int_eq(0, linked_list_concat(list, other));
+    mu_assert(list->length == 8, "list length should now be 8");
+    mu_assert(other->length == 0 && other->head == NULL, "other list should be empty");
+    mu_assert(linked_list_node(list, 5) == moved, "nodes should be moved, not copied");
+    for (int i = 0; i < 8; i++) {
+        mu_assert_int_eq(i + 1, linked_list_element(list, i));
+    }
+
+    // Only the other list is reversed, so its order is kept
+    linked_list_append(other, 9);
+    linked_list_append(other, 10);
+    linked_list_reverse(other);
+    linked_list_concat(list, other);
+    mu_assert_int_eq(10, linked_list_element(list, 8));
+    mu_assert_int_eq(9, linked_list_last(list));
+
+    linked_list_delete(&other);
+    mu_assert(linked_list_ensure_len(list) == EXIT_SUCCESS, "length should be correct");
+}
+
+MU_TEST(test_splice) {
+    int values[] = { 10, 20, 30, 40 };
+    linked_list *other = linked_list_new(values, 4);
+    linked_list_index_enable(list);
+
+    mu_assert_int_eq(0, linked_list_splice(list, 1, other, 1, 2));
+    mu_assert(list->length == 7, "list length should now be 7");
+    mu_assert(other->length == 2, "other list length should now be 2");
+    int expected[] = { 1, 20, 30, 2, 3, 4, 5 };
+    for (int i = 0; i < 7; i++) {
+        mu_assert_int_eq(expected[i], linked_list_element(list, i));
+    }
+    mu_assert_int_eq(10, linked_list_first(other));
+    mu_assert_int_eq(40, linked_list_last(other));
+
+    // A range from a reversed list keeps the order it is read in
+    linked_list_reverse(other);
+    linked_list_splice(list, -1, other, 0, 2);
+    mu_assert_int_eq(40, linked_list_element(list, 6));
+    mu_assert_int_eq(10, linked_list_element(list, 7));
+    mu_assert_int_eq(5, linked_list_last(list));
+    mu_assert(other->head == NULL && other->tail == NULL, "other list should be empty");
+
+    linked_list_delete(&other);
+    mu_assert(linked_list_ensure_len(list) == EXIT_SUCCESS, "length should be correct");
+}
+
+MU_TEST(test_split_at) {
+    linked_list *rest = linked_list_split_at(list, 2);
+    mu_assert(list->length == 2, "list length should now be 2");
+    mu_assert(rest->length == 3, "rest length should be 3");
+    mu_assert_int_eq(2, linked_list_last(list));
+    mu_assert_int_eq(3, linked_list_first(rest));
+    mu_assert_int_eq(5, linked_list_last(rest));
+
+    // The lists share a pool, so either can be deleted first
+    linked_list_delete(&list);
+    linked_list_append(rest, 6);
+    mu_assert_int_eq(6, linked_list_element(rest, 3));
+
+    linked_list_reverse(rest);
+    list = linked_list_split_at(rest, -1);
+    mu_assert_int_eq(3, linked_list_first(list));
+    mu_assert_int_eq(4, linked_list_last(rest));
+    linked_list_delete(&rest);
+}
+
+MU_TEST(test_format) {
+    char text[64];
+    output_buffer out;
+    output_buffer_init_memory(&out, text, sizeof(text));
+    linked_list_format(list, &out);
+    mu_assert_int_eq(0, output_buffer_flush(&out));
+    mu_assert_string_eq("1 -> 2 -> 3 -> 4 -> 5 -> NULL", text);
+
+    output_buffer_init_memory(&out, text, sizeof(text));
+    linked_list_reverse(list);
+    linked_list_format_rev(list, &out);
+    mu_assert_int_eq(0, output_buffer_flush(&out));
+    mu_assert_string_eq("1 <- 2 <- 3 <- 4 <- 5 <- NULL", text);
+}
+
+MU_TEST(test_memory_usage) {
+    size_t node_size = list->pool->node_size;
+    memory_usage usage = linked_list_memory_usage(list);
+    mu_assert(usage.payload == 5 * sizeof(int), "payload should be the bytes of the values");
+    mu_assert(usage.overhead >= sizeof(linked_list) + sizeof(node_pool) + 5 * (node_size - sizeof(int)),
+              "overhead should include the list, its pool and the links of every node");
+
+    // The initial nodes fill a block of their own, so appending carves a fresh chunk
+    linked_list_append(list, 6);
+    usage = linked_list_memory_usage(list);
+    mu_assert(usage.slack >= 31 * node_size, "nodes not carved yet should count as slack");
+
+    mu_assert_int_eq(0, linked_list_index_enable(list));
+    mu_assert(linked_list_memory_usage(list).overhead > usage.overhead, "the index should add overhead");
+}
+
+MU_TEST(test_memory_usage_shared_pool) {
+    node_pool pool;
+    linked_list_pool_init(&pool, NULL);
+    linked_list *first = linked_list_alloc_pooled(&pool);
+    linked_list *second = linked_list_alloc_pooled(&pool);
+    linked_list_init(first, arr, 5);
+
+    memory_usage usage = linked_list_memory_usage(first);
+    mu_assert(usage.payload == 5 * sizeof(int), "payload should be the bytes of the values");
+    mu_assert(usage.slack == 0, "spare nodes of a shared pool shouldn't be counted");
+
+    linked_list_delete(&first);
+    linked_list_delete(&second);
+    node_pool_release(&pool);
+}
+
+MU_TEST(test_append_all) {
+    int values[] = { 6, 7, 8 };
+    linked_list_index_enable(list);
+    mu_assert_int_eq(0, linked_list_append_all(list, values, 3));
+    mu_assert(list->length == 8, "list length should now be 8");
+    for (int i = 0; i < 8; i++) {
+        mu_assert_int_eq(i + 1, linked_list_element(list, i));
+    }
+
+    linked_list_reverse(list);
+    linked_list_append_all(list, values, 2);
+    mu_assert_int_eq(6, linked_list_element(list, 8));
+    mu_assert_int_eq(7, linked_list_last(list));
+    mu_assert_int_eq(1, linked_list_element(list, 7));
+}
+
 MU_TEST_SUITE(linked_list_tests) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -98,6 +613,39 @@ MU_TEST_SUITE(linked_list_tests) {
     MU_RUN_TEST(test_remove_last);
     MU_RUN_TEST(test_remove_first);
     MU_RUN_TEST(test_remove);
+    MU_RUN_TEST(test_remove_only_element);
+
+    MU_RUN_TEST(test_node_reuse);
+    MU_RUN_TEST(test_shared_pool);
+    MU_RUN_TEST(test_init_contiguous);
+
+    MU_RUN_TEST(test_index_random_operations);
+    MU_RUN_TEST(test_index_enable_existing);
+
+    MU_RUN_TEST(test_cursor_traversal);
+    MU_RUN_TEST(test_cursor_mutation);
+    MU_RUN_TEST(test_cursor_indexed);
+
+    MU_RUN_TEST(test_compact);
+
+    MU_RUN_TEST(test_search);
+    MU_RUN_TEST(test_search_indexed);
+
+    MU_RUN_TEST(test_sort);
+    MU_RUN_TEST(test_sort_random);
+    MU_RUN_TEST(test_merge_sorted);
+    MU_RUN_TEST(test_merge_sorted_shared_pool);
+
+    MU_RUN_TEST(test_reverse);
+    MU_RUN_TEST(test_concat);
+    MU_RUN_TEST(test_splice);
+    MU_RUN_TEST(test_split_at);
+
+    MU_RUN_TEST(test_format);
+    MU_RUN_TEST(test_append_all);
+
+    MU_RUN_TEST(test_memory_usage);
+    MU_RUN_TEST(test_memory_usage_shared_pool);
 }
 
 void run_linked_list_tests() {
@@ -37,6 +37,14 @@ MU_TEST(test_pop) {
     mu_assert(list_stack_peak(stack) == 4, "top element should now be 4");
 }
 
+MU_TEST(test_memory_usage) {
+    memory_usage usage = list_stack_memory_usage(stack);
+    mu_assert(usage.payload == 5 * sizeof(int), "payload should be the bytes of the values");
+    mu_assert(usage.overhead == sizeof(list_stack) + 5 * (sizeof(stack_node) - sizeof(int)),
+              "overhead should be the stack and the links of every node");
+    mu_assert(usage.slack % 5 == 0, "every node should waste the same amount");
+}
+
 MU_TEST_SUITE(list_stack_tests) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -44,6 +52,7 @@ MU_TEST_SUITE(list_stack_tests) {
     MU_RUN_TEST(test_peak);
     MU_RUN_TEST(test_push);
     MU_RUN_TEST(test_pop);
+    MU_RUN_TEST(test_memory_usage);
 }
 
 void run_list_stack_tests() {
@@ -0,0 +1,181 @@
+//
+// Created by Christopher Szatmary on 2018-12-30.
+//
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "../utils/minunit.h"
+#include "../utils/error.h"
+#include "../data_structures/queue/mpmc_queue.h"
+#include "mpmc_queue_test.h"
+
+#define THREAD_COUNT 4
+#define THREAD_VALUES 5000
+
+static mpmc_queue *queue = NULL;
+
+static void test_setup() {
+    queue = mpmc_queue_new(8);
+}
+
+static void test_teardown() {
+    mpmc_queue_delete(&queue);
+}
+
+/**
+ * Pushes a range of values unique to the thread, sleeping whenever the small queue is full.
+ */
+static void *producer(void *context) {
+    int first = *(int *)context;
+
+    for (int i = 0; i < THREAD_VALUES; i++) {
+        mpmc_queue_push(queue, first + i);
+    }
+
+    return NULL;
+}
+
+/**
+ * Pops as many values as one producer pushes and adds them up.
+ */
+static void *consumer(void *context) {
+    long *sum = context;
+
+    for (int i = 0; i < THREAD_VALUES; i++) {
+        *sum += mpmc_queue_pop(queue);
+    }
+
+    return NULL;
+}
+
+MU_TEST(test_capacity) {
+    mu_assert(mpmc_queue_capacity(queue) == 8, "queue capacity should be 8");
+    mpmc_queue_delete(&queue);
+
+    queue = mpmc_queue_new(5);
+    mu_assert(mpmc_queue_capacity(queue) == 8, "capacity should round up to 8");
+    mu_assert(mpmc_queue_init(queue, 16) == SPACE_ALREADY_ALLOCATED, "initializing twice should fail");
+}
+
+MU_TEST(test_fifo) {
+    for (int i = 0; i < 5; i++) {
+        mu_assert(mpmc_queue_try_push(queue, i + 1), "pushing should succeed");
+    }
+    mu_assert(mpmc_queue_length(queue) == 5, "queue length should be 5");
+
+    int value = 0;
+    for (int i = 0; i < 5; i++) {
+        mu_assert(mpmc_queue_try_pop(queue, &value) && value == i + 1, "values should come out in order");
+    }
+    mu_assert(mpmc_queue_length(queue) == 0, "queue should be empty");
+}
+
+MU_TEST(test_full_and_empty) {
+    int value = 0;
+    mu_assert(!mpmc_queue_try_pop(queue, &value), "popping an empty queue should fail");
+
+    // Go around the ring a few times to use every slot more than once
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 8; i++) {
+            mu_assert(mpmc_queue_try_push(queue, lap * 8 + i), "pushing should succeed until full");
+        }
+        mu_assert(!mpmc_queue_try_push(queue, 42), "pushing a full queue should fail");
+
+        for (int i = 0; i < 8; i++) {
+            mu_assert(mpmc_queue_pop(queue) == lap * 8 + i, "values should come out in order");
+        }
+        mu_assert(!mpmc_queue_try_pop(queue, &value), "popping an empty queue should fail");
+    }
+}
+
+MU_TEST(test_push_all) {
+    int values[] = { 1, 2, 3, 4, 5, 6 };
+    mu_assert(mpmc_queue_try_push(queue, 0), "pushing should succeed");
+    mu_assert(mpmc_queue_try_push_all(queue, values, 6) == 6, "all 6 values should fit");
+    mu_assert(mpmc_queue_try_push_all(queue, values, 6) == 1, "only 1 more value should fit");
+    mu_assert(mpmc_queue_try_push_all(queue, values, 6) == 0, "no value should fit");
+
+    for (int i = 0; i < 7; i++) {
+        mu_assert(mpmc_queue_pop(queue) == i, "values should come out in order");
+    }
+    mu_assert(mpmc_queue_pop(queue) == 1, "the last value should be the first of the second batch");
+}
+
+MU_TEST(test_pop_all) {
+    int values[8];
+    mu_assert(mpmc_queue_try_pop_all(queue, values, 8) == 0, "popping an empty queue should remove nothing");
+
+    for (int i = 0; i < 5; i++) {
+        mpmc_queue_push(queue, i + 1);
+    }
+    mu_assert(mpmc_queue_try_pop_all(queue, values, 3) == 3, "3 values should be removed");
+    mu_assert(values[0] == 1 && values[2] == 3, "values should come out in order");
+    mu_assert(mpmc_queue_try_pop_all(queue, values, 8) == 2, "the 2 remaining values should be removed");
+    mu_assert(values[0] == 4 && values[1] == 5, "values should come out in order");
+}
+
+MU_TEST(test_batch_peer_in_flight) {
+    int values[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    int value;
+    mu_assert(mpmc_queue_try_push_all(queue, values, 8) == 8, "all 8 values should fit");
+
+    // Claim position 0 like a pop that is preempted before it frees the slot
+    atomic_fetch_add(&queue->head, 1);
+    mu_assert(mpmc_queue_try_pop(queue, &value) && value == 1, "the next pop should succeed");
+    mu_assert(mpmc_queue_try_push_all(queue, values, 4) == 0, "a batch shouldn't wait for the slot of a pop in flight");
+
+    atomic_store(&queue->slots[0].sequence, 8);
+    mu_assert(mpmc_queue_try_push_all(queue, values, 4) == 2, "only the freed slots should be claimed");
+    mu_assert(mpmc_queue_try_pop_all(queue, values, 8) == 8, "every value should be removed");
+
+    // Claim position 10 like a push that is preempted before it fills the slot
+    atomic_fetch_add(&queue->tail, 1);
+    mu_assert(mpmc_queue_try_push(queue, 7), "the next push should succeed");
+    mu_assert(mpmc_queue_try_pop_all(queue, values, 8) == 0, "a batch shouldn't wait for the slot of a push in flight");
+
+    queue->slots[2].data = 6;
+    atomic_store(&queue->slots[2].sequence, 11);
+    mu_assert(mpmc_queue_try_pop_all(queue, values, 8) == 2, "both values should be removed once filled");
+    mu_assert(values[0] == 6 && values[1] == 7, "values should come out in order");
+}
+
+MU_TEST(test_concurrent) {
+    pthread_t producers[THREAD_COUNT];
+    pthread_t consumers[THREAD_COUNT];
+    int firsts[THREAD_COUNT];
+    long sums[THREAD_COUNT] = { 0 };
+
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        firsts[i] = i * THREAD_VALUES;
+        pthread_create(&consumers[i], NULL, consumer, &sums[i]);
+        pthread_create(&producers[i], NULL, producer, &firsts[i]);
+    }
+
+    long total = 0;
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        total += sums[i];
+    }
+
+    long count = (long)THREAD_COUNT * THREAD_VALUES;
+    mu_assert(total == count * (count - 1) / 2, "every value should be popped exactly once");
+    mu_assert(mpmc_queue_length(queue) == 0, "queue should be empty");
+}
+
+MU_TEST_SUITE(mpmc_queue_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_capacity);
+    MU_RUN_TEST(test_fifo);
+    MU_RUN_TEST(test_full_and_empty);
+    MU_RUN_TEST(test_push_all);
+    MU_RUN_TEST(test_pop_all);
+    MU_RUN_TEST(test_batch_peer_in_flight);
+    MU_RUN_TEST(test_concurrent);
+}
+
+void run_mpmc_queue_tests() {
+    MU_RUN_SUITE(mpmc_queue_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,84 @@
+//
+// Created by Christopher Szatmary on 2018-12-22.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <unistd.h>
+#include "../utils/minunit.h"
+#include "../utils/output_buffer.h"
+#include "output_buffer_test.h"
+
+static output_buffer out;
+static char text[64];
+
+static void test_setup() {
+    output_buffer_init_memory(&out, text, sizeof(text));
+}
+
+static void test_teardown() {
+}
+
+MU_TEST(test_format_int) {
+    int values[] = { 0, 7, 10, 99, 100, -1, -42, 123456789, INT_MAX, INT_MIN };
+    for (size_t i = 0; i < sizeof(values) / sizeof(int); i++) {
+        char expected[32];
+        char formatted[FORMAT_INT_MAX_LENGTH + 1];
+        snprintf(expected, sizeof(expected), "%d", values[i]);
+        formatted[format_int(formatted, values[i])] = '\0';
+        mu_assert_string_eq(expected, formatted);
+    }
+}
+
+MU_TEST(test_write_memory) {
+    output_buffer_write(&out, "a=", 2);
+    output_buffer_write_int(&out, -15);
+    mu_assert_int_eq(0, output_buffer_flush(&out));
+    mu_assert_string_eq("a=-15", text);
+    mu_assert(out.total == 5, "total should be 5");
+}
+
+MU_TEST(test_write_memory_truncated) {
+    for (int i = 0; i < 20; i++) {
+        output_buffer_write_int(&out, 1000 + i);
+    }
+
+    mu_assert_int_eq(ENOBUFS, output_buffer_flush(&out));
+    mu_assert(strlen(text) == sizeof(text) - 1, "memory should be filled up to the terminator");
+    mu_assert(strncmp(text, "10001001", 8) == 0, "text should start with the first numbers");
+    mu_assert(out.total == 80, "total should count the text that didn't fit");
+}
+
+MU_TEST(test_write_fd) {
+    int fds[2];
+    mu_assert(pipe(fds) == 0, "pipe should be created");
+
+    output_buffer *piped = malloc(sizeof(output_buffer));
+    output_buffer_init_fd(piped, fds[1]);
+    output_buffer_write(piped, "x", 1);
+    output_buffer_write_int(piped, 42);
+    mu_assert_int_eq(0, output_buffer_flush(piped));
+    free(piped);
+    close(fds[1]);
+
+    char received[8] = { 0 };
+    mu_assert(read(fds[0], received, sizeof(received) - 1) == 3, "3 bytes should be written");
+    mu_assert_string_eq("x42", received);
+    close(fds[0]);
+}
+
+MU_TEST_SUITE(output_buffer_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_format_int);
+    MU_RUN_TEST(test_write_memory);
+    MU_RUN_TEST(test_write_memory_truncated);
+    MU_RUN_TEST(test_write_fd);
+}
+
+void run_output_buffer_tests() {
+    MU_RUN_SUITE(output_buffer_tests);
+    MU_REPORT();
+}
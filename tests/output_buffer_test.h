@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-22.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_OUTPUT_BUFFER_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_OUTPUT_BUFFER_TEST_H
+
+void run_output_buffer_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_OUTPUT_BUFFER_TEST_H
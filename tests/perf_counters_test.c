@@ -0,0 +1,107 @@
+//
+// Created by Christopher Szatmary on 2019-01-04.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "../utils/minunit.h"
+#include "../utils/perf_counters.h"
+#include "perf_counters_test.h"
+
+// Any descriptor other than -1 marks a counter as available, printing never uses it
+#define FAKE_FD 0
+
+static perf_counters counters;
+static char line[256];
+
+static void test_setup() {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters.fds[i] = -1;
+        counters.values[i] = 0;
+    }
+}
+
+static void test_teardown() {
+}
+
+/**
+ * Prints the counters into the line buffer.
+ * @param ops The number of operations passed on to perf_counters_fprint.
+ */
+static void print_line(uint64_t ops) {
+    FILE *file = tmpfile();
+    perf_counters_fprint(&counters, file, ops);
+    rewind(file);
+    if (fgets(line, sizeof(line), file) == NULL) {
+        line[0] = '\0';
+    }
+    fclose(file);
+}
+
+MU_TEST(test_measure) {
+    int status = perf_counters_open(&counters);
+    mu_assert((status == EXIT_SUCCESS) == perf_counters_any(&counters), "opening should succeed if any counter opened");
+
+    volatile long sum = 0;
+    perf_counters_start(&counters);
+    for (long i = 0; i < 100000; i++) {
+        sum += i;
+    }
+    perf_counters_stop(&counters);
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (!perf_counters_available(&counters, (perf_counter)i)) {
+            mu_assert(counters.values[i] == 0, "unavailable counters should read 0");
+        }
+    }
+
+    print_line(0);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (i != PERF_INSTRUCTIONS) {
+            mu_assert(strstr(line, perf_counters_name((perf_counter)i)) != NULL, "every counter should be printed");
+        }
+    }
+    mu_assert(strstr(line, " ipc ") != NULL, "instructions per cycle should be printed");
+
+    perf_counters_close(&counters);
+    mu_assert(!perf_counters_any(&counters), "closing should leave no counter open");
+}
+
+MU_TEST(test_print_unavailable) {
+    print_line(0);
+    mu_assert_string_eq(" cycles - ipc - cache-misses - branch-misses - page-faults -\n", line);
+}
+
+MU_TEST(test_print_without_cycles) {
+    counters.fds[PERF_INSTRUCTIONS] = FAKE_FD;
+    counters.values[PERF_INSTRUCTIONS] = 100;
+    counters.fds[PERF_PAGE_FAULTS] = FAKE_FD;
+    counters.values[PERF_PAGE_FAULTS] = 7;
+
+    print_line(0);
+    mu_assert_string_eq(" cycles - ipc - cache-misses - branch-misses - page-faults 7\n", line);
+}
+
+MU_TEST(test_print_per_op) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters.fds[i] = FAKE_FD;
+        counters.values[i] = 10 * (uint64_t)(i + 1);
+    }
+
+    print_line(4);
+    mu_assert_string_eq(" cycles 2.500/op ipc 2.00 cache-misses 7.500/op branch-misses 10.000/op page-faults 12.500/op\n", line);
+}
+
+MU_TEST_SUITE(perf_counters_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_measure);
+    MU_RUN_TEST(test_print_unavailable);
+    MU_RUN_TEST(test_print_without_cycles);
+    MU_RUN_TEST(test_print_per_op);
+}
+
+void run_perf_counters_tests() {
+    MU_RUN_SUITE(perf_counters_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2019-01-04.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_PERF_COUNTERS_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_PERF_COUNTERS_TEST_H
+
+void run_perf_counters_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_PERF_COUNTERS_TEST_H
@@ -0,0 +1,197 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "../utils/minunit.h"
+#include "../data_structures/rcu_list/rcu_list.h"
+#include "rcu_list_test.h"
+
+#define READER_COUNT 3
+#define WRITER_OPS 20000
+
+static rcu_list *list = NULL;
+static epoch_reader *reader = NULL;
+static int arr[] = { 1, 2, 3, 4, 5};
+static _Atomic size_t freed;
+static _Atomic bool writer_done;
+
+static void *counting_alloc(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+    (void)context;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void *context, void *ptr, size_t size) {
+    (void)context;
+    (void)size;
+    atomic_fetch_add(&freed, 1);
+    free(ptr);
+}
+
+static const allocator counting_allocator = { counting_alloc, counting_realloc, counting_free, NULL };
+
+static void test_setup() {
+    list = rcu_list_alloc_with(&counting_allocator);
+    rcu_list_init(list, arr, sizeof(arr) / sizeof(int));
+    reader = rcu_list_reader_register(list);
+    atomic_store(&freed, 0);
+}
+
+static void test_teardown() {
+    rcu_list_reader_unregister(reader);
+    rcu_list_delete(&list);
+}
+
+/**
+ * Walks the list over and over while a writer changes it, checking that every value it sees
+ * is an initial one or one the writer could have written, and that the list never gets shorter than 5.
+ */
+static void *checker(void *context) {
+    epoch_reader *own = rcu_list_reader_register(list);
+    bool *valid = context;
+
+    while (!atomic_load(&writer_done)) {
+        rcu_list_read_lock(list, own);
+        size_t length = 0;
+        for (rcu_list_node *node = rcu_list_head(list); node != NULL; node = rcu_list_next(node)) {
+            *valid = *valid && (node->data % 2 == 1 || node->data <= 5);
+            length++;
+        }
+        *valid = *valid && length >= 5;
+        rcu_list_read_unlock(own);
+    }
+
+    rcu_list_reader_unregister(own);
+    return NULL;
+}
+
+MU_TEST(test_length) {
+    mu_assert(rcu_list_length(list) == 5, "list length should be 5");
+}
+
+MU_TEST(test_read) {
+    rcu_list_read_lock(list, reader);
+    mu_assert(rcu_list_first(list) == 1, "first element should be 1");
+    mu_assert(rcu_list_element(list, 3) == 4, "element 3 should be 4");
+    mu_assert(rcu_list_contains(list, 5), "list should contain 5");
+    mu_assert(!rcu_list_contains(list, 6), "list shouldn't contain 6");
+    rcu_list_read_unlock(reader);
+}
+
+MU_TEST(test_insert) {
+    rcu_list_prepend(list, 0);
+    rcu_list_append(list, 7);
+    rcu_list_insert(list, 6, -1);
+    rcu_list_insert(list, 10, 3);
+
+    int expected[] = { 0, 1, 2, 10, 3, 4, 5, 6, 7 };
+    rcu_list_read_lock(list, reader);
+    size_t i = 0;
+    bool same = true;
+    for (rcu_list_node *node = rcu_list_head(list); node != NULL; node = rcu_list_next(node), i++) {
+        same = same && i < 9 && node->data == expected[i];
+    }
+    rcu_list_read_unlock(reader);
+
+    mu_assert(same && i == 9, "values should be in the expected order");
+    mu_assert(list->tail->data == 7, "tail should be 7");
+    mu_assert(rcu_list_length(list) == 9, "list length should now be 9");
+}
+
+MU_TEST(test_remove) {
+    mu_assert(rcu_list_remove(list, 0) == 1, "removed value should be 1");
+    mu_assert(rcu_list_remove(list, -1) == 5, "removed value should be 5");
+    mu_assert(list->tail->data == 4, "tail should now be 4");
+    rcu_list_append(list, 8);
+    mu_assert(list->tail->data == 8, "tail should now be 8");
+    mu_assert(rcu_list_length(list) == 4, "list length should now be 4");
+}
+
+MU_TEST(test_set) {
+    rcu_list_read_lock(list, reader);
+    rcu_list_node *old = rcu_list_head(list);
+    rcu_list_set(list, 0, 10);
+    rcu_list_set(list, -1, 50);
+
+    mu_assert(old->data == 1, "a reader should still see the old node");
+    mu_assert(rcu_list_first(list) == 10, "the list should see the new value");
+    rcu_list_read_unlock(reader);
+
+    mu_assert(list->tail->data == 50, "tail should now be 50");
+}
+
+MU_TEST(test_deferred_free) {
+    rcu_list_read_lock(list, reader);
+    rcu_list_node *second = rcu_list_next(rcu_list_head(list));
+
+    rcu_list_remove(list, 1);
+    epoch_reclaim(&list->epoch);
+    mu_assert(atomic_load(&freed) == 0, "a node a reader may be on shouldn't be freed");
+    mu_assert(second->data == 2 && rcu_list_next(second) != NULL, "the removed node should still lead back into the list");
+
+    rcu_list_read_unlock(reader);
+    mu_assert(epoch_reclaim(&list->epoch) == 1 && atomic_load(&freed) == 1, "the node should be freed once the reader left");
+
+    // Nodes removed while no reader is inside are freed in batches
+    for (int i = 0; i < EPOCH_RECLAIM_BATCH; i++) {
+        rcu_list_append(list, i);
+        rcu_list_remove(list, -1);
+    }
+    mu_assert(atomic_load(&freed) == 1 + EPOCH_RECLAIM_BATCH, "a full batch should have been freed");
+
+    rcu_list_remove(list, 0);
+    rcu_list_synchronize(list);
+    mu_assert(atomic_load(&freed) == 2 + EPOCH_RECLAIM_BATCH, "synchronize should free everything retired");
+}
+
+MU_TEST(test_concurrent) {
+    pthread_t readers[READER_COUNT];
+    bool valid[READER_COUNT];
+    atomic_store(&writer_done, false);
+
+    for (int i = 0; i < READER_COUNT; i++) {
+        valid[i] = true;
+        pthread_create(&readers[i], NULL, checker, &valid[i]);
+    }
+
+    // Keep every value odd and the list at least 5 long, while replacing and removing nodes
+    for (int i = 0; i < WRITER_OPS; i++) {
+        rcu_list_append(list, 2 * i + 1);
+        rcu_list_set(list, i % 5, 2 * i + 3);
+        rcu_list_remove(list, 0);
+    }
+    atomic_store(&writer_done, true);
+
+    bool all_valid = true;
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_join(readers[i], NULL);
+        all_valid = all_valid && valid[i];
+    }
+
+    mu_assert(all_valid, "readers should only see complete, odd nodes");
+    mu_assert(rcu_list_length(list) == 5, "list length should still be 5");
+}
+
+MU_TEST_SUITE(rcu_list_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_length);
+    MU_RUN_TEST(test_read);
+    MU_RUN_TEST(test_insert);
+    MU_RUN_TEST(test_remove);
+    MU_RUN_TEST(test_set);
+    MU_RUN_TEST(test_deferred_free);
+    MU_RUN_TEST(test_concurrent);
+}
+
+void run_rcu_list_tests() {
+    MU_RUN_SUITE(rcu_list_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,129 @@
+//
+// Created by Christopher Szatmary on 2018-12-23.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "../utils/minunit.h"
+#include "../utils/error.h"
+#include "../data_structures/linked_list/linked_list.h"
+#include "../data_structures/stack/array_stack.h"
+#include "snapshot_test.h"
+
+static char path[] = "/tmp/dsa_snapshot_XXXXXX";
+static int arr[] = { 1, 2, 3, 4, 5 };
+
+static void test_setup() {
+    int fd = mkstemp(path);
+    close(fd);
+}
+
+static void test_teardown() {
+    unlink(path);
+    snprintf(path, sizeof(path), "/tmp/dsa_snapshot_XXXXXX");
+}
+
+/**
+ * Flips one bit of a byte in a file.
+ * @param offset The offset of the byte from the start of the file.
+ */
+static void corrupt(long offset) {
+    FILE *file = fopen(path, "r+b");
+    fseek(file, offset, SEEK_SET);
+    int byte = fgetc(file);
+    fseek(file, offset, SEEK_SET);
+    fputc(byte ^ 1, file);
+    fclose(file);
+}
+
+MU_TEST(test_array_stack_round_trip) {
+    array_stack *saved = array_stack_new(arr, 5);
+    mu_assert_int_eq(0, array_stack_save(saved, path));
+    array_stack_delete(&saved);
+
+    array_stack *loaded = array_stack_alloc();
+    mu_assert_int_eq(0, array_stack_load(loaded, path, true));
+    mu_assert(loaded->length == 5, "stack length should be 5");
+    mu_assert(loaded->capacity >= 5, "stack capacity should cover the payload");
+    mu_assert(loaded->mapping.address != NULL, "data should be used from the mapping");
+    mu_assert_int_eq(5, array_stack_peak(loaded));
+
+    // Writes stay private to the mapping, and growing moves the data off it
+    array_stack_pop(loaded);
+    array_stack_push(loaded, 9);
+    size_t capacity = loaded->capacity;
+    for (size_t i = loaded->length; i <= capacity; i++) {
+        array_stack_push(loaded, (int)i);
+    }
+    mu_assert(loaded->mapping.address == NULL, "data should have moved to the allocator");
+    mu_assert_int_eq(9, loaded->data[4]);
+    mu_assert_int_eq((int)capacity, array_stack_pop(loaded));
+    array_stack_delete(&loaded);
+
+    array_stack *again = array_stack_alloc();
+    mu_assert_int_eq(0, array_stack_load(again, path, true));
+    mu_assert_int_eq(5, array_stack_peak(again));
+    array_stack_delete(&again);
+}
+
+MU_TEST(test_linked_list_round_trip) {
+    linked_list *saved = linked_list_new(arr, 5);
+    linked_list_reverse(saved);
+    mu_assert_int_eq(0, linked_list_save(saved, path));
+    linked_list_delete(&saved);
+
+    linked_list *loaded = linked_list_alloc();
+    mu_assert_int_eq(0, linked_list_load(loaded, path));
+    mu_assert(loaded->length == 5, "list length should be 5");
+    for (int i = 0; i < 5; i++) {
+        mu_assert_int_eq(5 - i, linked_list_element(loaded, i));
+    }
+    mu_assert_int_eq(LIST_NOT_EMPTY, linked_list_load(loaded, path));
+    linked_list_delete(&loaded);
+
+    // Both containers share the format
+    array_stack *stack = array_stack_alloc();
+    mu_assert_int_eq(0, array_stack_load(stack, path, true));
+    mu_assert_int_eq(1, array_stack_peak(stack));
+    array_stack_delete(&stack);
+}
+
+MU_TEST(test_corrupt_snapshot) {
+    array_stack *saved = array_stack_new(arr, 5);
+    array_stack_save(saved, path);
+    array_stack_delete(&saved);
+
+    // A damaged payload is only noticed when verifying
+    corrupt((long)sizeof(snapshot_header) + 2 * (long)sizeof(int));
+    array_stack *loaded = array_stack_alloc();
+    mu_assert_int_eq(INVALID_SNAPSHOT, array_stack_load(loaded, path, true));
+    mu_assert_int_eq(0, array_stack_load(loaded, path, false));
+    array_stack_delete(&loaded);
+
+    linked_list *list = linked_list_alloc();
+    mu_assert_int_eq(INVALID_SNAPSHOT, linked_list_load(list, path));
+
+    // A damaged header is always rejected
+    corrupt(0);
+    loaded = array_stack_alloc();
+    mu_assert_int_eq(INVALID_SNAPSHOT, array_stack_load(loaded, path, false));
+    array_stack_delete(&loaded);
+
+    truncate(path, sizeof(snapshot_header) - 1);
+    mu_assert_int_eq(INVALID_SNAPSHOT, linked_list_load(list, path));
+    linked_list_delete(&list);
+}
+
+MU_TEST_SUITE(snapshot_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_array_stack_round_trip);
+    MU_RUN_TEST(test_linked_list_round_trip);
+    MU_RUN_TEST(test_corrupt_snapshot);
+}
+
+void run_snapshot_tests() {
+    MU_RUN_SUITE(snapshot_tests);
+    MU_REPORT();
+}
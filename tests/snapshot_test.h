@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-23.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_SNAPSHOT_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_SNAPSHOT_TEST_H
+
+void run_snapshot_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_SNAPSHOT_TEST_H
@@ -0,0 +1,137 @@
+//
+// Created by Christopher Szatmary on 2018-12-18.
+//
+
+#include "../utils/minunit.h"
+#include "../data_structures/unrolled_list/unrolled_list.h"
+#include "unrolled_list_test.h"
+
+static unrolled_list *list = NULL;
+static int arr[] = { 1, 2, 3, 4, 5 };
+
+static void test_setup() {
+    list = unrolled_list_new(arr, sizeof(arr) / sizeof(int));
+}
+
+static void test_teardown() {
+    unrolled_list_delete(&list);
+}
+
+MU_TEST(test_length) {
+    mu_assert(list->length == 5, "list length should be 5");
+}
+
+MU_TEST(test_first) {
+    mu_assert(unrolled_list_first(list) == 1, "first element should be 1");
+}
+
+MU_TEST(test_last) {
+    mu_assert(unrolled_list_last(list) == 5, "last element should be 5");
+}
+
+MU_TEST(test_element) {
+    mu_assert(unrolled_list_element(list, 2) == 3, "element at index 2 should be 3");
+}
+
+MU_TEST(test_element_negative_index) {
+    mu_assert(unrolled_list_element(list, -2) == 4, "element at index -2 should be 4");
+}
+
+MU_TEST(test_append) {
+    unrolled_list_append(list, 10);
+    mu_assert(unrolled_list_last(list) == 10, "last element should now be 10");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_prepend) {
+    unrolled_list_prepend(list, -20);
+    mu_assert(unrolled_list_first(list) == -20, "first element should now be -20");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_insert) {
+    unrolled_list_insert(list, 77, 2);
+    mu_assert(unrolled_list_element(list, 2) == 77, "element at index 2 should now be 77");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_insert_negative) {
+    unrolled_list_insert(list, 15, -3);
+    mu_assert(unrolled_list_element(list, 2) == 15, "element at index -3 should now be 15");
+    mu_assert(list->length == 6, "list length should now be 6");
+}
+
+MU_TEST(test_remove_last) {
+    mu_assert(unrolled_list_remove_last(list) == 5, "removed value should be 5");
+    mu_assert(list->length == 4, "list length should now be 4");
+    mu_assert(unrolled_list_last(list) == 4, "last element should now be 4");
+}
+
+MU_TEST(test_remove_first) {
+    mu_assert(unrolled_list_remove_first(list) == 1, "removed value should be 1");
+    mu_assert(list->length == 4, "list length should now be 4");
+    mu_assert(unrolled_list_first(list) == 2, "first element should now be 2");
+}
+
+MU_TEST(test_remove) {
+    mu_assert(unrolled_list_remove(list, 2) == 3, "removed value should be 3");
+    mu_assert(list->length == 4, "list length should now be 4");
+    mu_assert(unrolled_list_element(list, 2) == 4, "the element at index 2 should now be 4");
+}
+
+MU_TEST(test_many_nodes) {
+    unrolled_list_deinit(list);
+    for (int i = 0; i < 100; i++) {
+        unrolled_list_append(list, i);
+    }
+
+    // Inserting into full nodes splits them
+    for (int i = 0; i < 20; i++) {
+        unrolled_list_insert(list, 1000 + i, 50);
+    }
+    mu_assert(list->length == 120, "list length should now be 120");
+    mu_assert(unrolled_list_element(list, 50) == 1019, "element at index 50 should be 1019");
+    mu_assert(unrolled_list_element(list, 69) == 1000, "element at index 69 should be 1000");
+    mu_assert(unrolled_list_element(list, 70) == 50, "element at index 70 should be 50");
+    mu_assert(unrolled_list_element(list, -1) == 99, "element at index -1 should be 99");
+
+    // Removing them again merges the half empty nodes
+    for (int i = 0; i < 20; i++) {
+        unrolled_list_remove(list, 50);
+    }
+    for (int i = 0; i < 100; i++) {
+        mu_assert_int_eq(i, unrolled_list_element(list, i));
+    }
+    mu_assert(unrolled_list_ensure_len(list) == 0, "stored length should be correct");
+
+    while (list->length > 0) {
+        unrolled_list_remove_last(list);
+    }
+    mu_assert(list->head == NULL && list->tail == NULL, "list should now be empty");
+}
+
+MU_TEST_SUITE(unrolled_list_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_length);
+    MU_RUN_TEST(test_first);
+    MU_RUN_TEST(test_last);
+    MU_RUN_TEST(test_element);
+    MU_RUN_TEST(test_element_negative_index);
+
+    MU_RUN_TEST(test_append);
+    MU_RUN_TEST(test_prepend);
+    MU_RUN_TEST(test_insert);
+    MU_RUN_TEST(test_insert_negative);
+
+    MU_RUN_TEST(test_remove_last);
+    MU_RUN_TEST(test_remove_first);
+    MU_RUN_TEST(test_remove);
+
+    MU_RUN_TEST(test_many_nodes);
+}
+
+void run_unrolled_list_tests() {
+    MU_RUN_SUITE(unrolled_list_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,228 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../utils/minunit.h"
+#include "../utils/error.h"
+#include "../utils/task_pool.h"
+#include "../data_structures/work_deque/work_deque.h"
+#include "work_deque_test.h"
+
+#define THIEF_COUNT 3
+#define ITEM_COUNT 100000
+#define SUM_LENGTH 100000
+#define SUM_CUTOFF 1000
+
+static work_deque *deque = NULL;
+static _Atomic int claimed[ITEM_COUNT];
+static _Atomic bool owner_done;
+
+typedef struct {
+    const int *values;
+    size_t length;
+    long long sum;
+} sum_range;
+
+static void test_setup() {
+    deque = work_deque_alloc();
+}
+
+static void test_teardown() {
+    work_deque_delete(&deque);
+}
+
+static void *item_of(size_t index) {
+    return (void *)(uintptr_t)(index + 1);
+}
+
+static size_t index_of(void *item) {
+    return (size_t)(uintptr_t)item - 1;
+}
+
+/**
+ * Steals items until the owner is done and the deque is empty.
+ */
+static void *thief(void *context) {
+    (void)context;
+    void *item;
+
+    while (!atomic_load(&owner_done) || work_deque_length(deque) > 0) {
+        if (work_deque_steal(deque, &item)) {
+            atomic_fetch_add(&claimed[index_of(item)], 1);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Sums a range of values, splitting it into tasks until it is small.
+ */
+static void parallel_sum(task_pool *pool, void *argument) {
+    sum_range *range = argument;
+
+    if (range->length <= SUM_CUTOFF) {
+        range->sum = 0;
+        for (size_t i = 0; i < range->length; i++) {
+            range->sum += range->values[i];
+        }
+        return;
+    }
+
+    size_t half = range->length / 2;
+    sum_range left = { range->values, half, 0 };
+    sum_range right = { range->values + half, range->length - half, 0 };
+
+    task left_task;
+    task_pool_spawn(pool, &left_task, parallel_sum, &left);
+    parallel_sum(pool, &right);
+    task_pool_wait(pool, &left_task);
+
+    range->sum = left.sum + right.sum;
+}
+
+MU_TEST(test_take) {
+    void *item;
+    mu_assert(!work_deque_take(deque, &item), "an empty deque should have nothing to take");
+
+    for (size_t i = 0; i < 3; i++) {
+        work_deque_push(deque, item_of(i));
+    }
+    mu_assert(work_deque_length(deque) == 3, "deque length should be 3");
+
+    for (size_t i = 3; i > 0; i--) {
+        mu_assert(work_deque_take(deque, &item) && index_of(item) == i - 1, "the owner should take the newest item first");
+    }
+    mu_assert(!work_deque_take(deque, &item), "the deque should now be empty");
+}
+
+MU_TEST(test_steal) {
+    void *item;
+    mu_assert(!work_deque_steal(deque, &item), "an empty deque should have nothing to steal");
+
+    for (size_t i = 0; i < 3; i++) {
+        work_deque_push(deque, item_of(i));
+    }
+
+    mu_assert(work_deque_steal(deque, &item) && index_of(item) == 0, "a thief should steal the oldest item first");
+    mu_assert(work_deque_take(deque, &item) && index_of(item) == 2, "the owner should still take the newest item");
+    mu_assert(work_deque_steal(deque, &item) && index_of(item) == 1, "the last item should be stolen");
+    mu_assert(work_deque_length(deque) == 0, "deque length should now be 0");
+}
+
+MU_TEST(test_grow) {
+    void *item;
+
+    // Wrap around the buffer a few times before it has to grow
+    for (size_t i = 0; i < 10; i++) {
+        work_deque_push(deque, item_of(i));
+        work_deque_steal(deque, &item);
+    }
+    mu_assert(work_deque_capacity(deque) == 2, "deque capacity should still be 2");
+
+    for (size_t i = 0; i < 100; i++) {
+        work_deque_push(deque, item_of(i));
+    }
+    mu_assert(work_deque_capacity(deque) == 128, "deque capacity should have doubled to 128");
+    mu_assert(work_deque_steal(deque, &item) && index_of(item) == 0, "the oldest item should survive growing");
+
+    for (size_t i = 100; i > 1; i--) {
+        mu_assert(work_deque_take(deque, &item) && index_of(item) == i - 1, "items should keep their order");
+    }
+}
+
+MU_TEST(test_reserve_capacity) {
+    mu_assert(work_deque_reserve_capacity(deque, 100) == EXIT_SUCCESS, "reserving should succeed");
+    mu_assert(work_deque_capacity(deque) == 128, "capacity should be rounded up to 128");
+    mu_assert(work_deque_reserve_capacity(deque, 64) == SPACE_ALREADY_ALLOCATED, "shrinking should be refused");
+}
+
+MU_TEST(test_concurrent_steal) {
+    pthread_t thieves[THIEF_COUNT];
+    atomic_store(&owner_done, false);
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        atomic_store(&claimed[i], 0);
+    }
+
+    for (int i = 0; i < THIEF_COUNT; i++) {
+        pthread_create(&thieves[i], NULL, thief, NULL);
+    }
+
+    // Push in bursts and take some back, so the owner and thieves race for the last items
+    void *item;
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        work_deque_push(deque, item_of(i));
+        if (i % 3 == 0 && work_deque_take(deque, &item)) {
+            atomic_fetch_add(&claimed[index_of(item)], 1);
+        }
+    }
+    while (work_deque_take(deque, &item)) {
+        atomic_fetch_add(&claimed[index_of(item)], 1);
+    }
+    atomic_store(&owner_done, true);
+
+    for (int i = 0; i < THIEF_COUNT; i++) {
+        pthread_join(thieves[i], NULL);
+    }
+
+    bool once = true;
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        once = once && atomic_load(&claimed[i]) == 1;
+    }
+    mu_assert(once, "every item should be taken or stolen exactly once");
+}
+
+MU_TEST(test_task_pool_sum) {
+    static int values[SUM_LENGTH];
+    long long expected = 0;
+    for (int i = 0; i < SUM_LENGTH; i++) {
+        values[i] = i % 1000 - 500;
+        expected += values[i];
+    }
+
+    task_pool pool;
+    mu_assert(task_pool_init(&pool, 4) == EXIT_SUCCESS, "the pool should start");
+
+    for (int run = 0; run < 3; run++) {
+        sum_range range = { values, SUM_LENGTH, 0 };
+        task_pool_run(&pool, parallel_sum, &range);
+        mu_assert(range.sum == expected, "the parallel sum should match the serial sum");
+    }
+
+    task_pool_release(&pool);
+}
+
+MU_TEST(test_task_pool_outside_job) {
+    static int values[SUM_CUTOFF * 4];
+    for (int i = 0; i < SUM_CUTOFF * 4; i++) {
+        values[i] = 1;
+    }
+
+    // Without a pool job running, spawned tasks run right away on the calling thread
+    task_pool pool;
+    task_pool_init(&pool, 2);
+    sum_range range = { values, SUM_CUTOFF * 4, 0 };
+    parallel_sum(&pool, &range);
+    mu_assert(range.sum == SUM_CUTOFF * 4, "the sum should be computed inline");
+    task_pool_release(&pool);
+}
+
+MU_TEST_SUITE(work_deque_tests) {
+    MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
+
+    MU_RUN_TEST(test_take);
+    MU_RUN_TEST(test_steal);
+    MU_RUN_TEST(test_grow);
+    MU_RUN_TEST(test_reserve_capacity);
+    MU_RUN_TEST(test_concurrent_steal);
+    MU_RUN_TEST(test_task_pool_sum);
+    MU_RUN_TEST(test_task_pool_outside_job);
+}
+
+void run_work_deque_tests() {
+    MU_RUN_SUITE(work_deque_tests);
+    MU_REPORT();
+}
@@ -0,0 +1,10 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_WORK_DEQUE_TEST_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_WORK_DEQUE_TEST_H
+
+void run_work_deque_tests();
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_WORK_DEQUE_TEST_H
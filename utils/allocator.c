@@ -0,0 +1,104 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#include <stdlib.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "allocator.h"
+
+/* Heap */
+
+static void *heap_alloc(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static void *heap_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+    (void)context;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void heap_free(void *context, void *ptr, size_t size) {
+    (void)context;
+    (void)size;
+    free(ptr);
+}
+
+const allocator heap_allocator = { heap_alloc, heap_realloc, heap_free, NULL };
+
+/* Allocation */
+
+/**
+ * Allocates memory using the given allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if the allocation failed.
+ */
+void *allocator_alloc(const allocator *allocator, size_t size) {
+    if (allocator == NULL) {
+        return malloc(size);
+    }
+
+    return allocator->alloc(allocator->context, size);
+}
+
+/**
+ * Resizes memory previously allocated with the given allocator.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @param ptr A pointer to the memory to resize, or NULL to allocate.
+ * @param old_size The current size of the memory in bytes.
+ * @param new_size The desired size of the memory in bytes.
+ * @return A pointer to the resized memory, or NULL if the allocation failed.
+ */
+void *allocator_realloc(const allocator *allocator, void *ptr, size_t old_size, size_t new_size) {
+    if (allocator == NULL) {
+        return realloc(ptr, new_size);
+    }
+
+    return allocator->realloc(allocator->context, ptr, old_size, new_size);
+}
+
+/**
+ * Releases memory previously allocated with the given allocator.
+ * Does nothing for allocators that only release memory in bulk.
+ * @param allocator A pointer to the allocator, or NULL to use the heap.
+ * @param ptr A pointer to the memory to release.
+ * @param size The size of the memory in bytes.
+ */
+void allocator_free(const allocator *allocator, void *ptr, size_t size) {
+    if (allocator == NULL) {
+        free(ptr);
+    } else if (allocator->free != NULL) {
+        allocator->free(allocator->context, ptr, size);
+    }
+}
+
+/**
+ * Checks whether an allocator releases individual allocations.
+ * @param allocator A pointer to the allocator, or NULL for the heap.
+ * @return false if memory is only released in bulk, so per-node teardown can be skipped.
+ */
+bool allocator_frees(const allocator *allocator) {
+    return allocator == NULL || allocator->free != NULL;
+}
+
+/**
+ * Estimates the bytes an allocator spends on a block beyond the size asked for.
+ * Only the heap is measured, as its size word and rounding up, other allocators report 0.
+ * @param allocator A pointer to the allocator, or NULL for the heap.
+ * @param ptr A pointer to memory previously allocated with the allocator.
+ * @param size The size the memory was allocated with in bytes.
+ * @return The number of bytes.
+ */
+size_t allocator_slack(const allocator *allocator, void *ptr, size_t size) {
+#ifdef __GLIBC__
+    if (ptr != NULL && (allocator == NULL || allocator == &heap_allocator)) {
+        return malloc_usable_size(ptr) + sizeof(size_t) - size;
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_ALLOCATOR_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_ALLOCATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * A memory allocator containers can be built on.
+ * A NULL free function means memory is only ever released in bulk (e.g. by an arena),
+ * so containers may skip walking their nodes on teardown.
+ */
+typedef struct {
+    void *(*alloc)(void *context, size_t size);
+    void *(*realloc)(void *context, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(void *context, void *ptr, size_t size);
+    void *context;
+} allocator;
+
+/**
+ * How the memory held by a container is spent. payload is the bytes of the elements themselves,
+ * overhead the links, headers and bookkeeping around them, and slack the memory reserved but
+ * unused, including what the allocator spends on each block beyond the size asked for.
+ */
+typedef struct {
+    size_t payload;
+    size_t overhead;
+    size_t slack;
+} memory_usage;
+
+extern const allocator heap_allocator;
+
+// Allocation
+void *allocator_alloc(const allocator *allocator, size_t size);
+void *allocator_realloc(const allocator *allocator, void *ptr, size_t old_size, size_t new_size);
+void allocator_free(const allocator *allocator, void *ptr, size_t size);
+bool allocator_frees(const allocator *allocator);
+size_t allocator_slack(const allocator *allocator, void *ptr, size_t size);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_ALLOCATOR_H
@@ -0,0 +1,177 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+#define DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ALIGNMENT sizeof(max_align_t)
+#define ALIGN_UP(size) (((size) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT)
+
+struct arena_block {
+    arena_block *next;
+    size_t size;
+    size_t used;
+};
+
+#define BLOCK_HEADER_SIZE ALIGN_UP(sizeof(arena_block))
+
+/* Helpers */
+
+static void *allocator_arena_alloc(void *context, size_t size) {
+    return arena_alloc(context, size);
+}
+
+static void *allocator_arena_realloc(void *context, void *ptr, size_t old_size, size_t new_size) {
+    return arena_realloc(context, ptr, old_size, new_size);
+}
+
+/**
+ * Returns a pointer to the first unused byte of a block.
+ * @param block A pointer to the block.
+ * @return A pointer to the free space in the block.
+ */
+static char *block_free_space(arena_block *block) {
+    return (char *)block + BLOCK_HEADER_SIZE + block->used;
+}
+
+/**
+ * Allocates a new block large enough for the given size and makes it the current block.
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes the block must be able to hold.
+ * @return A pointer to the new block, or NULL if the allocation failed.
+ */
+static arena_block *block_new(arena *arena, size_t size) {
+    size_t block_size = size > arena->block_size ? size : arena->block_size;
+    arena_block *block = malloc(BLOCK_HEADER_SIZE + block_size);
+
+    if (block != NULL) {
+        block->next = arena->blocks;
+        block->size = block_size;
+        block->used = 0;
+        arena->blocks = block;
+    }
+
+    return block;
+}
+
+/* Construction */
+
+/**
+ * Initializes an empty arena.
+ * @param arena A pointer to the arena.
+ * @param block_size The size in bytes of the blocks the arena allocates from, or 0 for the default.
+ */
+void arena_init(arena *arena, size_t block_size) {
+    arena->blocks = NULL;
+    arena->block_size = block_size == 0 ? DEFAULT_BLOCK_SIZE : ALIGN_UP(block_size);
+    arena->last = NULL;
+    arena->allocator.alloc = allocator_arena_alloc;
+    arena->allocator.realloc = allocator_arena_realloc;
+    arena->allocator.free = NULL;
+    arena->allocator.context = arena;
+}
+
+/**
+ * Returns an allocator that allocates from the arena.
+ * Containers created with it never free individual nodes and are released by resetting the arena.
+ * @param arena A pointer to the arena.
+ * @return A pointer to the arena's allocator, valid for as long as the arena.
+ */
+const allocator *arena_allocator(arena *arena) {
+    return &arena->allocator;
+}
+
+/* Deletion */
+
+/**
+ * Releases everything allocated from the arena at once.
+ * The most recent block is kept so the arena can be reused without allocating.
+ * @param arena A pointer to the arena.
+ */
+void arena_reset(arena *arena) {
+    if (arena->blocks == NULL) {
+        return;
+    }
+
+    arena_block *current = arena->blocks->next;
+    while (current != NULL) {
+        arena_block *next = current->next;
+        free(current);
+        current = next;
+    }
+
+    arena->blocks->next = NULL;
+    arena->blocks->used = 0;
+    arena->last = NULL;
+}
+
+/**
+ * Releases everything allocated from the arena and deallocates all of its blocks.
+ * @param arena A pointer to the arena.
+ */
+void arena_release(arena *arena) {
+    arena_reset(arena);
+    free(arena->blocks);
+    arena->blocks = NULL;
+}
+
+/* Allocation */
+
+/**
+ * Allocates memory from the arena.
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if the allocation failed.
+ */
+void *arena_alloc(arena *arena, size_t size) {
+    size = ALIGN_UP(size == 0 ? 1 : size);
+
+    arena_block *block = arena->blocks;
+    if (block == NULL || block->size - block->used < size) {
+        block = block_new(arena, size);
+        if (block == NULL) {
+            return NULL;
+        }
+    }
+
+    void *ptr = block_free_space(block);
+    block->used += size;
+    arena->last = ptr;
+
+    return ptr;
+}
+
+/**
+ * Resizes memory allocated from the arena.
+ * The most recent allocation grows in place when its block has room, otherwise the data is copied.
+ * @param arena A pointer to the arena.
+ * @param ptr A pointer to the memory to resize, or NULL to allocate.
+ * @param old_size The current size of the memory in bytes.
+ * @param new_size The desired size of the memory in bytes.
+ * @return A pointer to the resized memory, or NULL if the allocation failed.
+ */
+void *arena_realloc(arena *arena, void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return arena_alloc(arena, new_size);
+    }
+
+    arena_block *block = arena->blocks;
+    if (ptr == arena->last) {
+        size_t offset = (char *)ptr - ((char *)block + BLOCK_HEADER_SIZE);
+        size_t aligned_size = ALIGN_UP(new_size == 0 ? 1 : new_size);
+        if (block->size - offset >= aligned_size) {
+            block->used = offset + aligned_size;
+            return ptr;
+        }
+    }
+
+    void *new_ptr = arena_alloc(arena, new_size);
+    if (new_ptr != NULL) {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    }
+
+    return new_ptr;
+}
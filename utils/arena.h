@@ -0,0 +1,32 @@
+//
+// Created by Christopher Szatmary on 2018-12-17.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_ARENA_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_ARENA_H
+
+#include <stddef.h>
+#include "allocator.h"
+
+typedef struct arena_block arena_block;
+
+typedef struct {
+    arena_block *blocks;
+    size_t block_size;
+    void *last;
+    allocator allocator;
+} arena;
+
+// Construction
+void arena_init(arena *arena, size_t block_size);
+const allocator *arena_allocator(arena *arena);
+
+// Deletion
+void arena_reset(arena *arena);
+void arena_release(arena *arena);
+
+// Allocation
+void *arena_alloc(arena *arena, size_t size);
+void *arena_realloc(arena *arena, void *ptr, size_t old_size, size_t new_size);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_ARENA_H
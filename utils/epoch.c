@@ -0,0 +1,207 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#include <stdlib.h>
+#include <sched.h>
+#include "epoch.h"
+
+// Entries the retired array starts with, it doubles past it
+#define RETIRED_INITIAL_CAPACITY 16
+
+/* Helpers */
+
+/**
+ * Finds the oldest epoch any reader is still reading in.
+ * @param domain A pointer to the epoch domain.
+ * @return The oldest active epoch, or UINT64_MAX if no reader is in a read section.
+ */
+static uint64_t oldest_active(epoch_domain *domain) {
+    uint64_t oldest = UINT64_MAX;
+
+    for (size_t i = 0; i < EPOCH_MAX_READERS; i++) {
+        uint64_t active = atomic_load(&domain->readers[i].active);
+        if (active != 0 && active < oldest) {
+            oldest = active;
+        }
+    }
+
+    return oldest;
+}
+
+/**
+ * Frees the retired allocations that are older than an epoch.
+ * @param domain A pointer to the epoch domain.
+ * @param before Allocations retired in an epoch before this one are freed.
+ * @return The number of allocations freed.
+ */
+static size_t free_retired(epoch_domain *domain, uint64_t before) {
+    size_t kept = 0;
+
+    for (size_t i = 0; i < domain->retired_length; i++) {
+        epoch_retired *retired = &domain->retired[i];
+
+        if (retired->epoch < before) {
+            allocator_free(domain->allocator, retired->ptr, retired->size);
+        } else {
+            domain->retired[kept++] = *retired;
+        }
+    }
+
+    size_t freed = domain->retired_length - kept;
+    domain->retired_length = kept;
+
+    return freed;
+}
+
+/* Construction */
+
+/**
+ * Initializes an epoch domain.
+ * @param domain A pointer to the epoch domain to initialize.
+ * @param allocator The allocator retired allocations are returned to, or NULL for the heap.
+ */
+void epoch_init(epoch_domain *domain, const allocator *allocator) {
+    // Epochs start at 1, an active value of 0 means outside a read section
+    atomic_init(&domain->epoch, 1);
+
+    for (size_t i = 0; i < EPOCH_MAX_READERS; i++) {
+        atomic_init(&domain->readers[i].active, 0);
+        atomic_init(&domain->readers[i].claimed, false);
+    }
+
+    domain->retired = NULL;
+    domain->retired_length = 0;
+    domain->retired_capacity = 0;
+    domain->allocator = allocator;
+}
+
+/**
+ * Registers the calling thread as a reader of an epoch domain.
+ * @param domain A pointer to the epoch domain.
+ * @return A pointer to the reader, or NULL if EPOCH_MAX_READERS are already registered.
+ */
+epoch_reader *epoch_register(epoch_domain *domain) {
+    for (size_t i = 0; i < EPOCH_MAX_READERS; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&domain->readers[i].claimed, &expected, true)) {
+            return &domain->readers[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Deletion */
+
+/**
+ * Frees every retired allocation of an epoch domain.
+ * Must not run while any reader is in a read section.
+ * @param domain A pointer to the epoch domain.
+ */
+void epoch_release(epoch_domain *domain) {
+    free_retired(domain, UINT64_MAX);
+    free(domain->retired);
+    domain->retired = NULL;
+    domain->retired_capacity = 0;
+}
+
+/**
+ * Gives up a reader so another thread can register it.
+ * @param reader A pointer to the reader, which must be outside a read section.
+ */
+void epoch_unregister(epoch_reader *reader) {
+    atomic_store_explicit(&reader->active, 0, memory_order_release);
+    atomic_store_explicit(&reader->claimed, false, memory_order_release);
+}
+
+/* Reading */
+
+/**
+ * Starts a read section. Nothing retired after this point is freed until the reader exits,
+ * so the protected structure can be walked with plain loads.
+ * @param domain A pointer to the epoch domain.
+ * @param reader A pointer to the calling thread's reader.
+ */
+void epoch_enter(epoch_domain *domain, epoch_reader *reader) {
+    uint64_t epoch = atomic_load_explicit(&domain->epoch, memory_order_acquire);
+    atomic_store_explicit(&reader->active, epoch, memory_order_relaxed);
+
+    // The announcement must be visible to writers before any pointer of the structure is read
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/**
+ * Ends a read section. Pointers read during it must not be used afterwards.
+ * @param reader A pointer to the calling thread's reader.
+ */
+void epoch_exit(epoch_reader *reader) {
+    atomic_store_explicit(&reader->active, 0, memory_order_release);
+}
+
+/* Reclamation */
+
+/**
+ * Hands over an allocation that writers have unlinked, to be freed once no reader can see it.
+ * Every EPOCH_RECLAIM_BATCH retirements the allocations no reader can see are freed.
+ * If the retired array can't grow, waits for the readers and frees the allocation right away.
+ * @param domain A pointer to the epoch domain.
+ * @param ptr A pointer to the allocation.
+ * @param size The size of the allocation in bytes.
+ */
+void epoch_retire(epoch_domain *domain, void *ptr, size_t size) {
+    if (domain->retired_length == domain->retired_capacity) {
+        size_t capacity = domain->retired_capacity == 0 ? RETIRED_INITIAL_CAPACITY : domain->retired_capacity * 2;
+        epoch_retired *retired = realloc(domain->retired, capacity * sizeof(epoch_retired));
+
+        if (retired == NULL) {
+            epoch_synchronize(domain);
+            allocator_free(domain->allocator, ptr, size);
+            return;
+        }
+
+        domain->retired = retired;
+        domain->retired_capacity = capacity;
+    }
+
+    // Pairs with the fence in epoch_enter, either the reader sees the unlink or the writer sees the reader
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Readers that enter from now on get a later epoch and can't reach the allocation
+    uint64_t epoch = atomic_fetch_add(&domain->epoch, 1);
+    domain->retired[domain->retired_length++] = (epoch_retired){ ptr, size, epoch };
+
+    if (domain->retired_length % EPOCH_RECLAIM_BATCH == 0) {
+        epoch_reclaim(domain);
+    }
+}
+
+/**
+ * Frees the retired allocations no reader can see anymore, without waiting.
+ * @param domain A pointer to the epoch domain.
+ * @return The number of allocations freed.
+ */
+size_t epoch_reclaim(epoch_domain *domain) {
+    return free_retired(domain, oldest_active(domain));
+}
+
+/**
+ * Waits until every read section that started before the call has ended,
+ * then frees every retired allocation.
+ * @param domain A pointer to the epoch domain.
+ */
+void epoch_synchronize(epoch_domain *domain) {
+    uint64_t target = atomic_fetch_add(&domain->epoch, 1) + 1;
+
+    for (size_t i = 0; i < EPOCH_MAX_READERS; i++) {
+        while (true) {
+            uint64_t active = atomic_load(&domain->readers[i].active);
+            if (active == 0 || active >= target) {
+                break;
+            }
+            sched_yield();
+        }
+    }
+
+    free_retired(domain, target);
+}
@@ -0,0 +1,72 @@
+//
+// Created by Christopher Szatmary on 2018-12-29.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_EPOCH_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_EPOCH_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "allocator.h"
+
+// Number of threads that can be registered as readers of one domain at a time
+#define EPOCH_MAX_READERS 64
+
+// Number of retired allocations that triggers an attempt to free them
+#define EPOCH_RECLAIM_BATCH 64
+
+// Keeps each reader on its own cache line
+#define EPOCH_LINE 64
+
+/**
+ * A reader of an epoch domain. Each thread reading the protected structure registers one.
+ * active holds the epoch the reader entered in, or 0 while it is outside a read section.
+ */
+typedef struct {
+    _Atomic uint64_t active;
+    _Atomic bool claimed;
+    char padding[EPOCH_LINE - sizeof(uint64_t) - sizeof(bool)];
+} epoch_reader;
+
+typedef struct {
+    void *ptr;
+    size_t size;
+    uint64_t epoch;
+} epoch_retired;
+
+/**
+ * Epoch based reclamation for structures that readers walk without locks.
+ * A writer that unlinks an allocation retires it with the current epoch and moves the epoch on.
+ * It is freed once every reader in a read section entered after that, since only readers
+ * that entered before the unlink can still be looking at it.
+ * Retiring and reclaiming must be serialized by the caller, usually by the writers' lock.
+ */
+typedef struct {
+    _Atomic uint64_t epoch;
+    char epoch_padding[EPOCH_LINE - sizeof(uint64_t)];
+    epoch_reader readers[EPOCH_MAX_READERS];
+    epoch_retired *retired;
+    size_t retired_length;
+    size_t retired_capacity;
+    const allocator *allocator;
+} epoch_domain;
+
+// Construction
+void epoch_init(epoch_domain *domain, const allocator *allocator);
+epoch_reader *epoch_register(epoch_domain *domain);
+
+// Deletion
+void epoch_release(epoch_domain *domain);
+void epoch_unregister(epoch_reader *reader);
+
+// Reading
+void epoch_enter(epoch_domain *domain, epoch_reader *reader);
+void epoch_exit(epoch_reader *reader);
+
+// Reclamation
+void epoch_retire(epoch_domain *domain, void *ptr, size_t size);
+size_t epoch_reclaim(epoch_domain *domain);
+void epoch_synchronize(epoch_domain *domain);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_EPOCH_H
@@ -6,6 +6,26 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include "error.h"
+#ifdef DSA_INSTRUMENT
+#include "instrument.h"
+#endif
+
+/**
+ * Exits the process after a fatal error.
+ * When built with DSA_INSTRUMENT the error is counted and every counter is written to stderr first,
+ * since they would be lost with the process.
+ * @param code The exit code.
+ */
+static void fatal_exit(int code) {
+#ifdef DSA_INSTRUMENT
+    // Not every message ends its line, so start the dump on a fresh one
+    instrument_fatal_error();
+    fputc('\n', stderr);
+    instrument_dump(stderr);
+#endif
+
+    exit(code);
+}
 
 const char *get_error(int code) {
     switch (code) {
@@ -19,6 +39,10 @@ const char *get_error(int code) {
             return "Invalid index";
         case LENGTHS_DIFFERENT:
             return "Lengths are different";
+        case INVALID_SNAPSHOT:
+            return "Invalid snapshot";
+        case INVALID_NUMBER:
+            return "Invalid number";
         default:
             return "Unknown error occurred";
     }
@@ -26,7 +50,7 @@ const char *get_error(int code) {
 
 void fatal_error(int code) {
     fprintf(stderr, "FATAL ERROR: %s\n", get_error(code));
-    exit(code);
+    fatal_exit(code);
 }
 
 void fatal_error_print(int code, const char *restrict format, ...) {
@@ -36,5 +60,5 @@ void fatal_error_print(int code, const char *restrict format, ...) {
     vfprintf(stderr, format, args);
     va_end(args);
 
-    exit(code);
+    fatal_exit(code);
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #define LENGTHS_DIFFERENT -5
 #define SPACE_ALREADY_ALLOCATED -6
 #define CANNOT_REDUCE_SIZE -7
+#define INVALID_SNAPSHOT -8
+#define INVALID_NUMBER -9
 
 const char *get_error(int code);
 void fatal_error(int code);
@@ -0,0 +1,106 @@
+//
+// Created by Christopher Szatmary on 2019-01-03.
+//
+
+#include <unistd.h>
+#include "growth_policy.h"
+
+// Used when the page size can't be queried
+#define FALLBACK_PAGE_SIZE 4096
+
+/* Construction */
+
+/**
+ * Returns the policy array stacks use by default.
+ * The capacity starts at 2 and doubles, and reserved capacities are rounded up to an even number.
+ * @return The policy.
+ */
+growth_policy growth_policy_doubling(void) {
+    return (growth_policy){ growth_policy_grow, 2.0, 2, 0, 2 };
+}
+
+/**
+ * Returns a policy that multiplies the capacity by a factor, starting at 2.
+ * A factor below 2 wastes less memory on spare capacity at the cost of more copies.
+ * @param factor The factor to grow by, greater than 1.
+ * @return The policy.
+ */
+growth_policy growth_policy_geometric(double factor) {
+    return (growth_policy){ growth_policy_grow, factor, 2, 0, 1 };
+}
+
+/**
+ * Returns a policy that multiplies the capacity by a factor and rounds it up to whole pages,
+ * so the allocator never rounds a large array up behind the container's back.
+ * Capacities are in ints, so a page holds page size / sizeof(int) of them.
+ * @param factor The factor to grow by, greater than 1.
+ * @return The policy.
+ */
+growth_policy growth_policy_paged(double factor) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    size_t page = (page_size > 0 ? (size_t)page_size : FALLBACK_PAGE_SIZE) / sizeof(int);
+
+    return (growth_policy){ growth_policy_grow, factor, page, 0, page };
+}
+
+/**
+ * Returns a policy that multiplies the capacity by a factor until that would add more than
+ * limit elements, and from then on grows by limit elements at a time.
+ * This bounds the spare capacity of huge arrays at the cost of copying them more often.
+ * @param factor The factor to grow by, greater than 1.
+ * @param limit The most elements to add at once.
+ * @return The policy.
+ */
+growth_policy growth_policy_capped(double factor, size_t limit) {
+    return (growth_policy){ growth_policy_grow, factor, 2, limit, 1 };
+}
+
+/* Accessing */
+
+/**
+ * Computes the capacity to grow to under one of the built in policies.
+ * Every step adds at least one element, so a factor too close to 1 still makes progress.
+ * @param policy A pointer to the policy.
+ * @param capacity The current capacity.
+ * @param needed The capacity that is needed.
+ * @return The new capacity, at least needed.
+ */
+size_t growth_policy_grow(const growth_policy *policy, size_t capacity, size_t needed) {
+    size_t next = capacity;
+
+    while (next < needed) {
+        if (next < policy->minimum) {
+            next = policy->minimum;
+            continue;
+        }
+
+        size_t step = (size_t)((double)next * (policy->factor - 1.0));
+        if (step == 0) {
+            step = 1;
+        }
+
+        // Past the limit growth is linear, so jump straight to the capacity needed
+        if (policy->limit != 0 && step >= policy->limit) {
+            next += (needed - next + policy->limit - 1) / policy->limit * policy->limit;
+            break;
+        }
+
+        next += step;
+    }
+
+    return growth_policy_round(policy, next);
+}
+
+/**
+ * Rounds a capacity up to the granularity of a policy.
+ * @param policy A pointer to the policy.
+ * @param capacity The capacity to round.
+ * @return The rounded capacity.
+ */
+size_t growth_policy_round(const growth_policy *policy, size_t capacity) {
+    if (policy->granularity <= 1) {
+        return capacity;
+    }
+
+    return (capacity + policy->granularity - 1) / policy->granularity * policy->granularity;
+}
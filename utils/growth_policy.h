@@ -0,0 +1,37 @@
+//
+// Created by Christopher Szatmary on 2019-01-03.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_GROWTH_POLICY_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_GROWTH_POLICY_H
+
+#include <stddef.h>
+
+typedef struct growth_policy growth_policy;
+
+/**
+ * Decides how much an array grows when it runs out of room.
+ * grow returns a capacity of at least needed elements for an array that currently holds capacity.
+ * The built in policies all use growth_policy_grow, which multiplies the capacity by factor,
+ * starting from minimum, adds at most limit elements at a time unless limit is 0,
+ * and rounds up to a multiple of granularity. Custom policies can supply their own grow.
+ */
+struct growth_policy {
+    size_t (*grow)(const growth_policy *policy, size_t capacity, size_t needed);
+    double factor;
+    size_t minimum;
+    size_t limit;
+    size_t granularity;
+};
+
+// Construction
+growth_policy growth_policy_doubling(void);
+growth_policy growth_policy_geometric(double factor);
+growth_policy growth_policy_paged(double factor);
+growth_policy growth_policy_capped(double factor, size_t limit);
+
+// Accessing
+size_t growth_policy_grow(const growth_policy *policy, size_t capacity, size_t needed);
+size_t growth_policy_round(const growth_policy *policy, size_t capacity);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_GROWTH_POLICY_H
@@ -0,0 +1,251 @@
+//
+// Created by Christopher Szatmary on 2019-01-02.
+//
+
+#include <stdlib.h>
+#include <errno.h>
+#include <pthread.h>
+#include "instrument.h"
+
+_Thread_local instrument_block *instrument_local = NULL;
+
+static const char *container_names[INSTRUMENT_CONTAINER_COUNT] = {
+    "linked_list", "list_stack", "array_stack"
+};
+
+static const char *event_names[INSTRUMENT_EVENT_COUNT] = {
+    "allocs", "frees", "reallocs", "bytes_moved", "steps"
+};
+
+// Every live thread's block, the counts of threads that have exited, and the totals at the last reset
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static instrument_block *blocks = NULL;
+static instrument_counts retired;
+static instrument_counts baseline;
+static pthread_key_t exit_key;
+static pthread_once_t exit_key_once = PTHREAD_ONCE_INIT;
+
+/**
+ * The bytes of nodes and arrays the containers of one type hold, and the most they have held.
+ * A peak can't be added up from per thread counts, so these are shared by every thread.
+ */
+typedef struct {
+    _Alignas(INSTRUMENT_LINE) _Atomic int64_t live;
+    _Atomic int64_t peak;
+} memory_tracker;
+
+static memory_tracker trackers[INSTRUMENT_CONTAINER_COUNT];
+
+// Fatal errors end the process wherever they are raised, so they are counted once for all containers
+static _Atomic uint64_t fatal_errors;
+static _Atomic uint64_t fatal_errors_baseline;
+
+/* Helpers */
+
+/**
+ * Folds the counts of an exiting thread into the retired totals and frees its block.
+ * @param context A pointer to the thread's block.
+ */
+static void block_retire(void *context) {
+    instrument_block *block = context;
+
+    pthread_mutex_lock(&lock);
+    for (instrument_block **link = &blocks; *link != NULL; link = &(*link)->next) {
+        if (*link == block) {
+            *link = block->next;
+            break;
+        }
+    }
+    for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+        for (int e = 0; e < INSTRUMENT_EVENT_COUNT; e++) {
+            retired.counts[c][e] += atomic_load_explicit(&block->counts[c][e], memory_order_relaxed);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+
+    instrument_local = NULL;
+    free(block);
+}
+
+static void exit_key_create(void) {
+    pthread_key_create(&exit_key, block_retire);
+}
+
+/**
+ * Adds up the counts of every thread, including threads that have exited. Must hold the lock.
+ * @param counts Set to the totals.
+ */
+static void totals(instrument_counts *counts) {
+    *counts = retired;
+
+    for (instrument_block *block = blocks; block != NULL; block = block->next) {
+        for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+            for (int e = 0; e < INSTRUMENT_EVENT_COUNT; e++) {
+                counts->counts[c][e] += atomic_load_explicit(&block->counts[c][e], memory_order_relaxed);
+            }
+        }
+    }
+}
+
+/* Construction */
+
+/**
+ * Gives the calling thread its own block of counters, on first use.
+ * The block is folded into the totals and freed when the thread exits.
+ * @return A pointer to the thread's block, or NULL if it couldn't be allocated.
+ */
+instrument_block *instrument_register(void) {
+    pthread_once(&exit_key_once, exit_key_create);
+
+    instrument_block *block = aligned_alloc(INSTRUMENT_LINE, sizeof(instrument_block));
+    if (block == NULL) {
+        return NULL;
+    }
+
+    for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+        for (int e = 0; e < INSTRUMENT_EVENT_COUNT; e++) {
+            atomic_init(&block->counts[c][e], 0);
+        }
+    }
+
+    pthread_mutex_lock(&lock);
+    block->next = blocks;
+    blocks = block;
+    pthread_mutex_unlock(&lock);
+
+    pthread_setspecific(exit_key, block);
+    instrument_local = block;
+
+    return block;
+}
+
+/**
+ * Records memory taken or given back by a container and raises the peak if it is passed.
+ * @param container The container type holding the memory.
+ * @param bytes The number of bytes allocated, negative for bytes freed.
+ */
+void instrument_memory(instrument_container container, int64_t bytes) {
+    memory_tracker *tracker = &trackers[container];
+    int64_t live = atomic_fetch_add_explicit(&tracker->live, bytes, memory_order_relaxed) + bytes;
+    int64_t peak = atomic_load_explicit(&tracker->peak, memory_order_relaxed);
+
+    while (live > peak && !atomic_compare_exchange_weak_explicit(&tracker->peak, &peak, live,
+                                                                 memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * Counts a fatal error. Called by the error handlers just before they exit the process.
+ */
+void instrument_fatal_error(void) {
+    atomic_fetch_add_explicit(&fatal_errors, 1, memory_order_relaxed);
+}
+
+/* Accessing */
+
+/**
+ * Returns whether the containers were built to count events.
+ * @return true if the library was built with DSA_INSTRUMENT.
+ */
+bool instrument_enabled(void) {
+#ifdef DSA_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char *instrument_container_name(instrument_container container) {
+    return container_names[container];
+}
+
+const char *instrument_event_name(instrument_event event) {
+    return event_names[event];
+}
+
+/**
+ * Copies the counts of every thread since the last reset.
+ * Counts of threads that are still running may be slightly behind.
+ * @param counts Set to the counts.
+ */
+void instrument_snapshot(instrument_counts *counts) {
+    pthread_mutex_lock(&lock);
+    totals(counts);
+    for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+        for (int e = 0; e < INSTRUMENT_EVENT_COUNT; e++) {
+            counts->counts[c][e] -= baseline.counts[c][e];
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * Returns the bytes of nodes and arrays the containers of a type hold right now.
+ * @param container The container type.
+ * @return The number of bytes.
+ */
+int64_t instrument_live_bytes(instrument_container container) {
+    return atomic_load_explicit(&trackers[container].live, memory_order_relaxed);
+}
+
+/**
+ * Returns the most bytes of nodes and arrays the containers of a type held since the last reset.
+ * @param container The container type.
+ * @return The number of bytes.
+ */
+int64_t instrument_peak_bytes(instrument_container container) {
+    return atomic_load_explicit(&trackers[container].peak, memory_order_relaxed);
+}
+
+/**
+ * Returns the number of fatal errors since the last reset.
+ * @return The number of fatal errors.
+ */
+uint64_t instrument_fatal_errors(void) {
+    return atomic_load_explicit(&fatal_errors, memory_order_relaxed)
+           - atomic_load_explicit(&fatal_errors_baseline, memory_order_relaxed);
+}
+
+/**
+ * Writes the counts since the last reset as CSV lines of container, event and count,
+ * followed by the live and peak bytes of each container type and the fatal errors of all of them.
+ * @param file The file to write to.
+ * @return An integer indicating the status.
+ */
+int instrument_dump(FILE *file) {
+    instrument_counts counts;
+    instrument_snapshot(&counts);
+
+    fprintf(file, "container,event,count\n");
+    for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+        for (int e = 0; e < INSTRUMENT_EVENT_COUNT; e++) {
+            fprintf(file, "%s,%s,%llu\n", container_names[c], event_names[e], (unsigned long long)counts.counts[c][e]);
+        }
+    }
+    for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+        fprintf(file, "%s,live_bytes,%lld\n", container_names[c], (long long)instrument_live_bytes(c));
+        fprintf(file, "%s,peak_bytes,%lld\n", container_names[c], (long long)instrument_peak_bytes(c));
+    }
+    fprintf(file, "all,fatal_errors,%llu\n", (unsigned long long)instrument_fatal_errors());
+
+    return ferror(file) ? EIO : EXIT_SUCCESS;
+}
+
+/* Mutation */
+
+/**
+ * Starts counting from zero again. Threads keep writing only their own counters,
+ * the current totals are remembered and subtracted from later snapshots.
+ * Live bytes are kept and each peak starts again from them.
+ */
+void instrument_reset(void) {
+    pthread_mutex_lock(&lock);
+    totals(&baseline);
+    pthread_mutex_unlock(&lock);
+
+    for (int c = 0; c < INSTRUMENT_CONTAINER_COUNT; c++) {
+        atomic_store_explicit(&trackers[c].peak, instrument_live_bytes(c), memory_order_relaxed);
+    }
+    atomic_store_explicit(&fatal_errors_baseline, atomic_load_explicit(&fatal_errors, memory_order_relaxed),
+                          memory_order_relaxed);
+}
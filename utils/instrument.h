@@ -0,0 +1,94 @@
+//
+// Created by Christopher Szatmary on 2019-01-02.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_INSTRUMENT_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_INSTRUMENT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Keeps the counters of different threads on separate cache lines
+#define INSTRUMENT_LINE 64
+
+typedef enum {
+    INSTRUMENT_LINKED_LIST,
+    INSTRUMENT_LIST_STACK,
+    INSTRUMENT_ARRAY_STACK,
+    INSTRUMENT_CONTAINER_COUNT
+} instrument_container;
+
+typedef enum {
+    INSTRUMENT_ALLOCS,
+    INSTRUMENT_FREES,
+    INSTRUMENT_REALLOCS,
+    INSTRUMENT_BYTES_MOVED,
+    INSTRUMENT_STEPS,
+    INSTRUMENT_EVENT_COUNT
+} instrument_event;
+
+/**
+ * The counters of one thread. Only the owning thread writes them, so counting needs no
+ * read-modify-write, and other threads only read them to add up the totals.
+ */
+typedef struct instrument_block {
+    _Alignas(INSTRUMENT_LINE) _Atomic uint64_t counts[INSTRUMENT_CONTAINER_COUNT][INSTRUMENT_EVENT_COUNT];
+    struct instrument_block *next;
+} instrument_block;
+
+/**
+ * A copy of the totals of every counter.
+ */
+typedef struct {
+    uint64_t counts[INSTRUMENT_CONTAINER_COUNT][INSTRUMENT_EVENT_COUNT];
+} instrument_counts;
+
+extern _Thread_local instrument_block *instrument_local;
+
+instrument_block *instrument_register(void);
+
+/**
+ * Adds to a counter of the calling thread.
+ * @param container The container the event happened in.
+ * @param event The event.
+ * @param amount The amount to add.
+ */
+static inline void instrument_add(instrument_container container, instrument_event event, uint64_t amount) {
+    instrument_block *block = instrument_local;
+
+    if (block == NULL && (block = instrument_register()) == NULL) {
+        return;
+    }
+
+    _Atomic uint64_t *count = &block->counts[container][event];
+    atomic_store_explicit(count, atomic_load_explicit(count, memory_order_relaxed) + amount, memory_order_relaxed);
+}
+
+void instrument_memory(instrument_container container, int64_t bytes);
+void instrument_fatal_error(void);
+
+// Counting compiles away unless the library is built with DSA_INSTRUMENT
+#ifdef DSA_INSTRUMENT
+#define INSTRUMENT_ADD(container, event, amount) instrument_add(container, event, amount)
+#define INSTRUMENT_MEMORY(container, bytes) instrument_memory(container, bytes)
+#else
+#define INSTRUMENT_ADD(container, event, amount) ((void)sizeof(amount))
+#define INSTRUMENT_MEMORY(container, bytes) ((void)sizeof(bytes))
+#endif
+
+// Accessing
+bool instrument_enabled(void);
+const char *instrument_container_name(instrument_container container);
+const char *instrument_event_name(instrument_event event);
+void instrument_snapshot(instrument_counts *counts);
+int64_t instrument_live_bytes(instrument_container container);
+int64_t instrument_peak_bytes(instrument_container container);
+uint64_t instrument_fatal_errors(void);
+int instrument_dump(FILE *file);
+
+// Mutation
+void instrument_reset(void);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_INSTRUMENT_H
@@ -0,0 +1,317 @@
+//
+// Created by Christopher Szatmary on 2018-12-24.
+//
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "int_reader.h"
+#include "error.h"
+
+// Size of each read, a number can't be longer than this
+#define READ_CHUNK_SIZE (1024 * 1024)
+
+// Room after the text so eight bytes can always be loaded at once
+#define READ_PADDING 8
+
+// Number of integers handed to the sink at once
+#define BATCH_SIZE 4096
+
+// Digits are read eight at a time by loading them as a little endian word and finding
+// the first non-digit with a count of trailing zeros, elsewhere they are read one at a time
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SWAR_DIGITS 1
+#else
+#define SWAR_DIGITS 0
+#endif
+
+#define ONES 0x0101010101010101ULL
+
+typedef enum {
+    CHAR_OTHER,
+    CHAR_DIGIT,
+    CHAR_SEPARATOR,
+    CHAR_MINUS
+} char_class;
+
+typedef struct {
+    int values[BATCH_SIZE];
+    size_t count;
+    int_sink sink;
+    void *context;
+} int_batch;
+
+static const unsigned char char_classes[256] = {
+    ['0'] = CHAR_DIGIT, ['1'] = CHAR_DIGIT, ['2'] = CHAR_DIGIT, ['3'] = CHAR_DIGIT, ['4'] = CHAR_DIGIT,
+    ['5'] = CHAR_DIGIT, ['6'] = CHAR_DIGIT, ['7'] = CHAR_DIGIT, ['8'] = CHAR_DIGIT, ['9'] = CHAR_DIGIT,
+    ['\n'] = CHAR_SEPARATOR, ['\r'] = CHAR_SEPARATOR, [','] = CHAR_SEPARATOR, [' '] = CHAR_SEPARATOR,
+    ['\t'] = CHAR_SEPARATOR, ['-'] = CHAR_MINUS
+};
+
+/* Helpers */
+
+#if SWAR_DIGITS
+static const uint64_t powers_of_ten[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+/**
+ * Counts the leading digits in eight bytes of text, all eight at once.
+ * Bytes are in memory order, so the first character is the lowest byte.
+ * @param word Eight bytes of text loaded as a little endian integer.
+ * @return The number of digits before the first other character, up to 8.
+ */
+static unsigned int swar_digit_run(uint64_t word) {
+    // A byte is a digit if its high nibble is 3 and adding 6 doesn't carry out of the low nibble
+    uint64_t high = word & (0xF0 * ONES);
+    uint64_t carried = (word + 0x06 * ONES) & (0xF0 * ONES);
+    uint64_t not_digit = (high | carried >> 4) ^ (0x33 * ONES);
+
+    if (not_digit == 0) {
+        return 8;
+    }
+
+    return (unsigned int)__builtin_ctzll(not_digit) / 8;
+}
+
+/**
+ * Converts up to eight digits to their value without a loop.
+ * @param word Eight bytes of text with the digits first.
+ * @param digits The number of digits, from 1 to 8.
+ * @return The value of the digits.
+ */
+static uint64_t swar_digits_value(uint64_t word, unsigned int digits) {
+    // Keep only the digits and move them to the top, the zero bytes below act as leading zeros
+    word = (word - 0x30 * ONES) << (8 * (8 - digits));
+
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+            + (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+
+    return word;
+}
+#endif
+
+/**
+ * Hands the integers collected in a batch to its sink.
+ * @param batch A pointer to the batch.
+ * @return The status returned by the sink.
+ */
+static int batch_flush(int_batch *batch) {
+    if (batch->count == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    int status = batch->sink(batch->context, batch->values, batch->count);
+    batch->count = 0;
+
+    return status;
+}
+
+/**
+ * Parses every integer in a block of text into a batch.
+ * Digits are read eight characters at a time wherever eight bytes can be loaded, on little endian targets.
+ * @param batch A pointer to the batch receiving the integers.
+ * @param text The text, which must not end in the middle of a number unless it is the end of the input.
+ * @param end A pointer to the end of the text.
+ * @param padded Whether eight bytes can be read past any point before the end.
+ * @return An integer indicating the status, INVALID_NUMBER for malformed text or ERANGE for values that don't fit in an int.
+ */
+static int parse_block(int_batch *batch, const char *text, const char *end, bool padded) {
+    const char *current = text;
+
+    while (true) {
+        while (current < end && char_classes[(unsigned char)*current] == CHAR_SEPARATOR) {
+            current++;
+        }
+
+        if (current == end) {
+            return EXIT_SUCCESS;
+        }
+
+        bool negative = *current == '-';
+        current += negative;
+
+        uint64_t value = 0;
+        const char *digits_start = current;
+
+        bool more = true;
+
+#if SWAR_DIGITS
+        // Take eight characters at a time while they can be loaded, then finish one at a time
+        while (more && (padded || end - current >= 8) && value <= (uint64_t)INT_MAX + 1) {
+            uint64_t word;
+            memcpy(&word, current, sizeof(word));
+            unsigned int run = swar_digit_run(word);
+
+            // Don't read digits of the next number past the end of the block
+            if (run > (size_t)(end - current)) {
+                run = (unsigned int)(end - current);
+            }
+
+            if (run > 0) {
+                value = value * powers_of_ten[run] + swar_digits_value(word, run);
+                current += run;
+            }
+            more = run == 8;
+        }
+#else
+        (void)padded;
+#endif
+
+        while (more && current < end && char_classes[(unsigned char)*current] == CHAR_DIGIT && value <= (uint64_t)INT_MAX + 1) {
+            value = value * 10 + (uint64_t)(*current - '0');
+            current++;
+        }
+
+        // A number is at least one digit followed by a separator or the end
+        if (current == digits_start) {
+            return INVALID_NUMBER;
+        }
+        if (value > (uint64_t)INT_MAX + negative) {
+            return ERANGE;
+        }
+        if (current < end && char_classes[(unsigned char)*current] != CHAR_SEPARATOR) {
+            return char_classes[(unsigned char)*current] == CHAR_DIGIT ? ERANGE : INVALID_NUMBER;
+        }
+
+        batch->values[batch->count++] = negative ? (int)-(int64_t)value : (int)value;
+        if (batch->count == BATCH_SIZE) {
+            int status = batch_flush(batch);
+            if (status != EXIT_SUCCESS) {
+                return status;
+            }
+        }
+    }
+}
+
+/* Reading */
+
+/**
+ * Reads integers separated by newlines, commas or whitespace from a file descriptor until the end.
+ * The input is read in large chunks and handed to the sink in batches,
+ * so only one chunk of it is ever in memory.
+ * @param fd The file descriptor to read from, which can be a pipe.
+ * @param sink The function receiving each batch of integers.
+ * @param context A pointer passed on to the sink.
+ * @return An integer indicating the status, INVALID_NUMBER for malformed text or ERANGE for values that don't fit in an int.
+ */
+int int_reader_read_fd(int fd, int_sink sink, void *context) {
+    char *buffer = malloc(READ_CHUNK_SIZE + READ_PADDING);
+    int_batch *batch = malloc(sizeof(int_batch));
+
+    if (buffer == NULL || batch == NULL) {
+        free(buffer);
+        free(batch);
+        return ENOMEM;
+    }
+
+    batch->count = 0;
+    batch->sink = sink;
+    batch->context = context;
+
+    int status = EXIT_SUCCESS;
+    size_t carried = 0;
+
+    while (status == EXIT_SUCCESS) {
+        ssize_t count = read(fd, buffer + carried, READ_CHUNK_SIZE - carried);
+
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            status = errno;
+            break;
+        }
+
+        // At the end of the input whatever is left is complete
+        if (count == 0) {
+            memset(buffer + carried, 0, READ_PADDING);
+            status = parse_block(batch, buffer, buffer + carried, true);
+            break;
+        }
+
+        size_t filled = carried + (size_t)count;
+
+        // Only parse up to the last separator, the number after it may continue in the next read
+        size_t complete = filled;
+        while (complete > 0 && char_classes[(unsigned char)buffer[complete - 1]] != CHAR_SEPARATOR) {
+            complete--;
+        }
+
+        if (complete == 0 && filled == READ_CHUNK_SIZE) {
+            status = INVALID_NUMBER;
+            break;
+        }
+
+        status = parse_block(batch, buffer, buffer + complete, true);
+
+        carried = filled - complete;
+        memmove(buffer, buffer + complete, carried);
+    }
+
+    if (status == EXIT_SUCCESS) {
+        status = batch_flush(batch);
+    }
+
+    free(buffer);
+    free(batch);
+
+    return status;
+}
+
+/**
+ * Reads integers separated by newlines, commas or whitespace from a file.
+ * @param path The path of the file.
+ * @param sink The function receiving each batch of integers.
+ * @param context A pointer passed on to the sink.
+ * @return An integer indicating the status.
+ */
+int int_reader_read_path(const char *path, int_sink sink, void *context) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return errno;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    int status = int_reader_read_fd(fd, sink, context);
+    close(fd);
+
+    return status;
+}
+
+/**
+ * Parses integers separated by newlines, commas or whitespace from text already in memory.
+ * @param text The text, which doesn't have to be NUL terminated.
+ * @param length The length of the text.
+ * @param sink The function receiving each batch of integers.
+ * @param context A pointer passed on to the sink.
+ * @return An integer indicating the status.
+ */
+int int_reader_parse(const char *text, size_t length, int_sink sink, void *context) {
+    int_batch *batch = malloc(sizeof(int_batch));
+    if (batch == NULL) {
+        return ENOMEM;
+    }
+
+    batch->count = 0;
+    batch->sink = sink;
+    batch->context = context;
+
+    // The text can't be read past its end, so its last few characters are parsed one at a time
+    int status = parse_block(batch, text, text + length, false);
+    if (status == EXIT_SUCCESS) {
+        status = batch_flush(batch);
+    }
+
+    free(batch);
+
+    return status;
+}
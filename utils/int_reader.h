@@ -0,0 +1,21 @@
+//
+// Created by Christopher Szatmary on 2018-12-24.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_INT_READER_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_INT_READER_H
+
+#include <stddef.h>
+
+/**
+ * Receives each batch of parsed integers.
+ * Returns EXIT_SUCCESS to keep reading, anything else stops the reader and is passed on.
+ */
+typedef int (*int_sink)(void *context, const int *values, size_t count);
+
+// Reading
+int int_reader_read_fd(int fd, int_sink sink, void *context);
+int int_reader_read_path(const char *path, int_sink sink, void *context);
+int int_reader_parse(const char *text, size_t length, int_sink sink, void *context);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_INT_READER_H
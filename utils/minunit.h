@@ -76,6 +76,33 @@ static int minunit_status = 0;
 static double minunit_real_timer = 0;
 static double minunit_proc_timer = 0;
 
+/*  Hardware counters around each test, when built with MINUNIT_PERF_COUNTERS */
+#ifdef MINUNIT_PERF_COUNTERS
+#include "perf_counters.h"
+static perf_counters minunit_perf;
+static int minunit_perf_status = -1;
+#define MU__PERF_START() MU__SAFE_BLOCK(\
+	if (minunit_perf_status == -1) minunit_perf_status = perf_counters_open(&minunit_perf);\
+	if (minunit_perf_status == 0) perf_counters_start(&minunit_perf);\
+)
+#define MU__PERF_STOP(test) MU__SAFE_BLOCK(\
+	if (minunit_perf_status == 0) {\
+		perf_counters_stop(&minunit_perf);\
+		printf("\n  %-32s", #test);\
+		perf_counters_fprint(&minunit_perf, stdout, 0);\
+	}\
+)
+#define MU__PERF_REPORT() MU__SAFE_BLOCK(\
+	if (minunit_perf_status > 0) printf("perf counters unavailable: %s\n", strerror(minunit_perf_status));\
+	if (minunit_perf_status == 0) perf_counters_close(&minunit_perf);\
+	minunit_perf_status = -1;\
+)
+#else
+#define MU__PERF_START() MU__SAFE_BLOCK()
+#define MU__PERF_STOP(test) MU__SAFE_BLOCK()
+#define MU__PERF_REPORT() MU__SAFE_BLOCK()
+#endif
+
 /*  Last message */
 static char minunit_last_message[MINUNIT_MESSAGE_LEN];
 
@@ -112,7 +139,9 @@ static void (*minunit_teardown)(void) = NULL;
 	}\
 	if (minunit_setup) (*minunit_setup)();\
 	minunit_status = 0;\
+	MU__PERF_START();\
 	test();\
+	MU__PERF_STOP(test);\
 	minunit_run++;\
 	if (minunit_status) {\
 		minunit_fail++;\
@@ -133,6 +162,7 @@ static void (*minunit_teardown)(void) = NULL;
 	printf("\nFinished in %.8f seconds (real) %.8f seconds (proc)\n\n",\
 		minunit_end_real_timer - minunit_real_timer,\
 		minunit_end_proc_timer - minunit_proc_timer);\
+	MU__PERF_REPORT();\
 )
 
 /*  Assertions */
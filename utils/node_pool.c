@@ -0,0 +1,281 @@
+//
+// Created by Christopher Szatmary on 2018-12-16.
+//
+
+#include "node_pool.h"
+
+#define INITIAL_CHUNK_NODES 32
+#define MAX_CHUNK_NODES 4096
+
+struct pool_chunk {
+    pool_chunk *next;
+    size_t capacity;
+};
+
+// Nodes start after the chunk header, aligned for any node type
+#define CHUNK_HEADER_SIZE ((sizeof(pool_chunk) + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t))
+
+/* Helpers */
+
+/**
+ * Returns a pointer to the node at the given slot in a chunk.
+ * @param pool A pointer to the node pool.
+ * @param chunk A pointer to the chunk.
+ * @param slot The slot of the node inside the chunk.
+ * @return A pointer to the node.
+ */
+static void *chunk_node(node_pool *pool, pool_chunk *chunk, size_t slot) {
+    return (char *)chunk + CHUNK_HEADER_SIZE + slot * pool->node_size;
+}
+
+/**
+ * Allocates a new chunk and makes it the one nodes are carved from.
+ * Each new chunk is twice the size of the previous one, up to MAX_CHUNK_NODES.
+ * @param pool A pointer to the node pool.
+ * @return A pointer to the new chunk, or NULL if the allocation failed.
+ */
+static pool_chunk *chunk_new(node_pool *pool) {
+    size_t capacity = pool->chunk_capacity;
+    pool_chunk *chunk = allocator_alloc(pool->allocator, CHUNK_HEADER_SIZE + capacity * pool->node_size);
+
+    if (chunk != NULL) {
+        chunk->next = pool->chunks;
+        chunk->capacity = capacity;
+        pool->chunks = chunk;
+        pool->chunk_used = 0;
+
+        if (pool->last_chunk == NULL) {
+            pool->last_chunk = chunk;
+        }
+
+        if (capacity < MAX_CHUNK_NODES) {
+            pool->chunk_capacity = capacity * 2;
+        }
+    }
+
+    return chunk;
+}
+
+/* Construction */
+
+/**
+ * Initializes an empty node pool.
+ * No memory is allocated until the first node is taken.
+ * @param pool A pointer to the node pool.
+ * @param node_size The size in bytes of each node handed out by the pool.
+ * @param allocator A pointer to the allocator chunks are taken from, or NULL to use the heap.
+ */
+void node_pool_init(node_pool *pool, size_t node_size, const allocator *allocator) {
+    // Every node must be able to hold the free list link and keep its neighbours aligned
+    if (node_size < sizeof(void *)) {
+        node_size = sizeof(void *);
+    }
+
+    pool->chunks = NULL;
+    pool->last_chunk = NULL;
+    pool->free_list = NULL;
+    pool->free_tail = NULL;
+    pool->node_size = (node_size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    pool->chunk_capacity = INITIAL_CHUNK_NODES;
+    pool->chunk_used = 0;
+    pool->users = 1;
+    pool->allocator = allocator;
+}
+
+/**
+ * Allocates and initializes an empty node pool with one user.
+ * @param node_size The size in bytes of each node handed out by the pool.
+ * @param allocator A pointer to the allocator the pool and its chunks are taken from, or NULL to use the heap.
+ * @return A pointer to the pool, or NULL if the allocation failed.
+ */
+node_pool *node_pool_new(size_t node_size, const allocator *allocator) {
+    node_pool *pool = allocator_alloc(allocator, sizeof(node_pool));
+
+    if (pool != NULL) {
+        node_pool_init(pool, node_size, allocator);
+    }
+
+    return pool;
+}
+
+/**
+ * Registers another user of a node pool.
+ * @param pool A pointer to the node pool.
+ */
+void node_pool_retain(node_pool *pool) {
+    pool->users++;
+}
+
+/* Deletion */
+
+/**
+ * Deallocates every chunk owned by the pool in one pass.
+ * All nodes taken from the pool become invalid. The pool can be reused afterwards.
+ * @param pool A pointer to the node pool.
+ */
+void node_pool_release(node_pool *pool) {
+    // Chunks taken from an allocator that releases in bulk are left for it to reclaim
+    pool_chunk *current = allocator_frees(pool->allocator) ? pool->chunks : NULL;
+    while (current != NULL) {
+        pool_chunk *next = current->next;
+        allocator_free(pool->allocator, current, CHUNK_HEADER_SIZE + current->capacity * pool->node_size);
+        current = next;
+    }
+
+    size_t users = pool->users;
+    node_pool_init(pool, pool->node_size, pool->allocator);
+    pool->users = users;
+}
+
+/**
+ * Removes a user from a pool created with node_pool_new.
+ * The last user to drop the pool releases its chunks and deallocates it.
+ * @param pool A pointer to the node pool.
+ */
+void node_pool_drop(node_pool *pool) {
+    pool->users--;
+
+    if (pool->users == 0) {
+        node_pool_release(pool);
+        allocator_free(pool->allocator, pool, sizeof(node_pool));
+    }
+}
+
+/* Accessing */
+
+/**
+ * Reports how the memory of the pool's chunks is spent.
+ * Slots that are recycled or not carved yet count as slack.
+ * @param pool A pointer to the node pool.
+ * @param taken The number of nodes currently taken from the pool.
+ * @param payload_size The bytes of each node holding data rather than links.
+ * @return The memory usage of the chunks.
+ */
+memory_usage node_pool_memory_usage(node_pool *pool, size_t taken, size_t payload_size) {
+    memory_usage usage = { taken * payload_size, taken * (pool->node_size - payload_size), 0 };
+    size_t slots = 0;
+
+    for (pool_chunk *chunk = pool->chunks; chunk != NULL; chunk = chunk->next) {
+        size_t size = CHUNK_HEADER_SIZE + chunk->capacity * pool->node_size;
+        slots += chunk->capacity;
+        usage.overhead += CHUNK_HEADER_SIZE;
+        usage.slack += allocator_slack(pool->allocator, chunk, size);
+    }
+
+    if (slots > taken) {
+        usage.slack += (slots - taken) * pool->node_size;
+    }
+
+    return usage;
+}
+
+/* Mutation */
+
+/**
+ * Takes a node from the pool.
+ * Recycled nodes are reused first, otherwise a node is carved from the newest chunk.
+ * @param pool A pointer to the node pool.
+ * @return A pointer to the node, or NULL if the allocation failed.
+ */
+void *node_pool_take(node_pool *pool) {
+    if (pool->free_list != NULL) {
+        void *node = pool->free_list;
+        pool->free_list = *(void **)node;
+        if (pool->free_list == NULL) {
+            pool->free_tail = NULL;
+        }
+        return node;
+    }
+
+    if (pool->chunks == NULL || pool->chunk_used == pool->chunks->capacity) {
+        if (chunk_new(pool) == NULL) {
+            return NULL;
+        }
+    }
+
+    return chunk_node(pool, pool->chunks, pool->chunk_used++);
+}
+
+/**
+ * Takes a number of nodes from the pool that are contiguous in memory.
+ * The nodes get a chunk of their own, which is released with the rest of the pool.
+ * Nodes from the block may be given back individually like any other node.
+ * @param pool A pointer to the node pool.
+ * @param count The number of nodes to take.
+ * @return A pointer to the first node of the block, or NULL if the allocation failed.
+ */
+void *node_pool_take_block(node_pool *pool, size_t count) {
+    pool_chunk *chunk = allocator_alloc(pool->allocator, CHUNK_HEADER_SIZE + count * pool->node_size);
+
+    if (chunk == NULL) {
+        return NULL;
+    }
+
+    chunk->capacity = count;
+
+    // Keep carving single nodes from the current chunk by adding the block behind it
+    if (pool->chunks == NULL) {
+        chunk->next = NULL;
+        pool->chunks = chunk;
+        pool->last_chunk = chunk;
+        pool->chunk_used = count;
+    } else {
+        chunk->next = pool->chunks->next;
+        pool->chunks->next = chunk;
+        if (pool->last_chunk == pool->chunks) {
+            pool->last_chunk = chunk;
+        }
+    }
+
+    return chunk_node(pool, chunk, 0);
+}
+
+/**
+ * Returns a node to the pool so it can be reused.
+ * @param pool A pointer to the node pool.
+ * @param node A pointer to a node previously taken from the same pool.
+ */
+void node_pool_give(node_pool *pool, void *node) {
+    *(void **)node = pool->free_list;
+    pool->free_list = node;
+    if (pool->free_tail == NULL) {
+        pool->free_tail = node;
+    }
+}
+
+/**
+ * Moves every chunk and recycled node of one pool into another in O(1).
+ * Nodes taken from the other pool stay valid and now belong to the pool.
+ * Both pools must have the same node size and allocator. The other pool is left empty.
+ * @param pool A pointer to the node pool receiving the memory.
+ * @param other A pointer to the node pool giving up its memory.
+ */
+void node_pool_absorb(node_pool *pool, node_pool *other) {
+    if (other->chunks != NULL) {
+        if (pool->chunks == NULL) {
+            // Keep carving from the other pool's newest chunk
+            pool->chunks = other->chunks;
+            pool->last_chunk = other->last_chunk;
+            pool->chunk_used = other->chunk_used;
+        } else {
+            // Nodes left uncarved in the other pool's newest chunk are given up
+            other->last_chunk->next = pool->chunks->next;
+            pool->chunks->next = other->chunks;
+            if (pool->last_chunk == pool->chunks) {
+                pool->last_chunk = other->last_chunk;
+            }
+        }
+    }
+
+    if (other->free_list != NULL) {
+        *(void **)other->free_tail = pool->free_list;
+        if (pool->free_list == NULL) {
+            pool->free_tail = other->free_tail;
+        }
+        pool->free_list = other->free_list;
+    }
+
+    size_t users = other->users;
+    node_pool_init(other, other->node_size, other->allocator);
+    other->users = users;
+}
@@ -0,0 +1,48 @@
+//
+// Created by Christopher Szatmary on 2018-12-16.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_NODE_POOL_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_NODE_POOL_H
+
+#include <stddef.h>
+#include "allocator.h"
+
+typedef struct pool_chunk pool_chunk;
+
+/**
+ * users counts the owners of the pool. A pool made with node_pool_init starts with one user,
+ * the caller, and is released with node_pool_release. A pool made with node_pool_new
+ * is deallocated when its last user drops it.
+ */
+typedef struct {
+    pool_chunk *chunks;
+    pool_chunk *last_chunk;
+    void *free_list;
+    void *free_tail;
+    size_t node_size;
+    size_t chunk_capacity;
+    size_t chunk_used;
+    size_t users;
+    const allocator *allocator;
+} node_pool;
+
+// Construction
+void node_pool_init(node_pool *pool, size_t node_size, const allocator *allocator);
+node_pool *node_pool_new(size_t node_size, const allocator *allocator);
+void node_pool_retain(node_pool *pool);
+
+// Deletion
+void node_pool_release(node_pool *pool);
+void node_pool_drop(node_pool *pool);
+
+// Accessing
+memory_usage node_pool_memory_usage(node_pool *pool, size_t taken, size_t payload_size);
+
+// Mutation
+void *node_pool_take(node_pool *pool);
+void *node_pool_take_block(node_pool *pool, size_t count);
+void node_pool_give(node_pool *pool, void *node);
+void node_pool_absorb(node_pool *pool, node_pool *other);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_NODE_POOL_H
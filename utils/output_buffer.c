@@ -0,0 +1,241 @@
+//
+// Created by Christopher Szatmary on 2018-12-22.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "output_buffer.h"
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Helpers */
+
+/**
+ * Writes text to the stream or file descriptor of an output buffer.
+ * @param buffer A pointer to the output buffer.
+ * @param text The text to write.
+ * @param length The number of bytes to write.
+ */
+static void sink_write(output_buffer *buffer, const char *text, size_t length) {
+    if (buffer->file != NULL) {
+        if (fwrite(text, 1, length, buffer->file) != length) {
+            buffer->status = EIO;
+        }
+        return;
+    }
+
+    while (length > 0) {
+        ssize_t written = write(buffer->fd, text, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            buffer->status = errno;
+            return;
+        }
+
+        text += written;
+        length -= (size_t)written;
+    }
+}
+
+/**
+ * Hands the text collected in an output buffer to its stream or file descriptor.
+ * @param buffer A pointer to the output buffer.
+ */
+static void drain(output_buffer *buffer) {
+    if (buffer->length > 0 && buffer->status == EXIT_SUCCESS) {
+        sink_write(buffer, buffer->data, buffer->length);
+    }
+    buffer->length = 0;
+}
+
+/**
+ * Checks whether an output buffer writes into memory supplied by the caller.
+ * @param buffer A pointer to the output buffer.
+ * @return true if there is no stream or file descriptor to flush to.
+ */
+static bool is_memory(output_buffer *buffer) {
+    return buffer->file == NULL && buffer->fd < 0;
+}
+
+/* Construction */
+
+/**
+ * Initializes an output buffer that writes to a stream.
+ * The stream gets the text in large chunks, so its lock is taken once per chunk.
+ * @param buffer A pointer to the output buffer.
+ * @param file The stream to write to.
+ */
+void output_buffer_init_file(output_buffer *buffer, FILE *file) {
+    buffer->data = buffer->storage;
+    buffer->length = 0;
+    buffer->capacity = OUTPUT_BUFFER_SIZE;
+    buffer->total = 0;
+    buffer->file = file;
+    buffer->fd = -1;
+    buffer->status = EXIT_SUCCESS;
+}
+
+/**
+ * Initializes an output buffer that writes to a file descriptor, bypassing stdio.
+ * @param buffer A pointer to the output buffer.
+ * @param fd The file descriptor to write to.
+ */
+void output_buffer_init_fd(output_buffer *buffer, int fd) {
+    output_buffer_init_file(buffer, NULL);
+    buffer->fd = fd;
+}
+
+/**
+ * Initializes an output buffer that writes into memory supplied by the caller.
+ * The text is always NUL terminated once flushed. Text that doesn't fit is dropped
+ * and the status is set to ENOBUFS, but still counted in total.
+ * @param buffer A pointer to the output buffer.
+ * @param memory The memory to write into.
+ * @param capacity The size of the memory in bytes, including room for the terminator.
+ */
+void output_buffer_init_memory(output_buffer *buffer, char *memory, size_t capacity) {
+    output_buffer_init_file(buffer, NULL);
+    buffer->data = memory;
+    buffer->capacity = capacity > 0 ? capacity - 1 : 0;
+}
+
+/* Writing */
+
+/**
+ * Appends text to an output buffer, flushing it first if the text doesn't fit.
+ * @param buffer A pointer to the output buffer.
+ * @param text The text to append.
+ * @param length The number of bytes to append.
+ */
+void output_buffer_write(output_buffer *buffer, const char *text, size_t length) {
+    buffer->total += length;
+
+    if (buffer->status != EXIT_SUCCESS) {
+        return;
+    }
+
+    if (length <= buffer->capacity - buffer->length) {
+        memcpy(buffer->data + buffer->length, text, length);
+        buffer->length += length;
+        return;
+    }
+
+    // Memory supplied by the caller can't be flushed, so keep what fits
+    if (is_memory(buffer)) {
+        size_t fits = buffer->capacity - buffer->length;
+        memcpy(buffer->data + buffer->length, text, fits);
+        buffer->length += fits;
+        buffer->status = ENOBUFS;
+        return;
+    }
+
+    drain(buffer);
+
+    // Text larger than the whole buffer goes out directly instead of being copied in pieces
+    if (length >= buffer->capacity) {
+        sink_write(buffer, text, length);
+    } else {
+        memcpy(buffer->data, text, length);
+        buffer->length = length;
+    }
+}
+
+/**
+ * Appends the decimal representation of an integer to an output buffer.
+ * @param buffer A pointer to the output buffer.
+ * @param value The integer to append.
+ */
+void output_buffer_write_int(output_buffer *buffer, int value) {
+    // Format in place when there is room, which is almost always
+    if (buffer->status == EXIT_SUCCESS && buffer->capacity - buffer->length >= FORMAT_INT_MAX_LENGTH) {
+        size_t length = format_int(buffer->data + buffer->length, value);
+        buffer->length += length;
+        buffer->total += length;
+        return;
+    }
+
+    char digits[FORMAT_INT_MAX_LENGTH];
+    output_buffer_write(buffer, digits, format_int(digits, value));
+}
+
+/**
+ * Writes everything collected in an output buffer to its stream or file descriptor,
+ * or NUL terminates the text in caller supplied memory.
+ * A stream is flushed as well so the text is visible once this returns.
+ * @param buffer A pointer to the output buffer.
+ * @return An integer indicating the status of every write so far.
+ */
+int output_buffer_flush(output_buffer *buffer) {
+    if (is_memory(buffer)) {
+        if (buffer->data != NULL) {
+            buffer->data[buffer->length] = '\0';
+        }
+        return buffer->status;
+    }
+
+    drain(buffer);
+
+    if (buffer->file != NULL && fflush(buffer->file) != 0 && buffer->status == EXIT_SUCCESS) {
+        buffer->status = EIO;
+    }
+
+    return buffer->status;
+}
+
+/* Formatting */
+
+/**
+ * Formats an integer in decimal, two digits at a time.
+ * The result is not NUL terminated.
+ * @param destination Memory with room for at least FORMAT_INT_MAX_LENGTH characters.
+ * @param value The integer to format.
+ * @return The number of characters written.
+ */
+size_t format_int(char *destination, int value) {
+    char digits[FORMAT_INT_MAX_LENGTH];
+    char *end = digits + FORMAT_INT_MAX_LENGTH;
+    char *start = end;
+
+    // Work on the magnitude as unsigned so INT_MIN doesn't overflow
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+    while (magnitude >= 100) {
+        unsigned int pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        start -= 2;
+        start[0] = digit_pairs[pair];
+        start[1] = digit_pairs[pair + 1];
+    }
+
+    if (magnitude >= 10) {
+        start -= 2;
+        start[0] = digit_pairs[magnitude * 2];
+        start[1] = digit_pairs[magnitude * 2 + 1];
+    } else {
+        *--start = (char)('0' + magnitude);
+    }
+
+    if (value < 0) {
+        *--start = '-';
+    }
+
+    size_t length = (size_t)(end - start);
+    memcpy(destination, start, length);
+
+    return length;
+}
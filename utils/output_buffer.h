@@ -0,0 +1,46 @@
+//
+// Created by Christopher Szatmary on 2018-12-22.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_OUTPUT_BUFFER_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_OUTPUT_BUFFER_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+// Enough room for any int, including the sign
+#define FORMAT_INT_MAX_LENGTH 11
+
+/**
+ * Collects text in memory and hands it to a stream or file descriptor in large chunks,
+ * or writes it straight into memory supplied by the caller.
+ * total counts every byte written, so a caller buffer that was too small can be resized to fit.
+ * status holds the first error and further writes are dropped once it is set.
+ */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+    size_t total;
+    FILE *file;
+    int fd;
+    int status;
+    char storage[OUTPUT_BUFFER_SIZE];
+} output_buffer;
+
+// Construction
+void output_buffer_init_file(output_buffer *buffer, FILE *file);
+void output_buffer_init_fd(output_buffer *buffer, int fd);
+void output_buffer_init_memory(output_buffer *buffer, char *memory, size_t capacity);
+
+// Writing
+void output_buffer_write(output_buffer *buffer, const char *text, size_t length);
+void output_buffer_write_int(output_buffer *buffer, int value);
+int output_buffer_flush(output_buffer *buffer);
+
+// Formatting
+size_t format_int(char *destination, int value);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_OUTPUT_BUFFER_H
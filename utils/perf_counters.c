@@ -0,0 +1,220 @@
+//
+// Created by Christopher Szatmary on 2019-01-01.
+//
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "perf_counters.h"
+
+static const char *counter_names[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "cache-misses", "branch-misses", "page-faults"
+};
+
+/* Helpers */
+
+#ifdef __linux__
+/**
+ * Opens one counter of the calling process and the threads it creates afterwards, disabled.
+ * @param type The perf event type.
+ * @param config The event within the type.
+ * @return The file descriptor of the counter, or -1 if it can't be counted here.
+ */
+static int open_event(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/* Construction */
+
+/**
+ * Opens every counter the machine and the kernel allow.
+ * Counters that can't be opened are left out and read as unavailable.
+ * @param counters A pointer to the counters to open.
+ * @return An integer indicating the status, the error of the last failed counter if none could be opened.
+ */
+int perf_counters_open(perf_counters *counters) {
+    memset(counters->values, 0, sizeof(counters->values));
+
+#ifdef __linux__
+    static const struct {
+        uint32_t type;
+        uint64_t config;
+    } events[PERF_COUNTER_COUNT] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+    };
+
+    int status = ENOENT;
+    bool opened = false;
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->fds[i] = open_event(events[i].type, events[i].config);
+        if (counters->fds[i] == -1) {
+            status = errno;
+        } else {
+            opened = true;
+        }
+    }
+
+    return opened ? EXIT_SUCCESS : status;
+#else
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->fds[i] = -1;
+    }
+
+    return ENOSYS;
+#endif
+}
+
+/* Deletion */
+
+/**
+ * Closes the counters that were opened.
+ * @param counters A pointer to the counters.
+ */
+void perf_counters_close(perf_counters *counters) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters->fds[i] != -1) {
+            close(counters->fds[i]);
+            counters->fds[i] = -1;
+        }
+    }
+}
+
+/* Accessing */
+
+/**
+ * Returns whether a counter is being counted.
+ * @param counters A pointer to the counters.
+ * @param counter The counter.
+ * @return true if the counter was opened.
+ */
+bool perf_counters_available(perf_counters *counters, perf_counter counter) {
+    return counters->fds[counter] != -1;
+}
+
+/**
+ * Returns whether any counter is being counted.
+ * @param counters A pointer to the counters.
+ * @return true if at least one counter was opened.
+ */
+bool perf_counters_any(perf_counters *counters) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters->fds[i] != -1) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Returns the name perf uses for a counter.
+ * @param counter The counter.
+ * @return The name of the counter.
+ */
+const char *perf_counters_name(perf_counter counter) {
+    return counter_names[counter];
+}
+
+/**
+ * Prints the counts of the last measurement, with instructions per cycle in place of instructions.
+ * Unavailable counters are printed as -.
+ * @param counters A pointer to the counters.
+ * @param file The file to print to.
+ * @param ops The number of operations measured to print counts per operation, or 0 to print totals.
+ */
+void perf_counters_fprint(perf_counters *counters, FILE *file, uint64_t ops) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (i == PERF_INSTRUCTIONS) {
+            if (perf_counters_available(counters, PERF_CYCLES) && perf_counters_available(counters, PERF_INSTRUCTIONS)
+                && counters->values[PERF_CYCLES] > 0) {
+                fprintf(file, " ipc %.2f", (double)counters->values[PERF_INSTRUCTIONS] / counters->values[PERF_CYCLES]);
+            } else {
+                fprintf(file, " ipc -");
+            }
+        } else if (!perf_counters_available(counters, (perf_counter)i)) {
+            fprintf(file, " %s -", counter_names[i]);
+        } else if (ops == 0) {
+            fprintf(file, " %s %llu", counter_names[i], (unsigned long long)counters->values[i]);
+        } else {
+            fprintf(file, " %s %.3f/op", counter_names[i], (double)counters->values[i] / ops);
+        }
+    }
+    fprintf(file, "\n");
+}
+
+/* Measuring */
+
+/**
+ * Resets the counters and starts counting.
+ * @param counters A pointer to the counters.
+ */
+void perf_counters_start(perf_counters *counters) {
+#ifdef __linux__
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters->fds[i] != -1) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#else
+    (void)counters;
+#endif
+}
+
+/**
+ * Stops counting and reads the counts since the last start into values.
+ * @param counters A pointer to the counters.
+ */
+void perf_counters_stop(perf_counters *counters) {
+#ifdef __linux__
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->values[i] = 0;
+        if (counters->fds[i] == -1) {
+            continue;
+        }
+
+        ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        // The count, the time the event was enabled and the time it was actually counting
+        uint64_t read_values[3];
+        if (read(counters->fds[i], read_values, sizeof(read_values)) != sizeof(read_values)) {
+            continue;
+        }
+
+        if (read_values[2] > 0 && read_values[2] < read_values[1]) {
+            counters->values[i] = (uint64_t)((double)read_values[0] * read_values[1] / read_values[2]);
+        } else {
+            counters->values[i] = read_values[0];
+        }
+    }
+#else
+    (void)counters;
+#endif
+}
@@ -0,0 +1,50 @@
+//
+// Created by Christopher Szatmary on 2019-01-01.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_PERF_COUNTERS_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_PAGE_FAULTS,
+    PERF_COUNTER_COUNT
+} perf_counter;
+
+/**
+ * Hardware and software event counters of the calling process, read through perf_event_open.
+ * Each event is opened on its own, so a machine or kernel that lacks some events
+ * (virtual machines often have no hardware counters) still counts the rest.
+ * Only user space is counted, which works at the default perf_event_paranoid level.
+ * values holds the counts between the last start and stop, scaled up if the kernel
+ * had to share the hardware between more events than it has counters.
+ */
+typedef struct {
+    int fds[PERF_COUNTER_COUNT];
+    uint64_t values[PERF_COUNTER_COUNT];
+} perf_counters;
+
+// Construction
+int perf_counters_open(perf_counters *counters);
+
+// Deletion
+void perf_counters_close(perf_counters *counters);
+
+// Accessing
+bool perf_counters_available(perf_counters *counters, perf_counter counter);
+bool perf_counters_any(perf_counters *counters);
+const char *perf_counters_name(perf_counter counter);
+void perf_counters_fprint(perf_counters *counters, FILE *file, uint64_t ops);
+
+// Measuring
+void perf_counters_start(perf_counters *counters);
+void perf_counters_stop(perf_counters *counters);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_PERF_COUNTERS_H
@@ -0,0 +1,236 @@
+//
+// Created by Christopher Szatmary on 2018-12-23.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+#include "error.h"
+
+#define SNAPSHOT_MAGIC "DSASNAP"
+#define BYTE_ORDER_MARK 0x0102
+
+/* Helpers */
+
+/**
+ * Adds values to a running Fletcher style checksum over 32 bit words.
+ * @param values The values to add.
+ * @param count The number of values.
+ * @param sum A pointer to the running sum of the words.
+ * @param sum_of_sums A pointer to the running sum of the running sums.
+ */
+static void checksum_update(const int *values, size_t count, uint64_t *sum, uint64_t *sum_of_sums) {
+    uint64_t a = *sum;
+    uint64_t b = *sum_of_sums;
+
+    for (size_t i = 0; i < count; i++) {
+        a += (uint32_t)values[i];
+        b += a;
+    }
+
+    *sum = a;
+    *sum_of_sums = b;
+}
+
+/**
+ * Combines the two running sums into the checksum stored in the header.
+ * @param sum The sum of the words.
+ * @param sum_of_sums The sum of the running sums.
+ * @return The checksum.
+ */
+static uint64_t checksum_finish(uint64_t sum, uint64_t sum_of_sums) {
+    return sum ^ (sum_of_sums << 32 | sum_of_sums >> 32);
+}
+
+/**
+ * Fills in a header for a payload of ints.
+ * @param header A pointer to the header.
+ * @param length The number of elements in the payload.
+ * @param checksum The checksum of the payload.
+ */
+static void header_init(snapshot_header *header, uint64_t length, uint64_t checksum) {
+    memset(header, 0, sizeof(snapshot_header));
+    memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header->version = SNAPSHOT_VERSION;
+    header->width = sizeof(int);
+    header->byte_order = BYTE_ORDER_MARK;
+    header->length = length;
+    header->checksum = checksum;
+}
+
+/* Writing */
+
+/**
+ * Creates a snapshot file and prepares to write elements to it.
+ * The header is written last, once the length and checksum are known.
+ * @param writer A pointer to the writer to initialize.
+ * @param path The path of the file, which is replaced if it exists.
+ * @return An integer indicating the status.
+ */
+int snapshot_writer_open(snapshot_writer *writer, const char *path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        return errno;
+    }
+
+    output_buffer_init_fd(&writer->out, fd);
+    writer->length = 0;
+    writer->sum = 0;
+    writer->sum_of_sums = 0;
+
+    // Reserve room for the header
+    snapshot_header header;
+    header_init(&header, 0, 0);
+    output_buffer_write(&writer->out, (const char *)&header, sizeof(snapshot_header));
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Appends elements to the payload of a snapshot file.
+ * @param writer A pointer to an open writer.
+ * @param values The elements to append.
+ * @param count The number of elements.
+ */
+void snapshot_writer_write(snapshot_writer *writer, const int *values, size_t count) {
+    checksum_update(values, count, &writer->sum, &writer->sum_of_sums);
+    writer->length += count;
+    output_buffer_write(&writer->out, (const char *)values, count * sizeof(int));
+}
+
+/**
+ * Writes the header of a snapshot file and closes it.
+ * @param writer A pointer to an open writer.
+ * @return An integer indicating the status of every write to the file.
+ */
+int snapshot_writer_close(snapshot_writer *writer) {
+    int status = output_buffer_flush(&writer->out);
+
+    if (status == EXIT_SUCCESS) {
+        snapshot_header header;
+        header_init(&header, writer->length, checksum_finish(writer->sum, writer->sum_of_sums));
+        if (pwrite(writer->out.fd, &header, sizeof(snapshot_header), 0) != sizeof(snapshot_header)) {
+            status = errno != 0 ? errno : EIO;
+        }
+    }
+
+    if (close(writer->out.fd) != 0 && status == EXIT_SUCCESS) {
+        status = errno;
+    }
+
+    return status;
+}
+
+/**
+ * Writes an array of ints to a snapshot file.
+ * @param path The path of the file, which is replaced if it exists.
+ * @param values The elements to save.
+ * @param length The number of elements.
+ * @return An integer indicating the status.
+ */
+int snapshot_save(const char *path, const int *values, size_t length) {
+    snapshot_writer *writer = malloc(sizeof(snapshot_writer));
+
+    if (writer == NULL) {
+        return ENOMEM;
+    }
+
+    int status = snapshot_writer_open(writer, path);
+    if (status == EXIT_SUCCESS) {
+        snapshot_writer_write(writer, values, length);
+        status = snapshot_writer_close(writer);
+    }
+
+    free(writer);
+
+    return status;
+}
+
+/* Loading */
+
+/**
+ * Maps a snapshot file into memory and checks its header.
+ * The mapping is private and writable, so the payload can be modified in place
+ * and pages are only copied once they are written to.
+ * @param mapping A pointer to the mapping to fill in.
+ * @param path The path of the file.
+ * @param verify Whether to check the payload against the checksum, which reads all of it.
+ * @return An integer indicating the status, INVALID_SNAPSHOT if the file isn't a valid snapshot of ints.
+ */
+int snapshot_map(snapshot_mapping *mapping, const char *path, bool verify) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return errno;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        int status = errno;
+        close(fd);
+        return status;
+    }
+
+    size_t size = (size_t)info.st_size;
+    if (size < sizeof(snapshot_header)) {
+        close(fd);
+        return INVALID_SNAPSHOT;
+    }
+
+    void *address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int status = address == MAP_FAILED ? errno : EXIT_SUCCESS;
+    close(fd);
+
+    if (status != EXIT_SUCCESS) {
+        return status;
+    }
+
+    // Ensure the header describes exactly the payload that follows it
+    const snapshot_header *header = address;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+        || header->version != SNAPSHOT_VERSION
+        || header->width != sizeof(int)
+        || header->byte_order != BYTE_ORDER_MARK
+        || header->length != (size - sizeof(snapshot_header)) / sizeof(int)
+        || (size - sizeof(snapshot_header)) % sizeof(int) != 0) {
+        munmap(address, size);
+        return INVALID_SNAPSHOT;
+    }
+
+    int *data = (int *)((char *)address + sizeof(snapshot_header));
+    if (verify) {
+        uint64_t sum = 0;
+        uint64_t sum_of_sums = 0;
+        checksum_update(data, header->length, &sum, &sum_of_sums);
+
+        if (checksum_finish(sum, sum_of_sums) != header->checksum) {
+            munmap(address, size);
+            return INVALID_SNAPSHOT;
+        }
+    }
+
+    mapping->address = address;
+    mapping->size = size;
+    mapping->data = data;
+    mapping->length = header->length;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Unmaps a snapshot file mapped with snapshot_map.
+ * @param mapping A pointer to the mapping.
+ */
+void snapshot_unmap(snapshot_mapping *mapping) {
+    munmap(mapping->address, mapping->size);
+    mapping->address = NULL;
+    mapping->size = 0;
+    mapping->data = NULL;
+    mapping->length = 0;
+}
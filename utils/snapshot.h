@@ -0,0 +1,52 @@
+//
+// Created by Christopher Szatmary on 2018-12-23.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_SNAPSHOT_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "output_buffer.h"
+
+#define SNAPSHOT_VERSION 1
+
+/**
+ * The header at the start of every snapshot file, followed by length elements of width bytes
+ * in native byte order. The checksum covers the payload only.
+ */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint16_t width;
+    uint16_t byte_order;
+    uint64_t length;
+    uint64_t checksum;
+} snapshot_header;
+
+typedef struct {
+    void *address;
+    size_t size;
+    int *data;
+    size_t length;
+} snapshot_mapping;
+
+typedef struct {
+    output_buffer out;
+    uint64_t length;
+    uint64_t sum;
+    uint64_t sum_of_sums;
+} snapshot_writer;
+
+// Writing
+int snapshot_writer_open(snapshot_writer *writer, const char *path);
+void snapshot_writer_write(snapshot_writer *writer, const int *values, size_t count);
+int snapshot_writer_close(snapshot_writer *writer);
+int snapshot_save(const char *path, const int *values, size_t length);
+
+// Loading
+int snapshot_map(snapshot_mapping *mapping, const char *path, bool verify);
+void snapshot_unmap(snapshot_mapping *mapping);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_SNAPSHOT_H
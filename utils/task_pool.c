@@ -0,0 +1,249 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#include <stdlib.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#include "task_pool.h"
+
+// Room for spawned tasks each worker starts with, its deque doubles past it
+#define WORKER_DEQUE_CAPACITY 64
+
+struct task_worker {
+    task_pool *pool;
+    work_deque *deque;
+    pthread_t thread;
+    bool started;
+    uint32_t seed;
+};
+
+static _Thread_local task_worker *current_worker;
+
+/* Helpers */
+
+/**
+ * Runs a task and marks it done, which releases its memory back to the thread waiting for it.
+ * @param pool A pointer to the task pool.
+ * @param task A pointer to the task.
+ */
+static void task_execute(task_pool *pool, task *task) {
+    task->function(pool, task->argument);
+    atomic_store_explicit(&task->done, true, memory_order_release);
+}
+
+/**
+ * Finds a task for a worker to run, its own newest task first,
+ * then the oldest task of the other workers starting from a random one.
+ * @param worker A pointer to the worker.
+ * @return A pointer to the task, or NULL if none was found.
+ */
+static task *task_find(task_worker *worker) {
+    void *found;
+
+    if (work_deque_take(worker->deque, &found)) {
+        return found;
+    }
+
+    task_pool *pool = worker->pool;
+    worker->seed ^= worker->seed << 13;
+    worker->seed ^= worker->seed >> 17;
+    worker->seed ^= worker->seed << 5;
+
+    size_t start = worker->seed % pool->worker_count;
+    for (size_t i = 0; i < pool->worker_count; i++) {
+        task_worker *victim = &pool->workers[(start + i) % pool->worker_count];
+        if (victim != worker && work_deque_steal(victim->deque, &found)) {
+            return found;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * The loop run by each worker thread. Workers sleep between jobs and steal while one runs.
+ * @param context A pointer to the worker.
+ */
+static void *worker_main(void *context) {
+    task_worker *worker = context;
+    task_pool *pool = worker->pool;
+    current_worker = worker;
+
+    while (true) {
+        pthread_mutex_lock(&pool->lock);
+        while (!atomic_load(&pool->busy) && !pool->shutdown) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        bool shutdown = pool->shutdown;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (shutdown) {
+            return NULL;
+        }
+
+        while (atomic_load_explicit(&pool->busy, memory_order_acquire)) {
+            task *next = task_find(worker);
+            if (next != NULL) {
+                task_execute(pool, next);
+            } else {
+                sched_yield();
+            }
+        }
+    }
+}
+
+/* Construction */
+
+/**
+ * Initializes a task pool and starts its worker threads.
+ * @param pool A pointer to the task pool to initialize.
+ * @param worker_count The number of workers including the thread calling task_pool_run,
+ * or 0 to use one per online processor.
+ * @return An integer indicating the status.
+ */
+int task_pool_init(task_pool *pool, size_t worker_count) {
+    if (worker_count == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = online > 0 ? (size_t)online : 1;
+    }
+
+    pool->workers = calloc(worker_count, sizeof(task_worker));
+    if (pool->workers == NULL) {
+        return ENOMEM;
+    }
+
+    pool->worker_count = worker_count;
+    pool->shutdown = false;
+    atomic_init(&pool->busy, false);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    // Every deque has to exist before any worker can steal from it
+    for (size_t i = 0; i < worker_count; i++) {
+        task_worker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->seed = (uint32_t)(2654435761u * (i + 1));
+        worker->deque = work_deque_alloc();
+
+        if (worker->deque == NULL || work_deque_reserve_capacity(worker->deque, WORKER_DEQUE_CAPACITY) == ENOMEM) {
+            pool->worker_count = i + 1;
+            task_pool_release(pool);
+            return ENOMEM;
+        }
+    }
+
+    // The first worker is the thread running each job
+    for (size_t i = 1; i < worker_count; i++) {
+        int status = pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]);
+
+        if (status != EXIT_SUCCESS) {
+            task_pool_release(pool);
+            return status;
+        }
+        pool->workers[i].started = true;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* Deletion */
+
+/**
+ * Stops the worker threads of a task pool and deallocates their deques.
+ * @param pool A pointer to the task pool.
+ */
+void task_pool_release(task_pool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    // Any worker may still be stealing from any deque until every thread has stopped
+    for (size_t i = 0; i < pool->worker_count; i++) {
+        if (pool->workers[i].started) {
+            pthread_join(pool->workers[i].thread, NULL);
+        }
+    }
+
+    for (size_t i = 0; i < pool->worker_count; i++) {
+        if (pool->workers[i].deque != NULL) {
+            work_deque_delete(&pool->workers[i].deque);
+        }
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    pool->workers = NULL;
+    pool->worker_count = 0;
+}
+
+/* Running */
+
+/**
+ * Runs a job on a task pool and returns once it is finished.
+ * The calling thread runs the job itself as the first worker, while the other workers
+ * steal the tasks it spawns. Every task spawned during the job must be waited for.
+ * Only one thread may run a job on a pool at a time.
+ * @param pool A pointer to the task pool.
+ * @param function The function starting the job.
+ * @param argument A pointer passed on to the function.
+ */
+void task_pool_run(task_pool *pool, task_function function, void *argument) {
+    task_worker *previous = current_worker;
+    current_worker = &pool->workers[0];
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->busy, true);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    function(pool, argument);
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->busy, false);
+    pthread_mutex_unlock(&pool->lock);
+
+    current_worker = previous;
+}
+
+/**
+ * Spawns a task that other workers can steal while the calling task goes on.
+ * Outside of a job on this pool, or if the deque can't grow, the task runs right away instead.
+ * @param pool A pointer to the task pool.
+ * @param task A pointer to the task, which must stay valid until it has been waited for.
+ * @param function The function to run.
+ * @param argument A pointer passed on to the function.
+ */
+void task_pool_spawn(task_pool *pool, task *task, task_function function, void *argument) {
+    task->function = function;
+    task->argument = argument;
+    atomic_store_explicit(&task->done, false, memory_order_relaxed);
+
+    task_worker *worker = current_worker;
+    if (worker == NULL || worker->pool != pool || work_deque_push(worker->deque, task) != EXIT_SUCCESS) {
+        task_execute(pool, task);
+    }
+}
+
+/**
+ * Waits for a spawned task to finish, running other tasks in the meantime.
+ * Usually the task is still at the bottom of the worker's own deque and runs right here.
+ * @param pool A pointer to the task pool.
+ * @param task A pointer to the task.
+ */
+void task_pool_wait(task_pool *pool, task *task) {
+    task_worker *worker = current_worker;
+
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        struct task *next = worker != NULL && worker->pool == pool ? task_find(worker) : NULL;
+
+        if (next != NULL) {
+            task_execute(pool, next);
+        } else {
+            sched_yield();
+        }
+    }
+}
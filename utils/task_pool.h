@@ -0,0 +1,53 @@
+//
+// Created by Christopher Szatmary on 2018-12-27.
+//
+
+#ifndef DATA_STRUCTURES_AND_ALGORITHMS_TASK_POOL_H
+#define DATA_STRUCTURES_AND_ALGORITHMS_TASK_POOL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "../data_structures/work_deque/work_deque.h"
+
+typedef struct task_pool task_pool;
+typedef struct task_worker task_worker;
+
+typedef void (*task_function)(task_pool *pool, void *argument);
+
+/**
+ * A unit of work spawned into a task pool. The caller owns the memory,
+ * usually on its own stack, and must wait for the task before it goes away.
+ */
+typedef struct task {
+    task_function function;
+    void *argument;
+    _Atomic bool done;
+} task;
+
+/**
+ * A fork-join thread pool. Every worker owns a work deque of spawned tasks,
+ * runs its own newest tasks first and steals the oldest tasks of other workers when it runs out.
+ * The thread calling task_pool_run is one of the workers while the job runs.
+ */
+struct task_pool {
+    task_worker *workers;
+    size_t worker_count;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    _Atomic bool busy;
+    bool shutdown;
+};
+
+// Construction
+int task_pool_init(task_pool *pool, size_t worker_count);
+
+// Deletion
+void task_pool_release(task_pool *pool);
+
+// Running
+void task_pool_run(task_pool *pool, task_function function, void *argument);
+void task_pool_spawn(task_pool *pool, task *task, task_function function, void *argument);
+void task_pool_wait(task_pool *pool, task *task);
+
+#endif //DATA_STRUCTURES_AND_ALGORITHMS_TASK_POOL_H